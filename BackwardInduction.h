@@ -0,0 +1,202 @@
+/*******************************
+Title: BackwardInduction.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: subgame-perfect equilibria of games of perfect information, by parallel backward induction
+********************************/
+
+#ifndef BACKWARDINDUCTION_H
+#define BACKWARDINDUCTION_H
+#include "GameResults.h"
+#include "GameTree.h"
+#include "WorkStealingPool.h"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Each decision node's mover picks the action whose subgame outcome pays them
+the most, ties going to the highest-numbered action as in simGame's best
+responses, and a node's outcome is the terminal node its chosen child
+reaches, so each node keeps an action and a node number rather than a
+payoff per player.
+Since every node is numbered after its parent, one pass from the last node
+to the root solves a tree on one thread. With more, the top of the tree is
+split level by level until there are SUBTREES_PER_THREAD subtrees per
+thread; a task for a top node pushes a task for each child onto a
+WorkStealingPool, a task for a subtree solves the whole of it alone,
+and whichever task finishes a top node's last child solves that node, so
+the top is solved bottom up as its subtrees finish, with no barrier
+between levels. Only games of perfect information are solved: a node that
+shares an information set with another can't be solved on its own.
+******************************************************************************/
+
+const int SUBTREES_PER_THREAD = 16;
+
+// solves the decision nodes of a tree whose subgames' outcomes are known
+template <typename T>
+struct BackwardInduction
+{
+	const GameTree<T> &tree;
+	SubgamePerfectResult<T> &result;
+
+	BackwardInduction(const GameTree<T> &t, SubgamePerfectResult<T> &r) : tree(t), result(r) {}
+
+	// the mover's best action at node n, once its children are solved
+	void solveNode(uint32_t n)
+	{
+		if (tree.isTerminal(n))
+		{
+			result.actions[n] = NO_ACTION;
+			result.outcomes[n] = n;
+			return;
+		}
+		int x = tree.getPlayer(n), best = 0;
+		uint32_t first = tree.getFirstChild(n);
+		T bestPayoff = tree.getPayoff(result.outcomes[first], x);
+		for (int a = 1; a < tree.getNumChildren(n); a++)
+		{
+			T payoff = tree.getPayoff(result.outcomes[first + a], x);
+			if (payoff >= bestPayoff)
+			{
+				bestPayoff = payoff;
+				best = a;
+			}
+		}
+		result.actions[n] = best;
+		result.outcomes[n] = result.outcomes[first + best];
+	}
+
+	// every node of the subtree under root, children before parents
+	void solveSubtree(uint32_t root, vector<uint32_t> &order)
+	{
+		// breadth-first order, reversed, puts every node after its descendants
+		order.clear();
+		order.push_back(root);
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			uint32_t n = order[i];
+			if (!tree.isTerminal(n))
+			{
+				for (int a = 0; a < tree.getNumChildren(n); a++)
+					order.push_back(tree.getFirstChild(n) + a);
+			}
+		}
+		for (size_t i = order.size(); i-- > 0; )
+			solveNode(order[i]);
+	}
+};
+
+/// @brief a subgame-perfect equilibrium of a game of perfect information by backward induction
+/// @param tree every node either has children or is terminal, and none share an information set
+/// @param numThreads 0 uses one thread per hardware thread
+/// @return the action at every decision node, the outcome of every subgame, and the equilibrium path and payoffs
+template <typename T>
+SubgamePerfectResult<T> subgamePerfect(const GameTree<T> &tree, int numThreads)
+{
+	SubgamePerfectResult<T> result;
+	uint32_t numNodes = tree.getNumNodes();
+	vector<bool> infoSetUsed;
+	for (uint32_t n = 0; n < numNodes; n++)
+	{
+		if (!tree.isTerminal(n) && tree.getNumChildren(n) == 0)
+		{
+			result.status = GameStatus("node " + to_string(n) + " has neither children nor payoffs");
+			return result;
+		}
+		int32_t id = tree.getInfoSet(n);
+		if (id != NO_INFO_SET)
+		{
+			if ((unsigned)id >= infoSetUsed.size())
+				infoSetUsed.resize(id + 1, false);
+			if (infoSetUsed[id])
+			{
+				result.status = GameStatus("information set " + to_string(id) + " has more than one node, so the game's information isn't perfect");
+				return result;
+			}
+			infoSetUsed[id] = true;
+		}
+	}
+
+	result.actions.assign(numNodes, NO_ACTION);
+	result.outcomes.assign(numNodes, 0);
+	BackwardInduction<T> solver = BackwardInduction<T>(tree, result);
+
+	if (numThreads < 1)
+		numThreads = thread::hardware_concurrency();
+
+	// the top of the tree: split until there are enough subtrees, numbering the top nodes that have children
+	vector<uint32_t> frontier = vector<uint32_t>(1, 0), next;
+	unordered_map<uint32_t, int> topNodes;
+	int splitDepth = 0;
+	while (numThreads > 1 && frontier.size() < (size_t)SUBTREES_PER_THREAD * numThreads)
+	{
+		next.clear();
+		for (size_t i = 0; i < frontier.size(); i++)
+		{
+			uint32_t n = frontier[i];
+			if (tree.isTerminal(n))
+				continue;
+			topNodes.insert(make_pair(n, (int)topNodes.size()));
+			for (int a = 0; a < tree.getNumChildren(n); a++)
+				next.push_back(tree.getFirstChild(n) + a);
+		}
+		if (next.empty())
+			break;
+		frontier.swap(next);
+		splitDepth++;
+	}
+
+	if (topNodes.empty())
+	{
+		for (uint32_t n = numNodes; n-- > 0; )
+			solver.solveNode(n);
+	}
+	else
+	{
+		vector<atomic<int> > remaining(topNodes.size()); // each top node's unsolved children
+		for (unordered_map<uint32_t, int>::const_iterator it = topNodes.begin(); it != topNodes.end(); it++)
+			remaining[it->second] = tree.getNumChildren(it->first);
+
+		WorkStealingPool pool(numThreads);
+		// solves n's ancestors whose last child n was; the decrement orders the children's results before the parent reads them
+		function<void(uint32_t)> finish = [&](uint32_t n)
+		{
+			while (n != 0)
+			{
+				uint32_t parent = tree.getParent(n);
+				if (--remaining[topNodes.find(parent)->second] > 0)
+					return;
+				solver.solveNode(parent);
+				n = parent;
+			}
+		};
+		function<void(uint32_t, int)> task = [&](uint32_t n, int depth)
+		{
+			if (depth == splitDepth || tree.isTerminal(n))
+			{
+				vector<uint32_t> order;
+				solver.solveSubtree(n, order);
+				finish(n);
+				return;
+			}
+			for (int a = 0; a < tree.getNumChildren(n); a++)
+			{
+				uint32_t child = tree.getFirstChild(n) + a;
+				pool.push([&task, child, depth]() { task(child, depth + 1); });
+			}
+		};
+		pool.push([&task]() { task(0, 0); });
+		pool.wait();
+	}
+
+	for (uint32_t n = 0; !tree.isTerminal(n); n = tree.getFirstChild(n) + result.actions[n])
+		result.path.push_back(result.actions[n]);
+	const T* p = tree.getPayoffs(result.outcomes[0]);
+	result.payoffs.assign(p, p + tree.getNumPlayers());
+	return result;
+}
+
+#endif
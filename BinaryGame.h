@@ -0,0 +1,452 @@
+/*******************************
+Title: BinaryGame.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: versioned binary game files that are used in place once mapped
+********************************/
+
+#ifndef BINARYGAME_H
+#define BINARYGAME_H
+#include "GameReader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+layout, in the writer's byte order (files from the other order are rejected):
+	BinaryGameHeader						64 bytes
+	numStrats, then rationalities 			uint32_t each, numPlayers of each
+	zeros up to the next multiple of 64
+	payoffs 								same order as PayoffTensor
+headerChecksum covers everything before the payoffs (with headerChecksum
+itself zeroed) and payoffChecksum covers the payoffs.
+******************************************************************************/
+const char BINARY_GAME_MAGIC[8] = { 'G', 'T', 'G', 'A', 'M', 'E', 'B', '\0' };
+const uint32_t BINARY_GAME_VERSION = 1;
+const uint32_t BINARY_GAME_BYTE_ORDER = 0x01020304;
+const size_t BINARY_GAME_ALIGNMENT = 64;
+
+struct BinaryGameHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t numPlayers;
+	uint32_t scalarType;
+	uint64_t payoffOffset; // from the start of the file; a multiple of 64
+	uint64_t numPayoffs;
+	uint64_t headerChecksum;
+	uint64_t payoffChecksum;
+	uint64_t reserved;
+};
+static_assert(sizeof(BinaryGameHeader) == 64, "BinaryGameHeader must stay 64 bytes");
+
+// code stored in scalarType for each payoff type; 0 for types that can't be saved
+template <typename T> struct BinaryScalar 	{ static const uint32_t code = 0; };
+template <> struct BinaryScalar<int32_t> 	{ static const uint32_t code = 1; };
+template <> struct BinaryScalar<int64_t> 	{ static const uint32_t code = 2; };
+template <> struct BinaryScalar<float> 		{ static const uint32_t code = 3; };
+template <> struct BinaryScalar<double> 	{ static const uint32_t code = 4; };
+
+/// @brief 64-bit checksum of size bytes, continuing from h; eight bytes per step
+/// @param data
+/// @param size
+/// @param h the previous result when checksumming in pieces
+inline uint64_t binaryChecksum(const void* data, size_t size, uint64_t h = 1469598103934665603ULL)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	size_t numWords = size / 8;
+	for (size_t w = 0; w < numWords; w++, p += 8)
+	{
+		uint64_t word;
+		memcpy(&word, p, 8);
+		h = (h ^ word) * 1099511628211ULL;
+		h ^= h >> 29;
+	}
+	for (size_t b = numWords * 8; b < size; b++, p++)
+		h = (h ^ *p) * 1099511628211ULL;
+	return h;
+}
+
+/******************************************************************************
+a binary game in memory, either a file it maps itself or bytes owned by
+someone else (e.g., a GameCorpus); payoffs() views the payoffs without
+copying them, so the BinaryGame (and the bytes) must outlive the tensor
+******************************************************************************/
+class BinaryGame
+{
+	private:
+		MappedFile file;
+		const char* bytes;
+		size_t numBytes;
+		const BinaryGameHeader* header;
+		vector<int> numStrats;
+		vector<int> rationalities;
+		string name;
+
+		GameStatus fail(const string &);
+	public:
+		BinaryGame() { bytes = NULL; numBytes = 0; header = NULL; }
+
+		int getNumPlayers() const 					{ return numStrats.size(); }
+		const vector<int>& getNumStrats() const 	{ return numStrats; }
+		uint64_t getNumPayoffs() const 				{ return header ? header->numPayoffs : 0; }
+		uint64_t getPayoffOffset() const 			{ return header ? header->payoffOffset : 0; }
+		const vector<int>& getRationalities() const { return rationalities; }
+		uint32_t getScalarType() const 				{ return header ? header->scalarType : 0; }
+
+		GameStatus attach(const char*, size_t, const string &, bool = false);
+		void close();
+		GameStatus open(const string &, bool = false);
+		template <typename T> GameStatus payoffs(PayoffTensor<T> &) const;
+		GameStatus verify() const;
+};
+
+/// @brief uses size bytes at data as a binary game after checking its header
+/// @param data the game, aligned to 8 bytes; it must stay valid until the game is closed
+/// @param size
+/// @param filename the game's name, for error messages
+/// @param verifyPayoffs also checks the payoffs' checksum, which reads every payoff
+/// @return the first problem found
+GameStatus BinaryGame::attach(const char* data, size_t size, const string &filename, bool verifyPayoffs)
+{
+	if (data != file.begin())
+		close();
+	bytes = data;
+	numBytes = size;
+
+	if (numBytes < sizeof(BinaryGameHeader) || memcmp(bytes, BINARY_GAME_MAGIC, sizeof(BINARY_GAME_MAGIC)) != 0)
+		return fail(filename + " is not a binary game file");
+	header = reinterpret_cast<const BinaryGameHeader*>(bytes);
+	if (header->byteOrder != BINARY_GAME_BYTE_ORDER)
+		return fail(filename + " was written on a machine with a different byte order");
+	if (header->version != BINARY_GAME_VERSION)
+		return fail(filename + " has version " + to_string(header->version) + ", but only version " + to_string(BINARY_GAME_VERSION) + " can be read");
+
+	uint64_t nP = header->numPlayers;
+	if (nP < 2 || header->payoffOffset % BINARY_GAME_ALIGNMENT != 0 || header->payoffOffset < sizeof(BinaryGameHeader) + 2 * nP * sizeof(uint32_t)
+		|| header->payoffOffset > numBytes)
+		return fail(filename + " has a damaged header");
+
+	// the header's checksum is taken with the checksum itself zeroed
+	BinaryGameHeader copy = *header;
+	copy.headerChecksum = 0;
+	uint64_t checksum = binaryChecksum(&copy, sizeof(copy));
+	checksum = binaryChecksum(bytes + sizeof(copy), header->payoffOffset - sizeof(copy), checksum);
+	if (checksum != header->headerChecksum)
+		return fail(filename + "'s header does not match its checksum");
+
+	const char* dimensions = bytes + sizeof(BinaryGameHeader);
+	numStrats = vector<int>(nP);
+	rationalities = vector<int>(nP);
+	uint64_t numPayoffs = nP;
+	for (int x = 0; (uint64_t)x < nP; x++)
+	{
+		uint32_t n, r;
+		memcpy(&n, dimensions + x * sizeof(uint32_t), sizeof(n));
+		memcpy(&r, dimensions + (nP + x) * sizeof(uint32_t), sizeof(r));
+		if (n < 1 || n > INT_MAX || r > MAX_RATIONALITY || numPayoffs > UINT64_MAX / n)
+			return fail(filename + " has invalid dimensions");
+		numStrats.at(x) = n;
+		rationalities.at(x) = r;
+		numPayoffs *= n;
+	}
+	if (numPayoffs != header->numPayoffs)
+		return fail(filename + " has " + to_string(header->numPayoffs) + " payoffs, but its dimensions need " + to_string(numPayoffs));
+
+	size_t scalarSize = 0;
+	switch (header->scalarType)
+	{
+		case 1: scalarSize = sizeof(int32_t); break;
+		case 2: scalarSize = sizeof(int64_t); break;
+		case 3: scalarSize = sizeof(float); break;
+		case 4: scalarSize = sizeof(double); break;
+		default: return fail(filename + " has an unknown payoff type");
+	}
+	if (numPayoffs > (UINT64_MAX - header->payoffOffset) / scalarSize || numBytes != header->payoffOffset + numPayoffs * scalarSize)
+		return fail(filename + " is " + to_string(numBytes) + " bytes, but its header says " + to_string(header->payoffOffset + numPayoffs * scalarSize));
+
+	name = filename;
+	if (verifyPayoffs)
+	{
+		GameStatus status = verify();
+		if (!status.ok)
+			return fail(status.error);
+	}
+	return GameStatus();
+}
+
+// unmaps the file, if the game has its own
+void BinaryGame::close()
+{
+	file.close();
+	bytes = NULL;
+	numBytes = 0;
+	header = NULL;
+	numStrats.clear();
+	rationalities.clear();
+	name.clear();
+}
+
+// closes the file and returns the error
+GameStatus BinaryGame::fail(const string &error)
+{
+	close();
+	return GameStatus(error);
+}
+
+/// @brief maps filename and checks its header; the payoffs are only read if verifyPayoffs is true
+/// @param filename
+/// @param verifyPayoffs also checks the payoffs' checksum, which reads every payoff
+/// @return the first problem found
+GameStatus BinaryGame::open(const string &filename, bool verifyPayoffs)
+{
+	close();
+	if (!file.open(filename))
+		return GameStatus("could not open " + filename);
+	return attach(file.begin(), file.size(), filename, verifyPayoffs);
+}
+
+/// @brief views the mapped payoffs without copying them
+/// @param tensor becomes a view that is valid until the file is closed
+/// @return an error if no file is open or T isn't the file's payoff type
+template <typename T>
+GameStatus BinaryGame::payoffs(PayoffTensor<T> &tensor) const
+{
+	if (!header)
+		return GameStatus("no binary game is open");
+	if (BinaryScalar<T>::code == 0 || BinaryScalar<T>::code != header->scalarType)
+		return GameStatus("the binary game's payoffs are not of the requested type");
+
+	tensor.attach(reinterpret_cast<const T*>(bytes + header->payoffOffset), numStrats);
+	return GameStatus();
+}
+
+// checks the payoffs against their checksum
+GameStatus BinaryGame::verify() const
+{
+	if (!header)
+		return GameStatus("no binary game is open");
+	if (binaryChecksum(bytes + header->payoffOffset, numBytes - header->payoffOffset) != header->payoffChecksum)
+		return GameStatus(name + "'s payoffs do not match their checksum");
+	return GameStatus();
+}
+
+// true if the file starts with the binary game magic
+inline bool isBinaryGame(const string &filename)
+{
+	char magic[sizeof(BINARY_GAME_MAGIC)];
+	ifstream infile(filename.c_str(), ios::in | ios::binary);
+	return infile.read(magic, sizeof(magic)) && memcmp(magic, BINARY_GAME_MAGIC, sizeof(magic)) == 0;
+}
+
+/// @brief everything a binary game file holds before its payoffs
+/// @param numStrats one entry per player
+/// @param rationalities one per player, from 0 to MAX_RATIONALITY
+/// @param payoffChecksum binaryChecksum() of the payoffs
+/// @return the header, dimensions, and padding, with the header's checksum filled in
+template <typename T>
+vector<char> binaryGameHead(const vector<int> &numStrats, const vector<int> &rationalities, uint64_t payoffChecksum)
+{
+	uint32_t nP = numStrats.size();
+	size_t dimensionsSize = 2 * nP * sizeof(uint32_t);
+	size_t payoffOffset = (sizeof(BinaryGameHeader) + dimensionsSize + BINARY_GAME_ALIGNMENT - 1) / BINARY_GAME_ALIGNMENT * BINARY_GAME_ALIGNMENT;
+
+	vector<char> head = vector<char>(payoffOffset, 0);
+	BinaryGameHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, BINARY_GAME_MAGIC, sizeof(header.magic));
+	header.version = BINARY_GAME_VERSION;
+	header.byteOrder = BINARY_GAME_BYTE_ORDER;
+	header.numPlayers = nP;
+	header.scalarType = BinaryScalar<T>::code;
+	header.payoffOffset = payoffOffset;
+	header.numPayoffs = nP;
+	header.payoffChecksum = payoffChecksum;
+
+	for (int x = 0; (unsigned)x < nP; x++)
+	{
+		uint32_t n = numStrats.at(x), r = rationalities.at(x);
+		header.numPayoffs *= n;
+		memcpy(&head[sizeof(header) + x * sizeof(uint32_t)], &n, sizeof(n));
+		memcpy(&head[sizeof(header) + (nP + x) * sizeof(uint32_t)], &r, sizeof(r));
+	}
+	memcpy(&head[0], &header, sizeof(header));
+	header.headerChecksum = binaryChecksum(&head[0], head.size());
+	memcpy(&head[0], &header, sizeof(header));
+	return head;
+}
+
+/// @brief writes payoffs and rationalities in the binary format to out
+/// @param out a binary stream; the game starts at its current position
+/// @param payoffs
+/// @param rationalities one per player, from 0 to MAX_RATIONALITY
+/// @return an error if T can't be saved; the caller checks the stream
+template <typename T>
+GameStatus writeBinaryGame(ostream &out, const PayoffTensor<T> &payoffs, const vector<int> &rationalities)
+{
+	if (BinaryScalar<T>::code == 0)
+		return GameStatus("payoffs of this type can't be saved in binary");
+	if (payoffs.getNumPlayers() < 2 || rationalities.size() != (unsigned)payoffs.getNumPlayers())
+		return GameStatus("the payoffs and rationalities are for different numbers of players");
+
+	vector<char> head = binaryGameHead<T>(payoffs.getNumStrats(), rationalities, binaryChecksum(payoffs.data(), payoffs.size() * sizeof(T)));
+	out.write(&head[0], head.size());
+	out.write(reinterpret_cast<const char*>(payoffs.data()), payoffs.size() * sizeof(T));
+	return GameStatus();
+}
+
+/// @brief saves payoffs and rationalities in the binary format
+/// @param filename
+/// @param payoffs
+/// @param rationalities one per player, from 0 to MAX_RATIONALITY
+/// @return an error if T can't be saved or the file can't be written
+template <typename T>
+GameStatus writeBinaryGame(const string &filename, const PayoffTensor<T> &payoffs, const vector<int> &rationalities)
+{
+	ofstream outfile(filename.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+	GameStatus status = writeBinaryGame(outfile, payoffs, rationalities);
+	if (status.ok && !outfile)
+		return GameStatus("could not write " + filename);
+	return status;
+}
+
+/******************************************************************************
+writes a binary game a piece at a time, for games too large to hold in
+memory; the payoffs are given in PayoffTensor order, and close() fills in
+the header once the checksum is known
+******************************************************************************/
+template <typename T>
+class BinaryGameWriter
+{
+	private:
+		ofstream outfile;
+		string name;
+		vector<int> numStrats;
+		vector<int> rationalities;
+		uint64_t numPayoffs;
+		uint64_t numWritten;
+		uint64_t checksum;
+		char pending[8]; // bytes not yet checksummed, so every checksum step is a whole word
+		size_t numPending;
+
+		BinaryGameWriter(const BinaryGameWriter &) = delete;
+		BinaryGameWriter& operator=(const BinaryGameWriter &) = delete;
+	public:
+		BinaryGameWriter() { numPayoffs = 0; numWritten = 0; checksum = 0; numPending = 0; }
+
+		uint64_t getNumPayoffs() const 	{ return numPayoffs; }
+		uint64_t getNumWritten() const 	{ return numWritten; }
+
+		GameStatus close();
+		GameStatus open(const string &, const vector<int> &, const vector<int> &);
+		GameStatus write(const T*, size_t);
+};
+
+/// @brief writes the header once every payoff has been written
+/// @return an error if payoffs are missing or the file couldn't be written
+template <typename T>
+GameStatus BinaryGameWriter<T>::close()
+{
+	if (!outfile.is_open())
+		return GameStatus("no binary game is open");
+	if (numWritten != numPayoffs)
+	{
+		outfile.close();
+		return GameStatus(name + " got " + to_string(numWritten) + " payoffs, but " + to_string(numPayoffs) + " are needed");
+	}
+
+	checksum = binaryChecksum(pending, numPending, checksum);
+	vector<char> head = binaryGameHead<T>(numStrats, rationalities, checksum);
+	outfile.seekp(0);
+	outfile.write(&head[0], head.size());
+	bool ok = !outfile.fail();
+	outfile.close();
+	if (!ok)
+		return GameStatus("could not write " + name);
+	return GameStatus();
+}
+
+/// @brief creates filename for a game with the given dimensions
+/// @param filename
+/// @param nS one entry per player
+/// @param r one rationality per player, from 0 to MAX_RATIONALITY
+/// @return an error if the dimensions are invalid or the file can't be created
+template <typename T>
+GameStatus BinaryGameWriter<T>::open(const string &filename, const vector<int> &nS, const vector<int> &r)
+{
+	if (BinaryScalar<T>::code == 0)
+		return GameStatus("payoffs of this type can't be saved in binary");
+	if (nS.size() < 2 || r.size() != nS.size())
+		return GameStatus("a game needs at least 2 players and one rationality per player");
+
+	numPayoffs = nS.size();
+	for (int x = 0; (unsigned)x < nS.size(); x++)
+	{
+		if (nS.at(x) < 1 || r.at(x) < 0 || r.at(x) > MAX_RATIONALITY || numPayoffs > UINT64_MAX / sizeof(T) / nS.at(x))
+			return GameStatus("P_" + to_string(x + 1) + "'s number of strategies or rationality is invalid");
+		numPayoffs *= nS.at(x);
+	}
+
+	name = filename;
+	numStrats = nS;
+	rationalities = r;
+	numWritten = 0;
+	checksum = binaryChecksum(NULL, 0);
+	numPending = 0;
+
+	outfile.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+
+	// zeros hold the header's place, so an unfinished file has no magic
+	vector<char> zeros = vector<char>(binaryGameHead<T>(numStrats, rationalities, 0).size(), 0);
+	outfile.write(&zeros[0], zeros.size());
+	return GameStatus();
+}
+
+/// @brief appends count payoffs
+/// @param payoffs
+/// @param count
+/// @return an error if that's more payoffs than the game has or the file couldn't be written
+template <typename T>
+GameStatus BinaryGameWriter<T>::write(const T* payoffs, size_t count)
+{
+	if (!outfile.is_open())
+		return GameStatus("no binary game is open");
+	if (count > numPayoffs - numWritten)
+		return GameStatus(name + " only has room for " + to_string(numPayoffs - numWritten) + " more payoffs");
+
+	const char* p = reinterpret_cast<const char*>(payoffs);
+	size_t size = count * sizeof(T);
+	outfile.write(p, size);
+
+	// checksum whole words, carrying any leftover bytes to the next call
+	while (numPending > 0 && numPending < sizeof(pending) && size > 0)
+	{
+		pending[numPending++] = *p++;
+		size--;
+	}
+	if (numPending == sizeof(pending))
+	{
+		checksum = binaryChecksum(pending, sizeof(pending), checksum);
+		numPending = 0;
+	}
+	size_t whole = size / 8 * 8;
+	checksum = binaryChecksum(p, whole, checksum);
+	memcpy(pending + numPending, p + whole, size - whole);
+	numPending += size - whole;
+
+	numWritten += count;
+	if (!outfile)
+		return GameStatus("could not write " + name);
+	return GameStatus();
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*******************************
+Title: BitMatrix.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: square boolean matrices packed 64 entries to a word, for knowledge relations
+********************************/
+
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Each row is a run of 64-bit words, entry (i, j) being bit j % 64 of word
+j / 64 of row i, and the bits past the last column are always 0, so rows
+can be compared and combined a word at a time. The transitive closure is
+Warshall's algorithm with row i |= row k for each i that reaches k, which
+takes n^3 / 64 word operations instead of n^3 lookups.
+******************************************************************************/
+
+class BitMatrix
+{
+	private:
+		int size;
+		int wordsPerRow;
+		vector<uint64_t> words;
+
+		uint64_t lastWordMask() const;
+
+	public:
+		BitMatrix(int n = 0, bool value = false);
+
+		bool all() const;
+		void andWith(const BitMatrix &);
+		void fill(bool);
+		bool get(int i, int j) const 		{ return (words[(size_t)i * wordsPerRow + j / 64] >> (j % 64)) & 1; }
+		int getSize() const 				{ return size; }
+		void orRow(int, const vector<uint64_t> &);
+		bool rowWithin(int, const vector<uint64_t> &) const;
+		void set(int, int, bool);
+		void setDiagonal(bool);
+		void transitiveClosure();
+
+		bool operator == (const BitMatrix &m) const 	{ return size == m.size && words == m.words; }
+		bool operator != (const BitMatrix &m) const 	{ return !(*this == m); }
+};
+
+// an n x n matrix with every entry value
+inline BitMatrix::BitMatrix(int n, bool value)
+{
+	size = n;
+	wordsPerRow = (n + 63) / 64;
+	fill(value);
+}
+
+// true if every entry is set
+inline bool BitMatrix::all() const
+{
+	uint64_t last = lastWordMask();
+	for (int i = 0; i < size; i++)
+	{
+		const uint64_t* row = &words[(size_t)i * wordsPerRow];
+		for (int w = 0; w < wordsPerRow; w++)
+		{
+			if (row[w] != (w == wordsPerRow - 1 ? last : ~(uint64_t)0))
+				return false;
+		}
+	}
+	return true;
+}
+
+// entrywise and; m must be the same size
+inline void BitMatrix::andWith(const BitMatrix &m)
+{
+	for (size_t w = 0; w < words.size(); w++)
+		words[w] &= m.words[w];
+}
+
+// sets every entry to value
+inline void BitMatrix::fill(bool value)
+{
+	words.assign((size_t)size * wordsPerRow, value ? ~(uint64_t)0 : 0);
+	if (value && wordsPerRow > 0)
+	{
+		for (int i = 0; i < size; i++)
+			words[(size_t)i * wordsPerRow + wordsPerRow - 1] = lastWordMask();
+	}
+}
+
+// the bits of a row's last word that are columns
+inline uint64_t BitMatrix::lastWordMask() const
+{
+	return size % 64 == 0 ? ~(uint64_t)0 : ((uint64_t)1 << (size % 64)) - 1;
+}
+
+// sets the entries of row i that are set in bits, a row's worth of words packed like a row
+inline void BitMatrix::orRow(int i, const vector<uint64_t> &bits)
+{
+	uint64_t* row = &words[(size_t)i * wordsPerRow];
+	for (int w = 0; w < wordsPerRow; w++)
+		row[w] |= bits[w];
+}
+
+// true if every entry set in row i is set in bits, a row's worth of words packed like a row
+inline bool BitMatrix::rowWithin(int i, const vector<uint64_t> &bits) const
+{
+	const uint64_t* row = &words[(size_t)i * wordsPerRow];
+	for (int w = 0; w < wordsPerRow; w++)
+	{
+		if (row[w] & ~bits[w])
+			return false;
+	}
+	return true;
+}
+
+// sets entry (i, j) to value
+inline void BitMatrix::set(int i, int j, bool value)
+{
+	uint64_t &word = words[(size_t)i * wordsPerRow + j / 64];
+	uint64_t bit = (uint64_t)1 << (j % 64);
+	if (value)
+		word |= bit;
+	else
+		word &= ~bit;
+}
+
+// sets each entry (i, i) to value
+inline void BitMatrix::setDiagonal(bool value)
+{
+	for (int i = 0; i < size; i++)
+		set(i, i, value);
+}
+
+// adds (i, j) whenever a chain of set entries leads from i to j (Warshall's algorithm)
+inline void BitMatrix::transitiveClosure()
+{
+	for (int k = 0; k < size; k++)
+	{
+		const uint64_t* through = &words[(size_t)k * wordsPerRow];
+		for (int i = 0; i < size; i++)
+		{
+			if (i == k || !get(i, k))
+				continue;
+			uint64_t* row = &words[(size_t)i * wordsPerRow];
+			for (int w = 0; w < wordsPerRow; w++)
+				row[w] |= through[w];
+		}
+	}
+}
+
+#endif
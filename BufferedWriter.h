@@ -0,0 +1,188 @@
+/*******************************
+Title: BufferedWriter.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: formats output into a large buffer and writes it to a stream in big blocks
+********************************/
+
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/// @brief writes v's digits so that they end just before end
+/// @return the number of characters written, at most 20
+inline int formatUnsigned(char* end, unsigned long long v)
+{
+	static const char pairs[] =
+		"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+		"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+	char* p = end;
+	while (v >= 100)
+	{
+		const char* pair = pairs + (v % 100) * 2;
+		v /= 100;
+		*--p = pair[1];
+		*--p = pair[0];
+	}
+	if (v >= 10)
+	{
+		*--p = pairs[v * 2 + 1];
+		*--p = pairs[v * 2];
+	}
+	else
+		*--p = '0' + v;
+	return end - p;
+}
+
+// number of characters in v as operator<< writes it, without formatting it
+inline int integerLength(long long v)
+{
+	unsigned long long u = v < 0 ? 0 - (unsigned long long)v : v;
+	int length = v < 0 ? 2 : 1;
+	while (u >= 10)
+	{
+		u /= 10;
+		length++;
+	}
+	return length;
+}
+
+// number of characters in to_string(v), counted without a string for integers
+template <typename T>
+int formattedLength(T v)
+{
+	if (numeric_limits<T>::is_integer)
+		return integerLength(v);
+	return to_string(v).length();
+}
+
+/******************************************************************************
+A stand-in for an ostream in loops that write many small values: << appends
+to a buffer (a megabyte by default), integers are formatted with a table of
+digit pairs, and the buffer goes to the stream in one write when it fills
+or flush() is called. Floating-point values follow the stream's precision
+and fixed or scientific flags, as the stream itself would write them.
+******************************************************************************/
+class BufferedWriter
+{
+	private:
+		ostream* out;
+		vector<char> buffer;
+		size_t used;
+
+		BufferedWriter(const BufferedWriter &) = delete;
+		BufferedWriter& operator=(const BufferedWriter &) = delete;
+
+		char* reserve(size_t);
+		void writeFloating(double);
+		void writeSigned(long long);
+		void writeUnsigned(unsigned long long);
+	public:
+		BufferedWriter(ostream &o, size_t capacity = 1 << 20) : out(&o), buffer(capacity < 64 ? 64 : capacity) { used = 0; }
+		~BufferedWriter() { flush(); }
+
+		BufferedWriter& operator<<(char c) 					{ *reserve(1) = c; used++; return *this; }
+		BufferedWriter& operator<<(const char* s) 			{ write(s, strlen(s)); return *this; }
+		BufferedWriter& operator<<(const string &s) 		{ write(s.data(), s.size()); return *this; }
+		BufferedWriter& operator<<(int v) 					{ writeSigned(v); return *this; }
+		BufferedWriter& operator<<(long v) 					{ writeSigned(v); return *this; }
+		BufferedWriter& operator<<(long long v) 			{ writeSigned(v); return *this; }
+		BufferedWriter& operator<<(unsigned v) 				{ writeUnsigned(v); return *this; }
+		BufferedWriter& operator<<(unsigned long v) 		{ writeUnsigned(v); return *this; }
+		BufferedWriter& operator<<(unsigned long long v) 	{ writeUnsigned(v); return *this; }
+		BufferedWriter& operator<<(float v) 				{ writeFloating(v); return *this; }
+		BufferedWriter& operator<<(double v) 				{ writeFloating(v); return *this; }
+
+		void fill(char, int);
+		bool flush();
+		void write(const char*, size_t);
+};
+
+/// @brief writes c n times, e.g., to pad a column
+/// @param c
+/// @param n nothing is written if it's 0 or less
+void BufferedWriter::fill(char c, int n)
+{
+	for (; n > 0; n -= 64)
+	{
+		int count = n < 64 ? n : 64;
+		memset(reserve(count), c, count);
+		used += count;
+	}
+}
+
+/// @brief writes the buffer to the stream
+/// @return false if the stream has failed
+bool BufferedWriter::flush()
+{
+	if (used > 0)
+		out->write(&buffer[0], used);
+	used = 0;
+	return !out->fail();
+}
+
+// room for n more characters, flushing first if they don't fit; n is at most 64
+char* BufferedWriter::reserve(size_t n)
+{
+	if (used + n > buffer.size())
+		flush();
+	return &buffer[used];
+}
+
+// n characters; long strings skip the buffer
+void BufferedWriter::write(const char* s, size_t n)
+{
+	if (used + n > buffer.size())
+	{
+		flush();
+		if (n > buffer.size())
+		{
+			out->write(s, n);
+			return;
+		}
+	}
+	memcpy(&buffer[used], s, n);
+	used += n;
+}
+
+// v with the stream's precision and floatfield
+void BufferedWriter::writeFloating(double v)
+{
+	ios_base::fmtflags field = out->flags() & ios_base::floatfield;
+	const char* format = field == ios_base::fixed ? "%.*f" : (field == ios_base::scientific ? "%.*e" : "%.*g");
+	int precision = out->precision();
+	char s[512];
+	int n = snprintf(s, sizeof(s), format, precision, v);
+	write(s, n < 0 ? 0 : (n < (int)sizeof(s) ? n : sizeof(s) - 1));
+}
+
+// v in decimal
+void BufferedWriter::writeSigned(long long v)
+{
+	char* p = reserve(20);
+	if (v < 0)
+	{
+		*p++ = '-';
+		used++;
+	}
+	writeUnsigned(v < 0 ? 0 - (unsigned long long)v : v);
+}
+
+// v in decimal
+void BufferedWriter::writeUnsigned(unsigned long long v)
+{
+	char digits[20];
+	int n = formatUnsigned(digits + sizeof(digits), v);
+	memcpy(reserve(n), digits + sizeof(digits) - n, n);
+	used += n;
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*******************************
+Title: CognitiveHierarchy.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: the cognitive hierarchy model, with Poisson or given level distributions
+********************************/
+
+#ifndef COGNITIVEHIERARCHY_H
+#define COGNITIVEHIERARCHY_H
+#include "ExpectedUtility.h"
+#include "GameResults.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Camerer, Ho, and Chong's cognitive hierarchy ("A Cognitive Hierarchy Model
+of Games", 2004): L_0 picks a strategy uniformly at random, and L_k best
+responds to the others being levels 0 to k - 1 in proportion to
+P(L_0), ..., P(L_k-1), each player's level drawn independently. A level
+with tied best responses plays them with equal probability. Unlike the
+k-matrix, the model gives a prediction for every game, mixed or not.
+******************************************************************************/
+
+/// @brief Poisson(tau) probabilities of levels 0 to maxLevel, scaled to sum to 1
+/// @param tau the mean level, 1.5 in Camerer et al.'s estimates
+/// @param maxLevel
+inline vector<double> poissonLevels(double tau, int maxLevel)
+{
+	vector<double> probabilities = vector<double>(maxLevel + 1);
+	double term = exp(-tau), sum = 0.0;
+	for (int k = 0; k <= maxLevel; k++)
+	{
+		if (k > 0)
+			term *= tau / k;
+		probabilities.at(k) = term;
+		sum += term;
+	}
+	for (int k = 0; k <= maxLevel; k++)
+		probabilities.at(k) /= sum;
+	return probabilities;
+}
+
+/// @brief the lowest level past which Poisson(tau) has less than tail of its probability
+/// @param tau
+/// @param tail
+inline int poissonMaxLevel(double tau, double tail = 1e-6)
+{
+	double term = exp(-tau), sum = term;
+	int k = 0;
+	while (1.0 - sum >= tail && k < 1000)
+	{
+		k++;
+		term *= tau / k;
+		sum += term;
+	}
+	return k;
+}
+
+/// @brief the cognitive hierarchy model of a game
+/// @param payoffs
+/// @param levelProbabilities P(L_0), ..., P(L_K), which are scaled to sum to 1
+/// @return each level's strategies, the population's, and the expected utilities
+template <typename T>
+CognitiveHierarchyResult cognitiveHierarchy(const PayoffTensor<T> &payoffs, vector<double> levelProbabilities)
+{
+	CognitiveHierarchyResult result;
+	double total = 0.0;
+	for (int k = 0; (unsigned)k < levelProbabilities.size(); k++)
+	{
+		if (!(levelProbabilities.at(k) >= 0.0))
+		{
+			result.status = GameStatus("P(L_" + to_string(k) + ") is negative");
+			return result;
+		}
+		total += levelProbabilities.at(k);
+	}
+	if (!(total > 0.0))
+	{
+		result.status = GameStatus("the level probabilities sum to 0");
+		return result;
+	}
+	for (int k = 0; (unsigned)k < levelProbabilities.size(); k++)
+		levelProbabilities.at(k) /= total;
+	result.levelProbabilities = levelProbabilities;
+
+	int nP = payoffs.getNumPlayers(), K = levelProbabilities.size() - 1;
+	vector<vector<double> > level = vector<vector<double> >(nP); // the current level's strategies
+	for (int x = 0; x < nP; x++)
+		level.at(x).assign(payoffs.getNumStrats(x), 1.0 / payoffs.getNumStrats(x));
+
+	// the levels so far, weighted by their probabilities; plain sums are the fallback while those are all 0
+	vector<vector<double> > weighted = vector<vector<double> >(nP), plain = vector<vector<double> >(nP);
+	double weight = 0.0;
+	vector<vector<double> > beliefs = vector<vector<double> >(nP);
+	vector<double> utilities;
+
+	result.prediction = vector<vector<double> >(nP);
+	for (int x = 0; x < nP; x++)
+	{
+		weighted.at(x).assign(payoffs.getNumStrats(x), 0.0);
+		plain.at(x).assign(payoffs.getNumStrats(x), 0.0);
+		result.prediction.at(x).assign(payoffs.getNumStrats(x), 0.0);
+	}
+
+	for (int k = 0; k <= K; k++)
+	{
+		if (k > 0)
+		{
+			// L_k's beliefs: the normalized mixture of levels 0 to k - 1
+			for (int y = 0; y < nP; y++)
+			{
+				beliefs.at(y) = weight > 0.0 ? weighted.at(y) : plain.at(y);
+				double scale = weight > 0.0 ? 1.0 / weight : 1.0 / k;
+				for (int s = 0; (unsigned)s < beliefs.at(y).size(); s++)
+					beliefs.at(y).at(s) *= scale;
+			}
+			for (int x = 0; x < nP; x++)
+			{
+				expectedPayoffs(payoffs, x, beliefs, utilities);
+				double best = utilities.at(0);
+				for (int s = 1; (unsigned)s < utilities.size(); s++)
+					best = max(best, utilities.at(s));
+				double tolerance = 1e-9 * max(1.0, fabs(best));
+				int numBest = 0;
+				for (int s = 0; (unsigned)s < utilities.size(); s++)
+					numBest += utilities.at(s) >= best - tolerance;
+				for (int s = 0; (unsigned)s < utilities.size(); s++)
+					level.at(x).at(s) = utilities.at(s) >= best - tolerance ? 1.0 / numBest : 0.0;
+			}
+		}
+
+		result.levelStrategies.push_back(level);
+		double p = levelProbabilities.at(k);
+		for (int x = 0; x < nP; x++)
+			for (int s = 0; (unsigned)s < level.at(x).size(); s++)
+			{
+				weighted.at(x).at(s) += p * level.at(x).at(s);
+				plain.at(x).at(s) += level.at(x).at(s);
+				result.prediction.at(x).at(s) += p * level.at(x).at(s);
+			}
+		weight += p;
+	}
+
+	result.expectedUtilities = vector<double>(nP);
+	for (int x = 0; x < nP; x++)
+		result.expectedUtilities.at(x) = expectedPayoff(payoffs, x, result.prediction);
+	return result;
+}
+
+#endif
@@ -0,0 +1,447 @@
+/*******************************
+Title: Estimation.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: maximum-likelihood fits of level probabilities and the logit QRE precision to observed choices
+********************************/
+
+#ifndef ESTIMATION_H
+#define ESTIMATION_H
+#include "GameResults.h"
+#include "KLevelEngine.h"
+#include "QuantalResponse.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Each Observation is a game and how many participants in each player's role
+chose each strategy. The models' parameters are shared by every game:
+	fitLevels() 	a share of choosers at each of levels 0 to K, the
+					levels as in KLevelEngine, each choice uniformly random
+					with the fitted error rate instead
+	fitQRE() 		the logit QRE precision lambda
+Both maximize the log-likelihood with BFGS on unconstrained parameters
+(softmax level shares, a logistic error rate, log lambda) using analytic
+gradients; a QRE's derivative in lambda comes from qreDerivative(). The
+games' terms are computed in parallel and summed in game order, so a fit
+doesn't depend on the number of threads.
+******************************************************************************/
+
+// a game and the choices observed in it
+template <typename T>
+struct Observation
+{
+	string name;
+	PayoffTensor<T> payoffs;
+	vector<vector<double> > counts; // counts.at(x).at(s) participants in P_x's role chose s
+};
+
+/// @brief reads counts written 12,30;15,27: a list per player, separated by semicolons
+/// @param text
+/// @param counts receives them
+/// @return false if a count isn't a number
+inline bool parseChoiceCounts(const string &text, vector<vector<double> > &counts)
+{
+	counts.clear();
+	string player, count;
+	istringstream players(text);
+	while (getline(players, player, ';'))
+	{
+		counts.push_back(vector<double>());
+		istringstream strats(player);
+		while (getline(strats, count, ','))
+		{
+			char* end = NULL;
+			counts.back().push_back(strtod(count.c_str(), &end));
+			if (count.empty() || *end != '\0')
+				return false;
+		}
+	}
+	return !counts.empty();
+}
+
+/// @brief checks that every game's counts fit its players and strategies
+/// @param observations
+/// @return the first problem
+template <typename T>
+GameStatus checkObservations(const vector<Observation<T> > &observations)
+{
+	double total = 0.0;
+	for (int g = 0; (unsigned)g < observations.size(); g++)
+	{
+		const Observation<T> &o = observations.at(g);
+		if (o.counts.size() != (unsigned)o.payoffs.getNumPlayers())
+			return GameStatus(o.name + " has counts for " + to_string(o.counts.size()) + " players, but "
+				+ to_string(o.payoffs.getNumPlayers()) + " players");
+		for (int x = 0; (unsigned)x < o.counts.size(); x++)
+		{
+			if (o.counts.at(x).size() != (unsigned)o.payoffs.getNumStrats(x))
+				return GameStatus(o.name + " has " + to_string(o.counts.at(x).size()) + " counts for P_" + to_string(x + 1)
+					+ ", who has " + to_string(o.payoffs.getNumStrats(x)) + " strategies");
+			for (int s = 0; (unsigned)s < o.counts.at(x).size(); s++)
+			{
+				if (!(o.counts.at(x).at(s) >= 0.0))
+					return GameStatus(o.name + " has a negative count");
+				total += o.counts.at(x).at(s);
+			}
+		}
+	}
+	if (!(total > 0.0))
+		return GameStatus("there are no observed choices");
+	return GameStatus();
+}
+
+/// @brief runs work(first, last) over pieces of numItems items on pool and waits for them
+/// @param pool
+/// @param numItems
+/// @param work
+inline void parallelFor(ThreadPool &pool, size_t numItems, const function<void(size_t, size_t)> &work)
+{
+	size_t numPieces = min(numItems, (size_t)pool.getNumThreads() * 4);
+	for (size_t p = 0; p < numPieces; p++)
+	{
+		size_t first = numItems * p / numPieces, last = numItems * (p + 1) / numPieces;
+		pool.push([&work, first, last] { work(first, last); });
+	}
+	pool.wait();
+}
+
+/// @brief maximizes f by BFGS with a backtracking line search, no step moving any x_i more than maxStep
+/// @param f returns f(x) and sets its gradient; it may return -HUGE_VAL where f isn't defined
+/// @param x the start, where f must be finite; receives the maximizer
+/// @param maxIterations
+/// @param tolerance on the gradient's largest entry, and on a step's gain, relative to max(1, |f(x)|)
+/// @param maxStep
+/// @return the number of iterations
+inline int maximizeBFGS(const function<double(const vector<double> &, vector<double> &)> &f, vector<double> &x,
+	int maxIterations = 500, double tolerance = 1e-8, double maxStep = 2.0)
+{
+	int n = x.size();
+	vector<double> gradient = vector<double>(n), nextGradient = vector<double>(n), next = vector<double>(n);
+	vector<double> direction = vector<double>(n), s = vector<double>(n), y = vector<double>(n), Hy = vector<double>(n);
+	vector<double> H = vector<double>((size_t)n * n, 0.0); // inverse Hessian of -f
+	for (int i = 0; i < n; i++)
+		H[i * n + i] = 1.0;
+	bool scaled = false;
+
+	double value = f(x, gradient);
+	if (!isfinite(value))
+		return 0;
+
+	int iteration = 0;
+	for (; iteration < maxIterations; iteration++)
+	{
+		double largest = 0.0;
+		for (int i = 0; i < n; i++)
+			largest = max(largest, fabs(gradient[i]));
+		if (largest <= tolerance * max(1.0, fabs(value)))
+			break;
+
+		double slope = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			direction[i] = 0.0;
+			for (int j = 0; j < n; j++)
+				direction[i] += H[i * n + j] * gradient[j];
+			slope += gradient[i] * direction[i];
+		}
+		if (!(slope > 0.0))
+		{
+			// H has lost its curvature; start again from steepest ascent
+			for (int i = 0; i < n; i++)
+				for (int j = 0; j < n; j++)
+					H[i * n + j] = i == j;
+			direction = gradient;
+			slope = 0.0;
+			for (int i = 0; i < n; i++)
+				slope += gradient[i] * gradient[i];
+		}
+
+		double longest = 0.0, t = 1.0, nextValue = 0.0;
+		for (int i = 0; i < n; i++)
+			longest = max(longest, fabs(direction[i]));
+		if (longest > maxStep)
+			t = maxStep / longest;
+		while (true)
+		{
+			for (int i = 0; i < n; i++)
+				next[i] = x[i] + t * direction[i];
+			nextValue = f(next, nextGradient);
+			if (isfinite(nextValue) && nextValue >= value + 1e-4 * t * slope)
+				break;
+			t /= 2;
+			if (t < 1e-16)
+				return iteration;
+		}
+
+		double sy = 0.0, yHy = 0.0;
+		for (int i = 0; i < n; i++)
+		{
+			s[i] = next[i] - x[i];
+			y[i] = gradient[i] - nextGradient[i]; // the change in the gradient of -f
+			sy += s[i] * y[i];
+		}
+		bool converged = nextValue - value <= tolerance * 1e-4 * max(1.0, fabs(value));
+		x = next;
+		value = nextValue;
+		gradient = nextGradient;
+		if (converged)
+			break;
+		if (sy <= 1e-300)
+			continue;
+
+		if (!scaled)
+		{
+			// the first step sets the scale of H
+			double yy = 0.0;
+			for (int i = 0; i < n; i++)
+				yy += y[i] * y[i];
+			for (int i = 0; i < n; i++)
+				H[i * n + i] = sy / yy;
+			scaled = true;
+		}
+		for (int i = 0; i < n; i++)
+		{
+			Hy[i] = 0.0;
+			for (int j = 0; j < n; j++)
+				Hy[i] += H[i * n + j] * y[j];
+			yHy += y[i] * Hy[i];
+		}
+		double rho = 1.0 / sy;
+		for (int i = 0; i < n; i++)
+			for (int j = 0; j < n; j++)
+				H[i * n + j] += -rho * (s[i] * Hy[j] + Hy[i] * s[j]) + (rho * rho * yHy + rho) * s[i] * s[j];
+	}
+	return iteration;
+}
+
+// a strategy some participants chose: how many, 1 / the chooser's number of strategies, and the levels that play it
+struct LevelCell
+{
+	double count;
+	double uniform;
+	uint64_t levels; // bit k for L_k
+};
+
+/// @brief fits the shares of levels 0 to maxLevel and an error rate to the observed choices
+/// @param observations
+/// @param maxLevel from 0 to 62
+/// @param numThreads 0 uses one per hardware thread
+/// @return the shares, error rate, and log-likelihood
+template <typename T>
+LevelFitResult fitLevels(const vector<Observation<T> > &observations, int maxLevel, int numThreads = 0)
+{
+	LevelFitResult result;
+	result.status = checkObservations(observations);
+	if (!result.status.ok)
+		return result;
+	if (maxLevel < 0 || maxLevel > 62)
+	{
+		result.status = GameStatus("the highest level must be from 0 to 62");
+		return result;
+	}
+
+	int K = maxLevel;
+	size_t G = observations.size();
+	ThreadPool pool(numThreads);
+
+	// what each level plays, game by game
+	vector<vector<LevelCell> > cells = vector<vector<LevelCell> >(G);
+	parallelFor(pool, G, [&](size_t first, size_t last)
+	{
+		for (size_t g = first; g < last; g++)
+		{
+			const Observation<T> &o = observations.at(g);
+			KLevelEngine<T> engine(o.payoffs);
+			for (int x = 0; (unsigned)x < o.counts.size(); x++)
+				for (int s = 0; (unsigned)s < o.counts.at(x).size(); s++)
+				{
+					if (o.counts.at(x).at(s) == 0.0)
+						continue;
+					LevelCell cell = { o.counts.at(x).at(s), 1.0 / o.counts.at(x).size(), 0 };
+					for (int k = 0; k <= K; k++)
+					{
+						if (engine.strategy(k, x) == s)
+							cell.levels |= (uint64_t)1 << k;
+					}
+					cells.at(g).push_back(cell);
+				}
+		}
+	});
+
+	// params: theta_1, ..., theta_K (theta_0 is 0), then the error rate's logit
+	vector<double> logLikelihoods = vector<double>(G), gradients = vector<double>(G * (K + 1));
+	function<double(const vector<double> &, vector<double> &)> objective = [&](const vector<double> &params, vector<double> &gradient)
+	{
+		vector<double> shares = vector<double>(K + 1);
+		double largest = 0.0, sum = 0.0;
+		for (int k = 1; k <= K; k++)
+			largest = max(largest, params.at(k - 1));
+		for (int k = 0; k <= K; k++)
+		{
+			shares.at(k) = exp((k == 0 ? 0.0 : params.at(k - 1)) - largest);
+			sum += shares.at(k);
+		}
+		for (int k = 0; k <= K; k++)
+			shares.at(k) /= sum;
+		double error = 1.0 / (1.0 + exp(-params.at(K)));
+
+		parallelFor(pool, G, [&](size_t first, size_t last)
+		{
+			for (size_t g = first; g < last; g++)
+			{
+				double logLikelihood = 0.0;
+				double* grad = &gradients[g * (K + 1)];
+				for (int j = 0; j <= K; j++)
+					grad[j] = 0.0;
+				for (int c = 0; (unsigned)c < cells.at(g).size(); c++)
+				{
+					const LevelCell &cell = cells.at(g).at(c);
+					double played = 0.0; // the share of levels playing it
+					for (int k = 0; k <= K; k++)
+					{
+						if (cell.levels >> k & 1)
+							played += shares.at(k);
+					}
+					double q = (1.0 - error) * played + error * cell.uniform;
+					logLikelihood += cell.count * log(q);
+					double r = cell.count / q;
+					for (int j = 1; j <= K; j++)
+						grad[j - 1] += r * (1.0 - error) * shares.at(j) * ((cell.levels >> j & 1) - played);
+					grad[K] += r * (cell.uniform - played) * error * (1.0 - error);
+				}
+				logLikelihoods.at(g) = logLikelihood;
+			}
+		});
+
+		double total = 0.0;
+		gradient.assign(K + 1, 0.0);
+		for (size_t g = 0; g < G; g++)
+		{
+			total += logLikelihoods.at(g);
+			for (int j = 0; j <= K; j++)
+				gradient.at(j) += gradients[g * (K + 1) + j];
+		}
+		return isnan(total) ? -HUGE_VAL : total;
+	};
+
+	vector<double> params = vector<double>(K + 1, 0.0), gradient;
+	params.at(K) = log(0.1 / 0.9); // a 10% error rate to start
+	result.iterations = maximizeBFGS(objective, params);
+	result.logLikelihood = objective(params, gradient);
+
+	double largest = 0.0, sum = 0.0;
+	for (int k = 1; k <= K; k++)
+		largest = max(largest, params.at(k - 1));
+	result.levelProbabilities = vector<double>(K + 1);
+	for (int k = 0; k <= K; k++)
+	{
+		result.levelProbabilities.at(k) = exp((k == 0 ? 0.0 : params.at(k - 1)) - largest);
+		sum += result.levelProbabilities.at(k);
+	}
+	for (int k = 0; k <= K; k++)
+		result.levelProbabilities.at(k) /= sum;
+	result.errorRate = 1.0 / (1.0 + exp(-params.at(K)));
+	return result;
+}
+
+/// @brief fits the logit QRE precision to the observed choices; each game's QRE is found from its QRE at the
+/// last precision tried, so the fit follows the branch the search moves along
+/// @param observations
+/// @param numThreads 0 uses one per hardware thread
+/// @return lambda and the log-likelihood
+template <typename T>
+QREFitResult fitQRE(const vector<Observation<T> > &observations, int numThreads = 0)
+{
+	QREFitResult result;
+	result.status = checkObservations(observations);
+	if (!result.status.ok)
+		return result;
+
+	size_t G = observations.size();
+	ThreadPool pool(numThreads);
+	vector<vector<vector<double> > > profiles = vector<vector<vector<double> > >(G);
+	for (size_t g = 0; g < G; g++)
+		profiles.at(g) = uniformProfile(observations.at(g).payoffs);
+
+	// params: log lambda
+	vector<double> logLikelihoods = vector<double>(G), derivatives = vector<double>(G);
+	function<double(const vector<double> &, vector<double> &)> objective = [&](const vector<double> &params, vector<double> &gradient)
+	{
+		double lambda = exp(params.at(0));
+		parallelFor(pool, G, [&](size_t first, size_t last)
+		{
+			vector<vector<double> > derivative;
+			for (size_t g = first; g < last; g++)
+			{
+				const Observation<T> &o = observations.at(g);
+				vector<vector<double> > &profile = profiles.at(g);
+				logLikelihoods.at(g) = -HUGE_VAL;
+				derivatives.at(g) = 0.0;
+				if (!logitQRE(o.payoffs, lambda, profile))
+				{
+					profile = uniformProfile(o.payoffs);
+					if (!logitQRE(o.payoffs, lambda, profile))
+						continue;
+				}
+				bool differentiable = qreDerivative(o.payoffs, lambda, profile, derivative);
+
+				double logLikelihood = 0.0, slope = 0.0;
+				for (int x = 0; (unsigned)x < o.counts.size(); x++)
+					for (int s = 0; (unsigned)s < o.counts.at(x).size(); s++)
+					{
+						double c = o.counts.at(x).at(s);
+						if (c == 0.0)
+							continue;
+						logLikelihood += c * log(profile.at(x).at(s));
+						if (differentiable)
+							slope += c / profile.at(x).at(s) * derivative.at(x).at(s);
+					}
+				logLikelihoods.at(g) = logLikelihood;
+				derivatives.at(g) = slope;
+			}
+		});
+
+		double total = 0.0, slope = 0.0;
+		for (size_t g = 0; g < G; g++)
+		{
+			total += logLikelihoods.at(g);
+			slope += derivatives.at(g);
+		}
+		gradient.assign(1, lambda * slope);
+		return isnan(total) ? -HUGE_VAL : total;
+	};
+
+	// lambda starts at 1 / the largest payoff range, where that difference in payoffs changes a choice's odds by a factor of e,
+	// and is halved until no observed choice is so unlikely its log-likelihood is -inf
+	double range = 0.0;
+	for (size_t g = 0; g < G; g++)
+	{
+		const PayoffTensor<T> &payoffs = observations.at(g).payoffs;
+		if (payoffs.size() == 0)
+			continue;
+		pair<const T*, const T*> extremes = minmax_element(payoffs.data(), payoffs.data() + payoffs.size());
+		range = max(range, (double)*extremes.second - (double)*extremes.first);
+	}
+	vector<double> params = vector<double>(1, range > 0.0 ? -log(range) : 0.0), gradient;
+	for (int halvings = 0; halvings < 64 && !isfinite(objective(params, gradient)); halvings++)
+		params.at(0) -= log(2.0);
+
+	result.iterations = maximizeBFGS(objective, params);
+	result.logLikelihood = objective(params, gradient);
+	result.precision = exp(params.at(0));
+	if (!isfinite(result.logLikelihood))
+		result.status = GameStatus("no precision gives every observed choice a positive probability");
+	return result;
+}
+
+#endif
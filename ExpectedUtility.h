@@ -0,0 +1,110 @@
+/*******************************
+Title: ExpectedUtility.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: expected payoffs of every strategy against independent mixed strategies, in one pass over a payoff tensor
+********************************/
+
+#ifndef EXPECTEDUTILITY_H
+#define EXPECTEDUTILITY_H
+#include "PayoffTensor.h"
+
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+expectedPayoffs() is the kernel behind the behavioral models: it walks the
+payoffs once in memory order, weighting each matrix by the probability of
+its strategies for the players past P_2 and skipping the ones with weight
+0, so its cost is proportional to the outcomes the others can reach. Within
+a matrix P_1's payoffs are summed a row at a time and P_2's a column at a
+time, loops with no branches that the compiler can vectorize.
+******************************************************************************/
+
+/// @brief P_x's expected payoff from each of their strategies when each other player y plays profile.at(y)
+/// @param payoffs
+/// @param x
+/// @param profile profile.at(y).at(s) is the probability P_y plays s; profile.at(x) isn't used
+/// @param utilities receives one per strategy of P_x
+template <typename T>
+void expectedPayoffs(const PayoffTensor<T> &payoffs, int x, const vector<vector<double> > &profile, vector<double> &utilities)
+{
+	int nP = payoffs.getNumPlayers(), n0 = payoffs.getNumStrats(0), n1 = payoffs.getNumStrats(1);
+	utilities.assign(payoffs.getNumStrats(x), 0.0);
+	const vector<double> &rowMix = profile.at(0), &columnMix = profile.at(1);
+
+	vector<int> strats = vector<int>(nP, 0); // the strategies of the players past P_2 in matrix m
+	const T* matrix = payoffs.data();
+	for (size_t m = 0; m < payoffs.getNumMatrices(); m++, matrix += (size_t)n0 * n1 * nP)
+	{
+		double weight = 1.0;
+		for (int y = 2; y < nP; y++)
+		{
+			if (y != x)
+				weight *= profile.at(y).at(strats.at(y));
+		}
+
+		if (weight != 0.0)
+		{
+			if (x == 0)
+			{
+				for (int i = 0; i < n0; i++)
+				{
+					const T* p = matrix + (size_t)i * n1 * nP;
+					double sum = 0.0;
+					for (int j = 0; j < n1; j++)
+						sum += columnMix[j] * p[j * nP];
+					utilities[i] += weight * sum;
+				}
+			}
+			else if (x == 1)
+			{
+				for (int i = 0; i < n0; i++)
+				{
+					double w = weight * rowMix[i];
+					if (w == 0.0)
+						continue;
+					const T* p = matrix + (size_t)i * n1 * nP + 1;
+					for (int j = 0; j < n1; j++)
+						utilities[j] += w * p[j * nP];
+				}
+			}
+			else
+			{
+				double sum = 0.0;
+				for (int i = 0; i < n0; i++)
+				{
+					if (rowMix[i] == 0.0)
+						continue;
+					const T* p = matrix + (size_t)i * n1 * nP + x;
+					double rowSum = 0.0;
+					for (int j = 0; j < n1; j++)
+						rowSum += columnMix[j] * p[j * nP];
+					sum += rowMix[i] * rowSum;
+				}
+				utilities[strats.at(x)] += weight * sum;
+			}
+		}
+
+		// the next matrix, P_3's strategy changing fastest
+		for (int y = 2; y < nP && ++strats.at(y) == payoffs.getNumStrats(y); y++)
+			strats.at(y) = 0;
+	}
+}
+
+/// @brief P_x's expected payoff when every player y plays profile.at(y)
+/// @param payoffs
+/// @param x
+/// @param profile
+template <typename T>
+double expectedPayoff(const PayoffTensor<T> &payoffs, int x, const vector<vector<double> > &profile)
+{
+	vector<double> utilities;
+	expectedPayoffs(payoffs, x, profile, utilities);
+	double sum = 0.0;
+	for (int s = 0; (unsigned)s < utilities.size(); s++)
+		sum += profile.at(x).at(s) * utilities.at(s);
+	return sum;
+}
+
+#endif
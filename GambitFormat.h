@@ -0,0 +1,487 @@
+/*******************************
+Title: GambitFormat.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: reads and writes games in Gambit's normal form (.nfg) format
+********************************/
+
+#ifndef GAMBITFORMAT_H
+#define GAMBITFORMAT_H
+#include "BufferedWriter.h"
+#include "GameReader.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Both versions of an .nfg file start
+	NFG 1 R "title" { "player 1" "player 2" ... }
+The payoff version goes on with the numbers of strategies, { n_1 n_2 ... },
+an optional comment, and the payoffs of every profile. The outcome version
+goes on with the strategies' names, { { "s_1" ... } ... }, an optional
+comment, a list of outcomes, { { "name" u_1, u_2, ... } ... }, and then the
+outcome of every profile, 0 meaning payoffs of 0. Profiles are listed with
+P_1's strategy changing fastest, then P_2's, and so on, so each matrix is
+the transpose of PayoffTensor's; the matrices themselves are in the same
+order.
+******************************************************************************/
+
+// the names an .nfg file gives its game and players
+struct NfgLabels
+{
+	string title;
+	vector<string> players;
+	string comment;
+};
+
+/******************************************************************************
+splits an .nfg file into braces, quoted strings, words, and numbers. Like
+PayoffScanner, characters are classified with a table and integers take a
+fast path; decimals and rationals such as 3/2 are converted with strtod().
+******************************************************************************/
+class NfgScanner
+{
+	private:
+		enum CharClass { OTHER, SEPARATOR, DIGIT, SIGN, BRACE, QUOTE };
+
+		const char* first;
+		const char* pos;
+		const char* last;
+		const unsigned char* table; // classes()
+
+		static const unsigned char* classes();
+		bool endsToken(const char* p) const { return p == last || (table[(unsigned char)*p] != OTHER && table[(unsigned char)*p] != DIGIT && table[(unsigned char)*p] != SIGN); }
+		bool readSlowNumber(double &);
+		void skipSeparators();
+	public:
+		NfgScanner(const char* f, const char* l) { first = f; pos = f; last = l; table = classes(); }
+
+		string describePosition() const { return describeTextPosition(first, pos); }
+		size_t remaining() const 		{ return last - pos; }
+
+		bool atEnd();
+		bool isNext(char);
+		template <typename T> bool readNumber(T &);
+		bool readString(string &);
+		bool readWord(string &);
+		bool skip(char);
+};
+
+// true if only separators are left
+bool NfgScanner::atEnd()
+{
+	skipSeparators();
+	return pos == last;
+}
+
+// character classes; a function-local static is built once even with several threads reading
+const unsigned char* NfgScanner::classes()
+{
+	struct Table
+	{
+		unsigned char c[256];
+
+		Table()
+		{
+			memset(c, OTHER, sizeof(c));
+			c[(unsigned char)' '] = c[(unsigned char)'\t'] = c[(unsigned char)'\n'] = SEPARATOR;
+			c[(unsigned char)'\r'] = c[(unsigned char)'\v'] = c[(unsigned char)'\f'] = c[(unsigned char)','] = SEPARATOR;
+			for (int d = '0'; d <= '9'; d++)
+				c[d] = DIGIT;
+			c[(unsigned char)'-'] = c[(unsigned char)'+'] = SIGN;
+			c[(unsigned char)'{'] = c[(unsigned char)'}'] = BRACE;
+			c[(unsigned char)'"'] = QUOTE;
+		}
+	};
+	static const Table table;
+	return table.c;
+}
+
+// true if the next character, after any separators, is c
+bool NfgScanner::isNext(char c)
+{
+	skipSeparators();
+	return pos < last && *pos == c;
+}
+
+/// @brief reads the next number
+/// @param value
+/// @return false if it isn't a number or doesn't fit in a T; pos is left at the problem
+template <typename T>
+bool NfgScanner::readNumber(T &value)
+{
+	skipSeparators();
+	if (pos == last)
+		return false;
+
+	// at most 18 digits can't overflow a long long
+	const char* p = pos;
+	bool negative = false;
+	if (table[(unsigned char)*p] == SIGN)
+	{
+		negative = *p == '-';
+		p++;
+	}
+	const char* digitsEnd = last - p > 18 ? p + 18 : last;
+	const char* digitsStart = p;
+	unsigned long long v = 0;
+	unsigned d;
+	while (p < digitsEnd && (d = (unsigned char)(*p - '0')) < 10)
+	{
+		v = v * 10 + d;
+		p++;
+	}
+
+	double number;
+	if (p > digitsStart && endsToken(p))
+	{
+		long long n = negative ? -(long long)v : (long long)v;
+		if (numeric_limits<T>::is_integer && (n < (long long)numeric_limits<T>::min() || n > (long long)numeric_limits<T>::max()))
+			return false;
+		value = static_cast<T>(n);
+		pos = p;
+		return true;
+	}
+
+	// decimals, exponents, rationals, and integers too long for the fast path
+	const char* start = pos;
+	if (!readSlowNumber(number))
+		return false;
+	if (numeric_limits<T>::is_integer && (number != floor(number) || number < (double)numeric_limits<T>::min() || number > (double)numeric_limits<T>::max()))
+	{
+		pos = start;
+		return false;
+	}
+	value = static_cast<T>(number);
+	return true;
+}
+
+// a number that isn't a short integer, e.g., 1.5, -2e3, or 3/2
+bool NfgScanner::readSlowNumber(double &value)
+{
+	const char* p = pos;
+	while (!endsToken(p))
+		p++;
+	string token(pos, p);
+
+	char* end;
+	size_t slash = token.find('/');
+	if (slash == string::npos)
+	{
+		value = strtod(token.c_str(), &end);
+		if (token.empty() || *end != '\0')
+			return false;
+	}
+	else
+	{
+		string numerator = token.substr(0, slash), denominator = token.substr(slash + 1);
+		double n = strtod(numerator.c_str(), &end);
+		if (numerator.empty() || *end != '\0')
+			return false;
+		double q = strtod(denominator.c_str(), &end);
+		if (denominator.empty() || *end != '\0' || q == 0)
+			return false;
+		value = n / q;
+	}
+	if (!isfinite(value))
+		return false;
+	pos = p;
+	return true;
+}
+
+/// @brief reads the next quoted string; a backslash makes the character after it part of the string
+/// @param s receives the string without its quotes
+/// @return false if the next token isn't a string or it's never closed
+bool NfgScanner::readString(string &s)
+{
+	if (!isNext('"'))
+		return false;
+
+	s.clear();
+	for (const char* p = pos + 1; p < last; p++)
+	{
+		if (*p == '"')
+		{
+			pos = p + 1;
+			return true;
+		}
+		if (*p == '\\' && p + 1 < last)
+			p++;
+		s += *p;
+	}
+	return false;
+}
+
+/// @brief reads the next word, e.g., NFG
+/// @param word
+/// @return false if the next token isn't a word
+bool NfgScanner::readWord(string &word)
+{
+	skipSeparators();
+	const char* p = pos;
+	while (!endsToken(p))
+		p++;
+	if (p == pos)
+		return false;
+	word.assign(pos, p);
+	pos = p;
+	return true;
+}
+
+// moves past c if it's next; false if it isn't
+bool NfgScanner::skip(char c)
+{
+	if (!isNext(c))
+		return false;
+	pos++;
+	return true;
+}
+
+// moves past whitespace and commas
+void NfgScanner::skipSeparators()
+{
+	while (pos < last && table[(unsigned char)*pos] == SEPARATOR)
+		pos++;
+}
+
+/// @brief parses the text of an .nfg file of either version
+/// @param first start of the text
+/// @param last end of the text
+/// @param name the file's name, for error messages
+/// @param payoffs receives the numbers of strategies and the payoffs
+/// @param labels if not NULL, receives the title, the players' names, and the comment
+/// @return the first problem found; payoffs and labels are unchanged on failure
+template <typename T>
+GameStatus parseNfg(const char* first, const char* last, const string &name, PayoffTensor<T> &payoffs, NfgLabels* labels = NULL)
+{
+	NfgScanner scanner(first, last);
+	NfgLabels l;
+	string word;
+	int version = 0;
+
+	if (!scanner.readWord(word) || word != "NFG")
+		return GameStatus(name + " does not start with NFG");
+	if (!scanner.readNumber(version) || version != 1)
+		return GameStatus(name + " is not version 1 of the .nfg format");
+	if (!scanner.readWord(word) || (word != "R" && word != "D"))
+		return GameStatus(name + " does not say whether its payoffs are rational (R) or decimal (D)");
+	if (!scanner.readString(l.title))
+		return GameStatus("could not read the title of " + name + " (" + scanner.describePosition() + ")");
+
+	if (!scanner.skip('{'))
+		return GameStatus("could not read the players of " + name + " (" + scanner.describePosition() + ")");
+	while (!scanner.skip('}'))
+	{
+		string player;
+		if (!scanner.readString(player))
+			return GameStatus("could not read the name of P_" + to_string(l.players.size() + 1) + " from " + name + " (" + scanner.describePosition() + ")");
+		l.players.push_back(player);
+	}
+	int nP = l.players.size();
+	if (nP < 2)
+		return GameStatus(name + " has fewer than 2 players");
+
+	// counts in the payoff version, lists of names in the outcome version
+	if (!scanner.skip('{'))
+		return GameStatus("could not read the strategies of " + name + " (" + scanner.describePosition() + ")");
+	bool outcomeVersion = scanner.isNext('{');
+	vector<int> numStrats = vector<int>(nP);
+	for (int x = 0; x < nP; x++)
+	{
+		if (outcomeVersion)
+		{
+			string strategy;
+			if (!scanner.skip('{'))
+				return GameStatus("could not read P_" + to_string(x + 1) + "'s strategies from " + name + " (" + scanner.describePosition() + ")");
+			while (!scanner.skip('}'))
+			{
+				if (!scanner.readString(strategy) || numStrats.at(x) == INT_MAX)
+					return GameStatus("could not read P_" + to_string(x + 1) + "'s strategies from " + name + " (" + scanner.describePosition() + ")");
+				numStrats.at(x)++;
+			}
+		}
+		else if (!scanner.readNumber(numStrats.at(x)))
+			numStrats.at(x) = 0;
+		if (numStrats.at(x) < 1)
+			return GameStatus("could not read P_" + to_string(x + 1) + "'s number of strategies from " + name + " (" + scanner.describePosition() + ")");
+	}
+	if (!scanner.skip('}'))
+		return GameStatus(name + " gives strategies for more than its " + to_string(nP) + " players (" + scanner.describePosition() + ")");
+	if (scanner.isNext('"'))
+		scanner.readString(l.comment);
+
+	// the dimensions are checked against the file before anything is allocated
+	size_t size = nP;
+	for (int x = 0; x < nP; x++)
+	{
+		if (size > (size_t)INT_MAX / numStrats.at(x))
+			return GameStatus(name + " has too many outcomes");
+		size *= numStrats.at(x);
+	}
+	size_t numProfiles = size / nP;
+	if ((outcomeVersion ? numProfiles : size) > (scanner.remaining() + 1) / 2)
+		return GameStatus(name + " is too short for the " + to_string(numProfiles) + " profiles its dimensions need");
+
+	vector<T> outcomes; // the outcome version's payoffs, nP per outcome, after outcome 0's zeros
+	if (outcomeVersion)
+	{
+		outcomes.assign(nP, T());
+		if (!scanner.skip('{'))
+			return GameStatus("could not read the outcomes of " + name + " (" + scanner.describePosition() + ")");
+		while (!scanner.skip('}'))
+		{
+			string outcomeName;
+			size_t k = outcomes.size() / nP;
+			if (!scanner.skip('{'))
+				return GameStatus("could not read outcome " + to_string(k) + " of " + name + " (" + scanner.describePosition() + ")");
+			if (scanner.isNext('"'))
+				scanner.readString(outcomeName);
+			for (int x = 0; x < nP; x++)
+			{
+				T payoff;
+				if (!scanner.readNumber(payoff))
+					return GameStatus("could not read P_" + to_string(x + 1) + "'s payoff in outcome " + to_string(k) + " of " + name + " (" + scanner.describePosition() + ")");
+				outcomes.push_back(payoff);
+			}
+			if (!scanner.skip('}'))
+				return GameStatus("outcome " + to_string(k) + " of " + name + " has more than " + to_string(nP) + " payoffs (" + scanner.describePosition() + ")");
+		}
+	}
+
+	// P_1 fastest, then P_2, then the matrices in PayoffTensor's order
+	PayoffTensor<T> tensor(numStrats);
+	T* data = tensor.mutableData();
+	size_t n0 = numStrats.at(0), n1 = numStrats.at(1), numMatrices = numProfiles / (n0 * n1), numRead = 0;
+	for (size_t m = 0; m < numMatrices; m++)
+		for (size_t j = 0; j < n1; j++)
+			for (size_t i = 0; i < n0; i++, numRead++)
+			{
+				T* payoff = data + ((m * n0 + i) * n1 + j) * nP;
+				if (outcomeVersion)
+				{
+					int k = 0;
+					if (!scanner.readNumber(k))
+					{
+						if (scanner.atEnd())
+							return GameStatus(name + " has " + to_string(numRead) + " profiles' outcomes, but " + to_string(numProfiles) + " are needed");
+						return GameStatus("could not read the outcome of profile " + to_string(numRead + 1) + " from " + name + " (" + scanner.describePosition() + ")");
+					}
+					if (k < 0 || (size_t)k >= outcomes.size() / nP)
+						return GameStatus(name + " gives profile " + to_string(numRead + 1) + " outcome " + to_string(k) + ", but only outcomes 1 to " + to_string(outcomes.size() / nP - 1) + " are listed");
+					copy(outcomes.begin() + k * nP, outcomes.begin() + (k + 1) * nP, payoff);
+				}
+				else
+				{
+					for (int x = 0; x < nP; x++)
+					{
+						if (!scanner.readNumber(payoff[x]))
+						{
+							if (scanner.atEnd())
+								return GameStatus(name + " has " + to_string(numRead * nP + x) + " payoffs, but " + to_string(size) + " are needed");
+							return GameStatus("could not read payoff " + to_string(numRead * nP + x + 1) + " from " + name + " (" + scanner.describePosition() + ")");
+						}
+					}
+				}
+			}
+	if (!scanner.atEnd())
+		return GameStatus(name + " has more than the " + to_string(numProfiles) + " profiles its dimensions need (" + scanner.describePosition() + ")");
+
+	payoffs.swap(tensor);
+	if (labels)
+		*labels = l;
+	return GameStatus();
+}
+
+/// @brief maps filename and parses it with parseNfg()
+/// @return the first problem found; payoffs and labels are unchanged on failure
+template <typename T>
+GameStatus readNfg(const string &filename, PayoffTensor<T> &payoffs, NfgLabels* labels = NULL)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return GameStatus("could not open " + filename);
+	return parseNfg(file.begin(), file.end(), filename, payoffs, labels);
+}
+
+// s in quotes, with " and \ escaped
+inline string nfgQuote(const string &s)
+{
+	string quoted = "\"";
+	for (int c = 0; (unsigned)c < s.size(); c++)
+	{
+		if (s.at(c) == '"' || s.at(c) == '\\')
+			quoted += '\\';
+		quoted += s.at(c);
+	}
+	return quoted + "\"";
+}
+
+/// @brief writes payoffs in the payoff version of the .nfg format
+/// @param out checked by the caller
+/// @param payoffs
+/// @param labels players without a name are called P_1, P_2, ...
+template <typename T>
+void writeNfg(ostream &out, const PayoffTensor<T> &payoffs, const NfgLabels &labels = NfgLabels())
+{
+	int nP = payoffs.getNumPlayers();
+	out << "NFG 1 R " << nfgQuote(labels.title) << " {";
+	for (int x = 0; x < nP; x++)
+		out << " " << nfgQuote((unsigned)x < labels.players.size() ? labels.players.at(x) : "P_" + to_string(x + 1));
+	out << " } {";
+	for (int x = 0; x < nP; x++)
+		out << " " << payoffs.getNumStrats(x);
+	out << " }\n";
+	if (!labels.comment.empty())
+		out << nfgQuote(labels.comment) << "\n";
+	out << "\n";
+
+	// enough digits to read back the same value
+	streamsize precision = out.precision();
+	if (!numeric_limits<T>::is_integer)
+		out.precision(numeric_limits<T>::max_digits10);
+
+	// one profile a line, P_1's strategy changing fastest
+	BufferedWriter writer(out);
+	const T* data = payoffs.data();
+	size_t n0 = payoffs.getNumStrats(0), n1 = payoffs.getNumStrats(1);
+	for (size_t m = 0; m < payoffs.getNumMatrices(); m++)
+		for (size_t j = 0; j < n1; j++)
+			for (size_t i = 0; i < n0; i++)
+			{
+				const T* payoff = data + ((m * n0 + i) * n1 + j) * nP;
+				for (int x = 0; x < nP; x++)
+					writer << payoff[x] << (x < nP - 1 ? ' ' : '\n');
+			}
+	writer.flush();
+	out.precision(precision);
+}
+
+/// @brief writes payoffs to filename in the payoff version of the .nfg format
+/// @return an error if the file can't be written
+template <typename T>
+GameStatus writeNfg(const string &filename, const PayoffTensor<T> &payoffs, const NfgLabels &labels = NfgLabels())
+{
+	ofstream outfile(filename.c_str(), ios::out | ios::trunc);
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+	writeNfg(outfile, payoffs, labels);
+	if (!outfile)
+		return GameStatus("could not write " + filename);
+	return GameStatus();
+}
+
+// true if the file starts with NFG, as .nfg files do
+inline bool isNfgFile(const string &filename)
+{
+	char start[3];
+	ifstream infile(filename.c_str(), ios::in | ios::binary);
+	infile >> ws;
+	return infile.read(start, sizeof(start)) && memcmp(start, "NFG", sizeof(start)) == 0;
+}
+
+#endif
@@ -0,0 +1,295 @@
+/*******************************
+Title: GameClasses.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: random games of a given type, built to meet simGame's check*Conditions() directly
+********************************/
+
+#ifndef GAMECLASSES_H
+#define GAMECLASSES_H
+#include "GameCorpus.h"
+#include "RandomPayoffs.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// the types simGame::determineType() tells apart, in the order it checks them
+enum GameClass { ZS_GAME, IH_GAME, PD_GAME, PC_GAME, BOS_GAME, CHICKEN_GAME, SH_GAME, NULL_GAME };
+
+const int NUM_GAME_CLASSES = 8;
+const char* const GAME_CLASS_NAMES[NUM_GAME_CLASSES] = { "ZS", "IH", "PD", "PC", "BOS", "Chicken", "SH", "NULL" };
+
+/// @brief reads a type's name as simGame::typeName() gives it, in any case
+/// @param name
+/// @param c
+/// @return false if name isn't one of them
+inline bool parseGameClass(const string &name, GameClass &c)
+{
+	string lower = name;
+	transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+	for (int n = 0; n < NUM_GAME_CLASSES; n++)
+	{
+		string className = GAME_CLASS_NAMES[n];
+		transform(className.begin(), className.end(), className.begin(), ::tolower);
+		if (lower == className)
+		{
+			c = (GameClass)n;
+			return true;
+		}
+	}
+	return false;
+}
+
+// how many distinct payoffs each player needs for a game of class c
+inline int numDistinctPayoffs(GameClass c)
+{
+	switch (c)
+	{
+		case IH_GAME: case PD_GAME: case BOS_GAME: case CHICKEN_GAME:
+			return 4;
+		case PC_GAME: case SH_GAME:
+			return 3;
+		case ZS_GAME:
+			return 2;
+		default:
+			return 1;
+	}
+}
+
+/// @brief checks options before any games of class c are drawn
+/// @param c
+/// @param options numStrats, minPayoff, and maxPayoff; payoffs are always uniform integers
+/// @return the first problem
+inline GameStatus checkClassOptions(GameClass c, const RandGameOptions &options)
+{
+	GameStatus status = checkRandomOptions(options);
+	if (!status.ok)
+		return status;
+	if (options.distribution != UNIFORM_PAYOFFS)
+		return GameStatus("games of a given type are drawn uniformly from minPayoff to maxPayoff");
+
+	const vector<int> &nS = options.numStrats;
+	if (c == ZS_GAME && (nS.size() != 2 || nS.at(0) * nS.at(1) < 2))
+		return GameStatus("ZS games are drawn with 2 players and at least 2 outcomes");
+	if (c != ZS_GAME && c != NULL_GAME && (nS.size() != 2 || nS.at(0) != 2 || nS.at(1) != 2))
+		return GameStatus(string(GAME_CLASS_NAMES[c]) + " games are drawn as 2x2 games");
+	if ((long long)options.maxPayoff - options.minPayoff + 1 < numDistinctPayoffs(c))
+		return GameStatus(string(GAME_CLASS_NAMES[c]) + " games need " + to_string(numDistinctPayoffs(c))
+			+ " different payoffs from minPayoff to maxPayoff");
+	return GameStatus();
+}
+
+/// @brief k different integers from lo to hi in increasing order, by Floyd's sampling
+/// @param draws
+/// @param lo
+/// @param hi at least lo + k - 1
+/// @param k at most 4
+/// @param values receives them
+inline void drawDistinct(RandomStream &draws, long long lo, long long hi, int k, long long* values)
+{
+	long long range = hi - lo + 1;
+	for (long long j = range - k; j < range; j++)
+	{
+		long long t = draws.uniformInteger(0, j);
+		bool found = false;
+		for (int n = 0; n < j - (range - k); n++)
+			found = found || values[n] == lo + t;
+		values[j - (range - k)] = lo + (found ? j : t);
+	}
+	sort(values, values + k);
+}
+
+// swaps a and b with probability 1/2
+inline void maybeSwap(RandomStream &draws, long long &a, long long &b)
+{
+	if (draws.uniformInteger(0, 1))
+		swap(a, b);
+}
+
+/******************************************************************************
+Game k of class c, drawn from RandomStream(seed, options.stream, k) so that
+games can be drawn by any thread in any order. Each 2x2 class is built by
+placing ordered payoffs where its check*Conditions() expects them, rather
+than drawing games until one passes (r, c are P_1's and P_2's payoffs; v and
+w are each player's distinct payoffs, increasing):
+	IH 			(0,0) strictly dominant and best for both: r00 = v3, r01 > r11;
+				c00 = w3, c10 > c11; the rest in random order
+	PD 			r = [[R,S],[T,P]], c = [[R,T],[S,P]] with S < P < R < T
+	PC 			equal equilibria at (0,0) and (1,1), both off-diagonals lower
+	BOS 		equilibria at (0,0) and (1,1), each preferred by one player
+	Chicken 	r = [[crash,win],[lose,tie]], c its transpose
+	SH 			r = [[X,U],[W,W]], c = [[Y,Z],[V,Z]] with U < W < X, V < Z < Y
+ZS games are constant-sum with at least two different outcomes; NULL games
+give each player one payoff everywhere.
+******************************************************************************/
+template <typename T>
+void randomClassGame(PayoffTensor<T> &tensor, vector<int> &rationalities, GameClass c, const RandGameOptions &options,
+	unsigned long long seed, uint64_t k)
+{
+	RandomStream draws(seed, options.stream, k);
+	tensor.reset(options.numStrats);
+	T* p = tensor.mutableData();
+	int nP = options.numStrats.size();
+	long long lo = options.minPayoff, hi = options.maxPayoff;
+
+	if (c == ZS_GAME)
+	{
+		uint64_t numOutcomes = tensor.getNumOutcomes();
+		for (uint64_t o = 0; o < numOutcomes; o++)
+			p[2 * o] = (T)draws.uniformInteger(lo, hi);
+
+		// two different payoffs, so the game isn't also NULL
+		long long d[2];
+		drawDistinct(draws, lo, hi, 2, d);
+		uint64_t first = draws.uniformInteger(0, numOutcomes - 1), second = draws.uniformInteger(0, numOutcomes - 2);
+		if (second >= first)
+			second++;
+		p[2 * first] = (T)d[0];
+		p[2 * second] = (T)d[1];
+		for (uint64_t o = 0; o < numOutcomes; o++)
+			p[2 * o + 1] = (T)(lo + hi - p[2 * o]);
+	}
+	else if (c == NULL_GAME)
+	{
+		uint64_t numOutcomes = tensor.getNumOutcomes();
+		for (int x = 0; x < nP; x++)
+		{
+			T value = (T)draws.uniformInteger(lo, hi);
+			for (uint64_t o = 0; o < numOutcomes; o++)
+				p[o * nP + x] = value;
+		}
+	}
+	else
+	{
+		long long v[4], w[4];
+		drawDistinct(draws, lo, hi, numDistinctPayoffs(c), v);
+		drawDistinct(draws, lo, hi, numDistinctPayoffs(c), w);
+		long long r[2][2], s[2][2]; // P_1's and P_2's payoffs
+
+		if (c == IH_GAME)
+		{
+			r[0][0] = v[3];
+			s[0][0] = w[3];
+			for (int n = 2; n > 0; n--) // shuffles the three lower payoffs
+			{
+				swap(v[n], v[draws.uniformInteger(0, n)]);
+				swap(w[n], w[draws.uniformInteger(0, n)]);
+			}
+			r[0][1] = max(v[0], v[2]);
+			r[1][0] = v[1];
+			r[1][1] = min(v[0], v[2]);
+			s[1][0] = max(w[0], w[2]);
+			s[0][1] = w[1];
+			s[1][1] = min(w[0], w[2]);
+		}
+		else if (c == PD_GAME)
+		{
+			r[0][0] = v[2]; r[0][1] = v[0]; r[1][0] = v[3]; r[1][1] = v[1];
+			s[0][0] = w[2]; s[0][1] = w[3]; s[1][0] = w[0]; s[1][1] = w[1];
+		}
+		else if (c == PC_GAME)
+		{
+			maybeSwap(draws, v[0], v[1]);
+			maybeSwap(draws, w[0], w[1]);
+			r[0][0] = r[1][1] = v[2]; r[0][1] = v[0]; r[1][0] = v[1];
+			s[0][0] = s[1][1] = w[2]; s[0][1] = w[0]; s[1][0] = w[1];
+		}
+		else if (c == BOS_GAME)
+		{
+			// P_1 prefers (0,0) and P_2 (1,1), or the other way around
+			maybeSwap(draws, v[0], v[1]);
+			maybeSwap(draws, w[0], w[1]);
+			bool first = draws.uniformInteger(0, 1);
+			r[0][0] = first ? v[3] : v[2]; r[1][1] = first ? v[2] : v[3]; r[0][1] = v[0]; r[1][0] = v[1];
+			s[0][0] = first ? w[2] : w[3]; s[1][1] = first ? w[3] : w[2]; s[0][1] = w[0]; s[1][0] = w[1];
+		}
+		else if (c == CHICKEN_GAME)
+		{
+			r[0][0] = v[0]; r[0][1] = v[3]; r[1][0] = v[1]; r[1][1] = v[2];
+			s[0][0] = w[0]; s[0][1] = w[1]; s[1][0] = w[3]; s[1][1] = w[2];
+		}
+		else
+		{
+			r[0][0] = v[2]; r[0][1] = v[0]; r[1][0] = r[1][1] = v[1];
+			s[0][0] = w[2]; s[0][1] = s[1][1] = w[1]; s[1][0] = w[0];
+		}
+
+		for (int i = 0; i < 2; i++)
+			for (int j = 0; j < 2; j++)
+			{
+				p[(i * 2 + j) * 2] = (T)r[i][j];
+				p[(i * 2 + j) * 2 + 1] = (T)s[i][j];
+			}
+	}
+
+	rationalities.assign(nP, 0);
+	for (int x = 0; options.randomRationalities && x < nP; x++)
+		rationalities.at(x) = draws.uniformInteger(0, options.maxRationality);
+}
+
+/// @brief draws games first to first + count - 1 of class c into tensors and rationalities
+/// @param tensors count of them
+/// @param rationalities count of them
+/// @param c
+/// @param options checked by checkClassOptions()
+/// @param seed
+/// @param first
+/// @param count
+template <typename T>
+void randomClassGames(PayoffTensor<T>* tensors, vector<int>* rationalities, GameClass c, const RandGameOptions &options,
+	unsigned long long seed, uint64_t first, uint64_t count)
+{
+	for (uint64_t u = 0; u < count; u++)
+		randomClassGame(tensors[u], rationalities[u], c, options, seed, first + u);
+}
+
+/// @brief writes count random games of class c to a corpus, drawn by options.numThreads threads
+/// a piece at a time; the corpus is the same for any number of threads
+/// @param filename replaced if it exists
+/// @param c
+/// @param count
+/// @param options
+/// @return the first problem with options or the file
+template <typename T>
+GameStatus writeClassCorpus(const string &filename, GameClass c, uint64_t count, const RandGameOptions &options)
+{
+	GameStatus status = checkClassOptions(c, options);
+	if (!status.ok)
+		return status;
+	unsigned long long seed = randomSeed(options);
+
+	CorpusWriter writer;
+	status = writer.open(filename);
+	const uint64_t piece = 4096;
+	vector<PayoffTensor<T> > tensors = vector<PayoffTensor<T> >(min(piece, count));
+	vector<vector<int> > rationalities = vector<vector<int> >(tensors.size());
+	uint64_t numThreads = options.numThreads > 0 ? options.numThreads : thread::hardware_concurrency();
+	numThreads = max((uint64_t)1, min(numThreads, (uint64_t)tensors.size() / 256 + 1));
+
+	for (uint64_t first = 0; status.ok && first < count; first += piece)
+	{
+		uint64_t n = min(piece, count - first);
+		vector<thread> threads;
+		for (uint64_t t = 1; t < numThreads; t++)
+		{
+			uint64_t begin = n * t / numThreads, end = n * (t + 1) / numThreads;
+			threads.push_back(thread(randomClassGames<T>, &tensors[begin], &rationalities[begin], c, cref(options), seed,
+				first + begin, end - begin));
+		}
+		randomClassGames(&tensors[0], &rationalities[0], c, options, seed, first, n / numThreads);
+		for (int t = 0; (unsigned)t < threads.size(); t++)
+			threads.at(t).join();
+
+		for (uint64_t u = 0; status.ok && u < n; u++)
+			status = writer.add(tensors[u], rationalities[u]);
+	}
+	if (status.ok)
+		status = writer.close();
+	return status;
+}
+
+#endif
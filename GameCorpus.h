@@ -0,0 +1,349 @@
+/*******************************
+Title: GameCorpus.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: many binary games in one file with an index for random access
+********************************/
+
+#ifndef GAMECORPUS_H
+#define GAMECORPUS_H
+#include "BinaryGame.h"
+#include "GambitFormat.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+layout, in the writer's byte order:
+	GameCorpusHeader 			64 bytes
+	games 						each a binary game (see BinaryGame.h), starting
+								at a multiple of 64 and padded with zeros
+	index 						numGames uint64_t offsets, then numGames
+								uint64_t sizes, at a multiple of 64
+The header is written last, so a corpus whose writer never finished has no
+magic and is rejected.
+******************************************************************************/
+const char GAME_CORPUS_MAGIC[8] = { 'G', 'T', 'C', 'O', 'R', 'P', 'U', 'S' };
+const uint32_t GAME_CORPUS_VERSION = 1;
+
+struct GameCorpusHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t numGames;
+	uint64_t indexOffset;
+	uint64_t indexChecksum;
+	uint64_t reserved[3];
+};
+static_assert(sizeof(GameCorpusHeader) == 64, "GameCorpusHeader must stay 64 bytes");
+
+/******************************************************************************
+a mapped corpus; game(k) checks the kth game's header and views it in place,
+so any game is reached in constant time and threads can share one corpus
+******************************************************************************/
+class GameCorpus
+{
+	private:
+		MappedFile file;
+		const GameCorpusHeader* header;
+		const uint64_t* offsets;
+		const uint64_t* sizes;
+		string name;
+
+		GameStatus fail(const string &);
+	public:
+		GameCorpus() { header = NULL; offsets = NULL; sizes = NULL; }
+
+		const string& getName() const 	{ return name; }
+		size_t getNumGames() const 		{ return header ? header->numGames : 0; }
+
+		void close();
+		GameStatus game(size_t, BinaryGame &, bool = false) const;
+		void getShard(int, int, size_t &, size_t &) const;
+		GameStatus open(const string &);
+};
+
+// unmaps the corpus
+void GameCorpus::close()
+{
+	file.close();
+	header = NULL;
+	offsets = NULL;
+	sizes = NULL;
+	name.clear();
+}
+
+// closes the corpus and returns the error
+GameStatus GameCorpus::fail(const string &error)
+{
+	close();
+	return GameStatus(error);
+}
+
+/// @brief views game k without copying it
+/// @param k from 0 to getNumGames() - 1
+/// @param g valid until the corpus is closed
+/// @param verifyPayoffs also checks the game's payoff checksum
+/// @return an error if k is out of range or the game is damaged
+GameStatus GameCorpus::game(size_t k, BinaryGame &g, bool verifyPayoffs) const
+{
+	if (k >= getNumGames())
+		return GameStatus(name + " has no game " + to_string(k));
+	return g.attach(file.begin() + offsets[k], sizes[k], name + "#" + to_string(k), verifyPayoffs);
+}
+
+/// @brief the games in shard s when the corpus is split into numShards nearly equal, contiguous pieces
+/// @param s from 0 to numShards - 1
+/// @param numShards
+/// @param first receives the first game in the shard
+/// @param last receives one past the last game in the shard
+void GameCorpus::getShard(int s, int numShards, size_t &first, size_t &last) const
+{
+	uint64_t n = getNumGames();
+	first = n * s / numShards;
+	last = n * (s + 1) / numShards;
+}
+
+/// @brief maps filename and checks its header and index
+/// @param filename
+/// @return the first problem found
+GameStatus GameCorpus::open(const string &filename)
+{
+	close();
+	if (!file.open(filename))
+		return GameStatus("could not open " + filename);
+
+	if (file.size() < sizeof(GameCorpusHeader) || memcmp(file.begin(), GAME_CORPUS_MAGIC, sizeof(GAME_CORPUS_MAGIC)) != 0)
+		return fail(filename + " is not a finished game corpus");
+	header = reinterpret_cast<const GameCorpusHeader*>(file.begin());
+	if (header->byteOrder != BINARY_GAME_BYTE_ORDER)
+		return fail(filename + " was written on a machine with a different byte order");
+	if (header->version != GAME_CORPUS_VERSION)
+		return fail(filename + " has version " + to_string(header->version) + ", but only version " + to_string(GAME_CORPUS_VERSION) + " can be read");
+
+	uint64_t numGames = header->numGames;
+	if (header->indexOffset % BINARY_GAME_ALIGNMENT != 0 || header->indexOffset < sizeof(GameCorpusHeader) || header->indexOffset > file.size()
+		|| (file.size() - header->indexOffset) / (2 * sizeof(uint64_t)) != numGames || (file.size() - header->indexOffset) % (2 * sizeof(uint64_t)) != 0)
+		return fail(filename + " has a damaged header");
+
+	offsets = reinterpret_cast<const uint64_t*>(file.begin() + header->indexOffset);
+	sizes = offsets + numGames;
+	if (binaryChecksum(offsets, 2 * numGames * sizeof(uint64_t)) != header->indexChecksum)
+		return fail(filename + "'s index does not match its checksum");
+
+	// games must lie between the header and the index, in order, without overlapping
+	uint64_t end = sizeof(GameCorpusHeader);
+	for (uint64_t k = 0; k < numGames; k++)
+	{
+		if (offsets[k] < end || offsets[k] % BINARY_GAME_ALIGNMENT != 0 || sizes[k] > header->indexOffset - offsets[k])
+			return fail(filename + "'s index is damaged at game " + to_string(k));
+		end = offsets[k] + sizes[k];
+	}
+
+	name = filename;
+	return GameStatus();
+}
+
+/******************************************************************************
+writes a corpus one game at a time; close() adds the index and header, so
+memory use is 16 bytes per game however large the corpus grows. A corpus
+that isn't closed, e.g., because adding a game failed, is removed when the
+writer is destroyed or reopened, so no partial corpus is left behind
+******************************************************************************/
+class CorpusWriter
+{
+	private:
+		ofstream outfile;
+		string name;
+		vector<uint64_t> offsets;
+		vector<uint64_t> sizes;
+		uint64_t position;
+
+		CorpusWriter(const CorpusWriter &) = delete;
+		CorpusWriter& operator=(const CorpusWriter &) = delete;
+
+		void pad();
+	public:
+		CorpusWriter() { position = 0; }
+		~CorpusWriter() { abandon(); }
+
+		size_t getNumGames() const { return offsets.size(); } // games added since open()
+
+		void abandon();
+		template <typename T> GameStatus add(const PayoffTensor<T> &, const vector<int> &);
+		GameStatus addFile(const string &);
+		GameStatus close();
+		GameStatus open(const string &);
+};
+
+// closes the corpus without finishing it and removes the file, if one is open
+void CorpusWriter::abandon()
+{
+	if (!outfile.is_open())
+		return;
+	outfile.close();
+	remove(name.c_str());
+}
+
+/// @brief appends a game
+/// @param payoffs
+/// @param rationalities one per player, from 0 to MAX_RATIONALITY
+/// @return an error if the game can't be saved or written
+template <typename T>
+GameStatus CorpusWriter::add(const PayoffTensor<T> &payoffs, const vector<int> &rationalities)
+{
+	if (!outfile.is_open())
+		return GameStatus("no corpus is open");
+
+	GameStatus status = writeBinaryGame(outfile, payoffs, rationalities);
+	if (!status.ok)
+		return status;
+	uint64_t end = outfile.tellp();
+	if (!outfile)
+		return GameStatus("could not write " + name);
+
+	offsets.push_back(position);
+	sizes.push_back(end - position);
+	position = end;
+	pad();
+	return GameStatus();
+}
+
+/// @brief appends every game in a text file (games back to back), binary game, .nfg file, or corpus
+/// @param filename
+/// @return the first problem found; games before it have been added
+GameStatus CorpusWriter::addFile(const string &filename)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return GameStatus("could not open " + filename);
+	GameStatus status;
+
+	if (file.size() >= sizeof(GAME_CORPUS_MAGIC) && memcmp(file.begin(), GAME_CORPUS_MAGIC, sizeof(GAME_CORPUS_MAGIC)) == 0)
+	{
+		GameCorpus corpus;
+		status = corpus.open(filename);
+		for (size_t k = 0; status.ok && k < corpus.getNumGames(); k++)
+		{
+			BinaryGame g;
+			PayoffTensor<int> payoffs;
+			status = corpus.game(k, g, true);
+			if (status.ok)
+				status = g.payoffs(payoffs);
+			if (status.ok)
+				status = add(payoffs, g.getRationalities());
+		}
+		return status;
+	}
+
+	if (file.size() >= sizeof(BINARY_GAME_MAGIC) && memcmp(file.begin(), BINARY_GAME_MAGIC, sizeof(BINARY_GAME_MAGIC)) == 0)
+	{
+		BinaryGame g;
+		PayoffTensor<int> payoffs;
+		status = g.attach(file.begin(), file.size(), filename, true);
+		if (status.ok)
+			status = g.payoffs(payoffs);
+		if (status.ok)
+			status = add(payoffs, g.getRationalities());
+		return status;
+	}
+
+	if (file.size() >= 3 && memcmp(file.begin(), "NFG", 3) == 0)
+	{
+		PayoffTensor<int> payoffs;
+		status = parseNfg(file.begin(), file.end(), filename, payoffs);
+		if (status.ok)
+			status = add(payoffs, vector<int>(payoffs.getNumPlayers(), 0));
+		return status;
+	}
+
+	PayoffScanner scanner(file.begin(), file.end());
+	for (int n = 1; status.ok && !scanner.atEnd(); n++)
+	{
+		PayoffTensor<int> payoffs;
+		vector<int> rationalities;
+		status = parseNextGame(scanner, filename + " (game " + to_string(n) + ")", payoffs, rationalities);
+		if (status.ok)
+			status = add(payoffs, rationalities);
+	}
+	return status;
+}
+
+/// @brief writes the index and header and closes the file
+/// @return an error if they couldn't be written
+GameStatus CorpusWriter::close()
+{
+	if (!outfile.is_open())
+		return GameStatus("no corpus is open");
+
+	GameCorpusHeader header;
+	memset(&header, 0, sizeof(header));
+	header.version = GAME_CORPUS_VERSION;
+	header.byteOrder = BINARY_GAME_BYTE_ORDER;
+	header.numGames = offsets.size();
+	header.indexOffset = position;
+
+	uint64_t checksum = binaryChecksum(offsets.data(), offsets.size() * sizeof(uint64_t));
+	header.indexChecksum = binaryChecksum(sizes.data(), sizes.size() * sizeof(uint64_t), checksum);
+	outfile.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+	outfile.write(reinterpret_cast<const char*>(sizes.data()), sizes.size() * sizeof(uint64_t));
+
+	// the magic goes in last
+	outfile.seekp(0);
+	outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	outfile.seekp(0);
+	outfile.write(GAME_CORPUS_MAGIC, sizeof(GAME_CORPUS_MAGIC));
+	if (outfile.fail())
+	{
+		abandon();
+		return GameStatus("could not write " + name);
+	}
+	outfile.close();
+	return GameStatus();
+}
+
+/// @brief creates filename, replacing any file already there; a corpus still open is abandoned
+/// @param filename
+/// @return an error if it can't be created
+GameStatus CorpusWriter::open(const string &filename)
+{
+	abandon();
+	offsets.clear();
+	sizes.clear();
+	name = filename;
+
+	outfile.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+
+	// the header is a placeholder until close()
+	char zeros[sizeof(GameCorpusHeader)] = {};
+	outfile.write(zeros, sizeof(zeros));
+	position = sizeof(zeros);
+	return GameStatus();
+}
+
+// zeros up to the next multiple of 64
+void CorpusWriter::pad()
+{
+	char zeros[BINARY_GAME_ALIGNMENT] = {};
+	size_t padding = (BINARY_GAME_ALIGNMENT - position % BINARY_GAME_ALIGNMENT) % BINARY_GAME_ALIGNMENT;
+	outfile.write(zeros, padding);
+	position += padding;
+}
+
+// true if the file starts with the corpus magic
+inline bool isGameCorpus(const string &filename)
+{
+	char magic[sizeof(GAME_CORPUS_MAGIC)];
+	ifstream infile(filename.c_str(), ios::in | ios::binary);
+	return infile.read(magic, sizeof(magic)) && memcmp(magic, GAME_CORPUS_MAGIC, sizeof(magic)) == 0;
+}
+
+#endif
@@ -0,0 +1,344 @@
+/*******************************
+Title: GameReader.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: reads game files straight into a PayoffTensor
+********************************/
+
+#ifndef GAMEREADER_H
+#define GAMEREADER_H
+#include "GameResults.h"
+#include "PayoffTensor.h"
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+/******************************************************************************
+a file's contents in memory: mapped read-only where the platform allows it,
+otherwise read into a buffer. The contents are not NUL-terminated.
+******************************************************************************/
+class MappedFile
+{
+	private:
+		const char* contents;
+		size_t length;
+		bool mapped;
+		vector<char> buffer; // used when the file isn't mapped
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile& operator=(const MappedFile &) = delete;
+	public:
+		MappedFile() { contents = NULL; length = 0; mapped = false; }
+		~MappedFile() { close(); }
+
+		const char* begin() const 	{ return contents; }
+		const char* end() const 	{ return contents + length; }
+		bool isMapped() const 		{ return mapped; }
+		size_t size() const 		{ return length; }
+
+		void close();
+		bool open(const string &);
+};
+
+// unmaps or frees the contents
+void MappedFile::close()
+{
+#ifndef _WIN32
+	if (mapped)
+		munmap(const_cast<char*>(contents), length);
+#endif
+	contents = NULL;
+	length = 0;
+	mapped = false;
+	buffer.clear();
+}
+
+/// @brief maps filename, or reads it if it can't be mapped
+/// @param filename
+/// @return false if the file can't be opened
+bool MappedFile::open(const string &filename)
+{
+	close();
+#ifndef _WIN32
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+	{
+		void* address = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address != MAP_FAILED)
+		{
+			madvise(address, info.st_size, MADV_SEQUENTIAL);
+			::close(fd);
+			contents = static_cast<const char*>(address);
+			length = info.st_size;
+			mapped = true;
+			return true;
+		}
+	}
+	::close(fd);
+#endif
+
+	// empty files, pipes, and platforms without mmap
+	ifstream infile(filename.c_str(), ios::in | ios::binary);
+	if (!infile)
+		return false;
+	buffer.assign(istreambuf_iterator<char>(infile), istreambuf_iterator<char>());
+	contents = buffer.empty() ? NULL : &buffer[0];
+	length = buffer.size();
+	return true;
+}
+
+// "line l, column c" of pos in the text starting at first, for error messages
+inline string describeTextPosition(const char* first, const char* pos)
+{
+	int line = 1;
+	const char* lineStart = first;
+	for (const char* p = first; p < pos; p++)
+	{
+		if (*p == '\n')
+		{
+			line++;
+			lineStart = p + 1;
+		}
+	}
+	return "line " + to_string(line) + ", column " + to_string(pos - lineStart + 1);
+}
+
+/******************************************************************************
+reads signed integers separated by whitespace and/or commas, e.g., "1,2 0,0".
+Characters are classified with a table and digits are accumulated without
+per-character range checks, so the loop is a handful of instructions a digit.
+******************************************************************************/
+class PayoffScanner
+{
+	private:
+		enum CharClass { OTHER, SEPARATOR, DIGIT, SIGN };
+
+		const char* first;
+		const char* pos;
+		const char* last;
+
+		static const unsigned char* classes();
+		void skipSeparators();
+	public:
+		PayoffScanner(const char* f, const char* l) { first = f; pos = f; last = l; }
+
+		size_t getOffset() const { return pos - first; }
+		size_t remaining() const { return last - pos; }
+
+		bool atEnd();
+		string describePosition() const;
+		bool next(long long &);
+		template <typename T> size_t read(T*, size_t);
+};
+
+// character classes; a function-local static is built once even with several threads reading
+const unsigned char* PayoffScanner::classes()
+{
+	struct Table
+	{
+		unsigned char c[256];
+
+		Table()
+		{
+			memset(c, OTHER, sizeof(c));
+			c[(unsigned char)' '] = c[(unsigned char)'\t'] = c[(unsigned char)'\n'] = SEPARATOR;
+			c[(unsigned char)'\r'] = c[(unsigned char)'\v'] = c[(unsigned char)'\f'] = c[(unsigned char)','] = SEPARATOR;
+			for (int d = '0'; d <= '9'; d++)
+				c[d] = DIGIT;
+			c[(unsigned char)'-'] = c[(unsigned char)'+'] = SIGN;
+		}
+	};
+	static const Table table;
+	return table.c;
+}
+
+// true if only separators are left
+bool PayoffScanner::atEnd()
+{
+	skipSeparators();
+	return pos == last;
+}
+
+// "line l, column c" of the current position, for error messages
+string PayoffScanner::describePosition() const
+{
+	return describeTextPosition(first, pos);
+}
+
+/// @brief reads the next integer
+/// @param value
+/// @return false at the end of the input, on a character that isn't part of a number, or on overflow; pos is left at the problem
+bool PayoffScanner::next(long long &value)
+{
+	skipSeparators();
+	if (pos == last)
+		return false;
+
+	const unsigned char* table = classes();
+	const char* p = pos;
+	bool negative = false;
+	if (table[(unsigned char)*p] == SIGN)
+	{
+		negative = *p == '-';
+		p++;
+	}
+
+	// at most 18 digits can't overflow a long long
+	const char* digitsEnd = last - p > 18 ? p + 18 : last;
+	const char* digitsStart = p;
+	unsigned long long v = 0;
+	unsigned d;
+	while (p < digitsEnd && (d = (unsigned char)(*p - '0')) < 10)
+	{
+		v = v * 10 + d;
+		p++;
+	}
+
+	// no digits, too many digits, or something like "12x"
+	if (p == digitsStart || (p < last && table[(unsigned char)*p] != SEPARATOR))
+		return false;
+
+	value = negative ? -(long long)v : (long long)v;
+	pos = p;
+	return true;
+}
+
+/// @brief reads up to count integers into out, stopping early at the end or at anything that isn't a T
+/// @return the number read
+template <typename T>
+size_t PayoffScanner::read(T* out, size_t count)
+{
+	long long value;
+	for (size_t n = 0; n < count; n++)
+	{
+		const char* start = pos;
+		if (!next(value))
+			return n;
+		if (numeric_limits<T>::is_integer && (value < (long long)numeric_limits<T>::min() || value > (long long)numeric_limits<T>::max()))
+		{
+			pos = start;
+			skipSeparators();
+			return n;
+		}
+		out[n] = static_cast<T>(value);
+	}
+	return count;
+}
+
+// moves past whitespace and commas
+void PayoffScanner::skipSeparators()
+{
+	const unsigned char* table = classes();
+	while (pos < last && table[(unsigned char)*pos] == SEPARATOR)
+		pos++;
+}
+
+/// @brief parses the next game in the format of simGame::writeToFile(), so games can be read back to back
+/// @param scanner left just after the game's last payoff
+/// @param name the file's name, for error messages
+/// @param payoffs receives the numbers of strategies and the payoffs
+/// @param rationalities receives one rationality per player
+/// @return the first problem found; payoffs and rationalities are unchanged on failure
+template <typename T>
+GameStatus parseNextGame(PayoffScanner &scanner, const string &name, PayoffTensor<T> &payoffs, vector<int> &rationalities)
+{
+	long long value = 0;
+
+	if (!scanner.next(value) || value < 2 || value > INT_MAX)
+		return GameStatus(name + " does not start with a number of players of at least 2");
+	int nP = value;
+
+	// each player needs at least one more character, so a bogus count fails here instead of allocating
+	if ((size_t)nP > scanner.remaining())
+		return GameStatus(name + " ends before its " + to_string(nP) + " players' numbers of strategies");
+
+	vector<int> numStrats = vector<int>(nP), r = vector<int>(nP);
+	for (int x = 0; x < nP; x++)
+	{
+		if (!scanner.next(value) || value < 1 || value > INT_MAX)
+			return GameStatus("could not read P_" + to_string(x + 1) + "'s number of strategies from " + name + " (" + scanner.describePosition() + ")");
+		numStrats.at(x) = value;
+	}
+	for (int x = 0; x < nP; x++)
+	{
+		if (!scanner.next(value) || value < 0 || value > MAX_RATIONALITY)
+			return GameStatus("could not read P_" + to_string(x + 1) + "'s rationality from " + name + " (" + scanner.describePosition() + ")");
+		r.at(x) = value;
+	}
+
+	// the dimensions are checked against the file before anything is allocated
+	size_t size = nP;
+	for (int x = 0; x < nP; x++)
+	{
+		if (size > (size_t)INT_MAX / numStrats.at(x))
+			return GameStatus(name + " has too many outcomes");
+		size *= numStrats.at(x);
+	}
+	if (size > (scanner.remaining() + 1) / 2)
+		return GameStatus(name + " is too short to hold the " + to_string(size) + " payoffs its dimensions need");
+
+	PayoffTensor<T> tensor(numStrats);
+	size_t numRead = scanner.read(tensor.mutableData(), size);
+	if (numRead < size)
+	{
+		if (scanner.atEnd())
+			return GameStatus(name + " has " + to_string(numRead) + " payoffs, but " + to_string(size) + " are needed");
+		return GameStatus("could not read payoff " + to_string(numRead + 1) + " from " + name + " (" + scanner.describePosition() + ")");
+	}
+
+	payoffs.swap(tensor);
+	rationalities.swap(r);
+	return GameStatus();
+}
+
+/// @brief parses a file's text holding exactly one game
+/// @param first start of the text
+/// @param last end of the text
+/// @param name the file's name, for error messages
+/// @param payoffs receives the numbers of strategies and the payoffs
+/// @param rationalities receives one rationality per player
+/// @return the first problem found; payoffs and rationalities are unchanged on failure
+template <typename T>
+GameStatus parseGame(const char* first, const char* last, const string &name, PayoffTensor<T> &payoffs, vector<int> &rationalities)
+{
+	PayoffScanner scanner(first, last);
+	PayoffTensor<T> tensor;
+	vector<int> r;
+	GameStatus status = parseNextGame(scanner, name, tensor, r);
+	if (!status.ok)
+		return status;
+	if (!scanner.atEnd())
+		return GameStatus(name + " has more than the " + to_string(tensor.size()) + " payoffs its dimensions need (" + scanner.describePosition() + ")");
+
+	payoffs.swap(tensor);
+	rationalities.swap(r);
+	return GameStatus();
+}
+
+/// @brief maps filename and parses it with parseGame()
+/// @return the first problem found; payoffs and rationalities are unchanged on failure
+template <typename T>
+GameStatus readGame(const string &filename, PayoffTensor<T> &payoffs, vector<int> &rationalities)
+{
+	MappedFile file;
+	if (!file.open(filename))
+		return GameStatus("could not open " + filename);
+	return parseGame(file.begin(), file.end(), filename, payoffs, rationalities);
+}
+
+#endif
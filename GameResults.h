@@ -0,0 +1,269 @@
+/*******************************
+Title: GameResults.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: parameters and results for simGame's non-interactive functions
+********************************/
+
+#ifndef GAMERESULTS_H
+#define GAMERESULTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// the highest level of rationality a player can have; levels' strategies are computed to any depth (see KLevelEngine.h)
+const int MAX_RATIONALITY = 100;
+
+// success, or the reason for failure
+struct GameStatus
+{
+	bool ok;
+	string error;
+
+	GameStatus() 			{ ok = true; }
+	GameStatus(string e) 	{ ok = false; error = e; }
+};
+
+// how random payoffs are drawn; see RandomPayoffs.h
+enum PayoffDistribution
+{
+	UNIFORM_PAYOFFS, 	// each from minPayoff to maxPayoff
+	NORMAL_PAYOFFS, 	// each normal with mean and standardDeviation
+	COVARIANT_PAYOFFS 	// normal, with the players' payoffs in an outcome correlated by covariance
+};
+
+// parameters for simGame::randomize() and the functions in RandomPayoffs.h
+struct RandGameOptions
+{
+	vector<int> numStrats; // one entry per player
+	PayoffDistribution distribution;
+	int minPayoff;
+	int maxPayoff;
+	double mean;
+	double standardDeviation;
+	double covariance; // from -1 / (numPlayers - 1) to 1; the payoffs' correlation, as their variance is 1 before scaling
+	bool randomRationalities; // otherwise existing rationalities are kept, new players are L_0
+	int maxRationality; // random rationalities are uniform from L_0 to this level, at most MAX_RATIONALITY
+	unsigned long long seed; // 0 seeds from the clock
+	unsigned stream; // games with the same seed and different streams are independent
+	int numThreads; // 0 uses one thread per hardware thread
+
+	RandGameOptions()
+	{
+		distribution = UNIFORM_PAYOFFS;
+		minPayoff = 0;
+		maxPayoff = 99;
+		mean = 0.0;
+		standardDeviation = 1.0;
+		covariance = 0.0;
+		randomRationalities = true;
+		maxRationality = 3;
+		seed = 0;
+		stream = 0;
+		numThreads = 1;
+	}
+};
+
+// a strategy profile with its payoffs
+template <typename T>
+struct OutcomeReport
+{
+	vector<int> profile; // strategies are numbered from 0
+	vector<T> payoffs;
+	bool paretoOptimal;
+
+	OutcomeReport() { paretoOptimal = false; }
+};
+
+// outcomes when players learn each other's choices
+template <typename T>
+struct CommunicationResult
+{
+	GameStatus status;
+	bool undecided; // zero-sum games have no original outcome
+	OutcomeReport<T> original; // nobody knows the others' choices
+	vector<OutcomeReport<T> > oneKnows; // oneKnows.at(x): only P_x knows the others' choices
+	OutcomeReport<T> allKnow; // every player knows the others' choices
+	OutcomeReport<T> commonKnowledge; // every player also knows that the others know
+
+	CommunicationResult() { undecided = false; }
+};
+
+// the levels players reason to given what they know of each other's rationality
+template <typename T>
+struct EpistemicLevelResult
+{
+	GameStatus status;
+	vector<int> levels; // one per player
+	OutcomeReport<T> outcome; // each player playing their level's strategy
+};
+
+// the k-rationalizability model
+template <typename T>
+struct KMatrixResult
+{
+	GameStatus status;
+	vector<double> levelProbabilities; // P(L_0), ..., P(L_K)
+	vector<vector<int> > kStrategies; // kStrategies.at(r).at(x) is P_x's strategy at level r, for r up to K
+	vector<vector<int> > outcomes;
+	vector<double> outcomeProbabilities; // one per outcome
+	vector<int> choices; // each player's strategy at their own rationality
+	string undecided; // why there is no outcome, e.g., "zero-sum games"; empty if there is one
+	OutcomeReport<T> outcome;
+	vector<double> expectedUtilities; // one per player
+};
+
+// the cognitive hierarchy model; see CognitiveHierarchy.h
+struct CognitiveHierarchyResult
+{
+	GameStatus status;
+	vector<double> levelProbabilities; // P(L_0), ..., P(L_K), summing to 1
+	vector<vector<vector<double> > > levelStrategies; // levelStrategies.at(k).at(x).at(s) is the probability P_x plays s at level k
+	vector<vector<double> > prediction; // prediction.at(x).at(s): the probability P_x plays s, their level unknown
+	vector<double> expectedUtilities; // one per player, everyone playing prediction
+};
+
+// level probabilities fitted to observed choices; see Estimation.h
+struct LevelFitResult
+{
+	GameStatus status;
+	vector<double> levelProbabilities; // P(L_0), ..., P(L_K), as computeKMatrix() takes them
+	double errorRate; // probability a choice is uniformly random rather than the chooser's level's
+	double logLikelihood;
+	int iterations;
+
+	LevelFitResult() { errorRate = 0.0; logLikelihood = 0.0; iterations = 0; }
+};
+
+// the logit QRE precision fitted to observed choices; see Estimation.h
+struct QREFitResult
+{
+	GameStatus status;
+	double precision; // lambda
+	double logLikelihood;
+	int iterations;
+
+	QREFitResult() { precision = 0.0; logLikelihood = 0.0; iterations = 0; }
+};
+
+// the principal branch of logit QREs and the Nash equilibrium it approaches; see QuantalResponse.h
+struct QREPathResult
+{
+	GameStatus status;
+	vector<double> lambdas; // the points found along the branch, from lambda = 0
+	vector<vector<vector<double> > > profiles; // profiles.at(n) is the QRE at lambdas.at(n)
+	int numTurningPoints; // where the branch bends back to lower lambda
+	vector<vector<double> > equilibrium;
+	double regret; // the most any player gains by deviating from equilibrium
+
+	QREPathResult() { numTurningPoints = 0; regret = 0.0; }
+};
+
+/******************************************************************************
+a 2-player game's mixed equilibria by support enumeration, which tries
+supports of equal size, as every equilibrium of a nondegenerate game has;
+a degenerate game can also have equilibria whose supports differ in size,
+even infinitely many, and those are missed. degenerate is set when the
+enumeration sees the game is degenerate: a pure strategy with more than
+one best response, or an equilibrium at which a player has more pure
+best responses than the supports have strategies
+******************************************************************************/
+template <typename S>
+struct SupportEnumerationResult
+{
+	GameStatus status;
+	vector<vector<vector<S> > > equilibria; // equilibria.at(e).at(x).at(s) is the probability P_x plays s
+	bool degenerate;
+
+	SupportEnumerationResult() { degenerate = false; }
+};
+
+// outcomes when sets of players reveal their choices to everyone
+template <typename T>
+struct RevelationResult
+{
+	GameStatus status;
+	bool undecided; // zero-sum games have no original outcome
+	OutcomeReport<T> original; // nobody reveals
+	vector<vector<int> > revealing; // revealing.at(n) is the players who reveal in scenario n, numbered from 0
+	vector<OutcomeReport<T> > responses; // every player who learns a choice responds to it
+	vector<OutcomeReport<T> > anticipated; // players also anticipate the revealers' responses
+
+	RevelationResult() { undecided = false; }
+};
+
+// how simulatePopulations() draws populations; see MonteCarlo.h
+struct SimulationOptions
+{
+	unsigned long long numPopulations;
+	int populationSize; // players in each role, matched into this many games
+	vector<double> levelProbabilities; // P(L_0), ..., P(L_K), the rest going to L_K+1 as in computeKMatrix()
+	double errorRate; // probability a player chooses uniformly at random instead of by their level
+	int numBins; // in each payoff histogram, which sets the quantiles' resolution
+	unsigned long long seed; // 0 seeds from the clock
+	int numThreads; // 0 uses one thread per hardware thread
+
+	SimulationOptions()
+	{
+		numPopulations = 100000;
+		populationSize = 100;
+		levelProbabilities = vector<double>(3, 0.25);
+		errorRate = 0.0;
+		numBins = 1000;
+		seed = 0;
+		numThreads = 0;
+	}
+};
+
+// what simulated populations played and earned; see MonteCarlo.h
+struct SimulationResult
+{
+	GameStatus status;
+	unsigned long long seed; // the one used, to repeat a run seeded from the clock
+	vector<vector<int> > outcomes; // those played, in PayoffTensor order
+	vector<double> outcomeFrequencies; // share of all the games played
+	// each player's average payoff in a population, over the populations
+	vector<double> meanPayoffs;
+	vector<double> payoffVariances;
+	vector<double> minPayoffs;
+	vector<double> maxPayoffs;
+	vector<vector<double> > payoffQuantiles; // payoffQuantiles.at(x).at(q) at SIMULATION_QUANTILES[q]
+
+	SimulationResult() { seed = 0; }
+};
+
+// a subgame-perfect equilibrium of a game tree; see BackwardInduction.h
+template <typename T>
+struct SubgamePerfectResult
+{
+	GameStatus status;
+	vector<uint16_t> actions; // the mover's action at each node, NO_ACTION at terminal nodes
+	vector<uint32_t> outcomes; // the terminal node play reaches from each node
+	vector<int> path; // the actions from the root on the equilibrium path
+	vector<T> payoffs; // at the end of the path
+};
+
+// the part of the payoff matrices that simGame's print functions show
+struct PrintWindow
+{
+	int firstMatrix; // numbered from 0, like strategies
+	int firstRow;
+	int firstColumn;
+	int numMatrices; // at most this many are printed; 0 for all of them
+	int numRows;
+	int numColumns;
+
+	PrintWindow()
+	{
+		firstMatrix = 0;
+		firstRow = 0;
+		firstColumn = 0;
+		numMatrices = 64;
+		numRows = 50;
+		numColumns = 12;
+	}
+};
+
+#endif
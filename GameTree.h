@@ -0,0 +1,302 @@
+/*******************************
+Title: GameTree.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: extensive-form game trees with their nodes in flat arrays
+********************************/
+
+#ifndef GAMETREE_H
+#define GAMETREE_H
+#include "GameResults.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Nodes are numbered from 0, the root, and kept in parallel arrays rather
+than as objects: a node's parent, the first of its children, how many
+children it has, the player who moves there, and its information set. A
+node's children are always numbered consecutively, since expand() adds them
+together at the end, so child a of n is firstChild(n) + a, the action
+leading to n is n - firstChild(parent(n)), and every node is numbered after
+its parent, so a pass from the last node to the root visits children before
+parents. A terminal node's firstChild holds its leaf number instead, and
+its payoffs are leaf * numPlayers to leaf * numPlayers + numPlayers - 1 of
+one dense buffer. A node costs 16 bytes plus its payoffs, and nothing is
+allocated per node, so trees of tens of millions of nodes fit in memory.
+Information sets are numbered by the caller; NO_INFO_SET means a node is
+alone in its set, as in games of perfect information.
+******************************************************************************/
+
+const uint32_t NO_NODE = 0xFFFFFFFF;
+const int32_t NO_INFO_SET = -1;
+const uint16_t NO_ACTION = 0xFFFF; // no node has this many actions, so no action is numbered this
+const int16_t TERMINAL_PLAYER = -1; // the player at a terminal node, and at a node not yet expanded
+
+template <typename T>
+class GameTree
+{
+	private:
+		int numPlayers;
+		vector<uint32_t> parents;
+		vector<uint32_t> firstChildren; // the leaf number at terminal nodes
+		vector<uint16_t> numChildren;
+		vector<int16_t> players;
+		vector<int32_t> infoSets;
+		vector<T> payoffs; // leaf * numPlayers + x
+		uint32_t numLeaves;
+
+		uint32_t addNode(uint32_t);
+		GameStatus checkNode(uint32_t) const;
+	public:
+		GameTree(int nP = 2);
+
+		uint32_t getChild(uint32_t n, int a) const 		{ return firstChildren[n] + a; }
+		uint32_t getFirstChild(uint32_t n) const 		{ return firstChildren[n]; }
+		int32_t getInfoSet(uint32_t n) const 			{ return infoSets[n]; }
+		int getNumChildren(uint32_t n) const 			{ return numChildren[n]; }
+		uint32_t getNumLeaves() const 					{ return numLeaves; }
+		uint32_t getNumNodes() const 					{ return parents.size(); }
+		int getNumPlayers() const 						{ return numPlayers; }
+		uint32_t getParent(uint32_t n) const 			{ return parents[n]; }
+		T getPayoff(uint32_t n, int x) const 			{ return payoffs[(size_t)firstChildren[n] * numPlayers + x]; }
+		const T* getPayoffs(uint32_t n) const 			{ return &payoffs[(size_t)firstChildren[n] * numPlayers]; }
+		int getPlayer(uint32_t n) const 				{ return players[n]; }
+		bool isTerminal(uint32_t n) const 				{ return numChildren[n] == 0 && firstChildren[n] != NO_NODE; }
+
+		int action(uint32_t) const;
+		void clear();
+		int depth(uint32_t) const;
+		GameStatus expand(uint32_t, int, int, uint32_t &);
+		GameStatus growUniform(int, int);
+		int height() const;
+		vector<uint32_t> nodesPerLevel() const;
+		vector<int> path(uint32_t) const;
+		void reserve(size_t, size_t);
+		GameStatus setInfoSet(uint32_t, int32_t);
+		GameStatus setPayoffs(uint32_t, const vector<T> &);
+};
+
+/// @brief a tree of just the root, which is neither expanded nor terminal yet
+/// @param nP number of players
+template <typename T>
+GameTree<T>::GameTree(int nP)
+{
+	numPlayers = nP;
+	clear();
+}
+
+// the action that leads to node n, or -1 at the root
+template <typename T>
+int GameTree<T>::action(uint32_t n) const
+{
+	return n == 0 ? -1 : (int)(n - firstChildren[parents[n]]);
+}
+
+// appends a node with no children under parent
+template <typename T>
+uint32_t GameTree<T>::addNode(uint32_t parent)
+{
+	parents.push_back(parent);
+	firstChildren.push_back(NO_NODE);
+	numChildren.push_back(0);
+	players.push_back(TERMINAL_PLAYER);
+	infoSets.push_back(NO_INFO_SET);
+	return parents.size() - 1;
+}
+
+// fails unless n is a node
+template <typename T>
+GameStatus GameTree<T>::checkNode(uint32_t n) const
+{
+	if (n >= parents.size())
+		return GameStatus("node " + to_string(n) + " is not in the tree");
+	return GameStatus();
+}
+
+// leaves only the root
+template <typename T>
+void GameTree<T>::clear()
+{
+	parents.clear();
+	firstChildren.clear();
+	numChildren.clear();
+	players.clear();
+	infoSets.clear();
+	payoffs.clear();
+	numLeaves = 0;
+	addNode(NO_NODE);
+}
+
+// the number of moves from the root to node n
+template <typename T>
+int GameTree<T>::depth(uint32_t n) const
+{
+	int d = 0;
+	for (; n != 0; n = parents[n])
+		d++;
+	return d;
+}
+
+/// @brief makes node n a decision node of player x with numActions children
+/// @param n a node that's neither expanded nor terminal
+/// @param x
+/// @param numActions from 1 to 65535
+/// @param first receives the first child's number; the others follow it
+template <typename T>
+GameStatus GameTree<T>::expand(uint32_t n, int x, int numActions, uint32_t &first)
+{
+	GameStatus status = checkNode(n);
+	if (!status.ok)
+		return status;
+	if (numChildren[n] > 0 || firstChildren[n] != NO_NODE)
+		return GameStatus("node " + to_string(n) + " already has children or payoffs");
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("P_" + to_string(x + 1) + " is not in the game");
+	if (numActions < 1 || numActions > 0xFFFF)
+		return GameStatus("a node has from 1 to 65535 actions, not " + to_string(numActions));
+	if (parents.size() + numActions > NO_NODE)
+		return GameStatus("the tree can't have more than " + to_string(NO_NODE) + " nodes");
+
+	first = parents.size();
+	firstChildren[n] = first;
+	numChildren[n] = numActions;
+	players[n] = x;
+	for (int a = 0; a < numActions; a++)
+		addNode(n);
+	return status;
+}
+
+/// @brief replaces the tree with one in which every decision node has numActions children, P_(d % numPlayers + 1)
+/// moving at depth d, built a level at a time so each level's nodes are numbered consecutively; payoffs are 0
+/// @param depth the number of moves to every terminal node
+/// @param numActions
+template <typename T>
+GameStatus GameTree<T>::growUniform(int depth, int numActions)
+{
+	if (depth < 0)
+		return GameStatus("the depth is negative");
+	double numNodes = 1.0, levelSize = 1.0;
+	for (int d = 0; d < depth; d++)
+	{
+		levelSize *= numActions;
+		numNodes += levelSize;
+	}
+	if (numNodes >= NO_NODE)
+		return GameStatus("the tree would have more than " + to_string(NO_NODE) + " nodes");
+
+	clear();
+	reserve((size_t)numNodes, (size_t)levelSize);
+	uint32_t levelStart = 0, levelEnd = 1, first;
+	for (int d = 0; d < depth; d++)
+	{
+		for (uint32_t n = levelStart; n < levelEnd; n++)
+		{
+			GameStatus status = expand(n, d % numPlayers, numActions, first);
+			if (!status.ok)
+				return status;
+		}
+		levelStart = levelEnd;
+		levelEnd = parents.size();
+	}
+	vector<T> zeros = vector<T>(numPlayers, T());
+	for (uint32_t n = levelStart; n < levelEnd; n++)
+		setPayoffs(n, zeros);
+	return GameStatus();
+}
+
+// the most moves from the root to any node, found in one pass since nodes come after their parents
+template <typename T>
+int GameTree<T>::height() const
+{
+	vector<int> depths = vector<int>(parents.size(), 0);
+	int h = 0;
+	for (uint32_t n = 1; n < parents.size(); n++)
+	{
+		depths[n] = depths[parents[n]] + 1;
+		if (depths[n] > h)
+			h = depths[n];
+	}
+	return h;
+}
+
+// the number of nodes at each depth from 0 to height()
+template <typename T>
+vector<uint32_t> GameTree<T>::nodesPerLevel() const
+{
+	vector<int> depths = vector<int>(parents.size(), 0);
+	vector<uint32_t> counts = vector<uint32_t>(1, 1);
+	for (uint32_t n = 1; n < parents.size(); n++)
+	{
+		depths[n] = depths[parents[n]] + 1;
+		if ((unsigned)depths[n] == counts.size())
+			counts.push_back(0);
+		counts[depths[n]]++;
+	}
+	return counts;
+}
+
+// the actions from the root to node n
+template <typename T>
+vector<int> GameTree<T>::path(uint32_t n) const
+{
+	vector<int> actions = vector<int>(depth(n));
+	for (int d = actions.size() - 1; d >= 0; d--, n = parents[n])
+		actions.at(d) = action(n);
+	return actions;
+}
+
+// makes room for numNodes nodes and numLeaves leaves without reallocating
+template <typename T>
+void GameTree<T>::reserve(size_t numNodes, size_t numLeaves)
+{
+	parents.reserve(numNodes);
+	firstChildren.reserve(numNodes);
+	numChildren.reserve(numNodes);
+	players.reserve(numNodes);
+	infoSets.reserve(numNodes);
+	payoffs.reserve(numLeaves * numPlayers);
+}
+
+/// @brief puts node n in information set id; its nodes should belong to one player with the same number of actions
+/// @param n
+/// @param id from 0, or NO_INFO_SET for a node alone in its set
+template <typename T>
+GameStatus GameTree<T>::setInfoSet(uint32_t n, int32_t id)
+{
+	GameStatus status = checkNode(n);
+	if (!status.ok)
+		return status;
+	if (id < NO_INFO_SET)
+		return GameStatus("information set " + to_string(id) + " is negative");
+	infoSets[n] = id;
+	return status;
+}
+
+/// @brief makes node n terminal with the given payoffs, or replaces its payoffs if it already is
+/// @param n a node without children
+/// @param values one per player
+template <typename T>
+GameStatus GameTree<T>::setPayoffs(uint32_t n, const vector<T> &values)
+{
+	GameStatus status = checkNode(n);
+	if (!status.ok)
+		return status;
+	if (numChildren[n] > 0)
+		return GameStatus("node " + to_string(n) + " has children, so it can't have payoffs");
+	if (values.size() != (unsigned)numPlayers)
+		return GameStatus("expected " + to_string(numPlayers) + " payoffs, not " + to_string(values.size()));
+
+	if (firstChildren[n] == NO_NODE)
+	{
+		firstChildren[n] = numLeaves++;
+		payoffs.resize(payoffs.size() + numPlayers);
+	}
+	for (int x = 0; x < numPlayers; x++)
+		payoffs[(size_t)firstChildren[n] * numPlayers + x] = values.at(x);
+	return status;
+}
+
+#endif
@@ -0,0 +1,214 @@
+/*******************************
+Title: KLevelEngine.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: level-k strategies computed on demand to any depth, and the outcome distribution they give
+********************************/
+
+#ifndef KLEVELENGINE_H
+#define KLEVELENGINE_H
+#include "PayoffTensor.h"
+
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+L_0 plays the strategy holding its highest payoff anywhere in the game (the
+first one in PayoffTensor order), and L_k plays its best response to
+everyone else at L_{k-1}, ties going to the highest-numbered strategy as in
+simGame's best responses. A level is computed the first time it's asked for
+and kept, at numPlayers * numStrats payoff lookups, so depth costs nothing
+until it's used and no table over rationality profiles is ever made. Since
+players' levels are independent, an outcome's probability is the product of
+each player's probability of playing their part of it.
+******************************************************************************/
+template <typename T>
+class KLevelEngine
+{
+	private:
+		PayoffTensor<T> payoffs;
+		vector<vector<int> > strategies; // strategies.at(k).at(x) is P_x's strategy at L_k, for the levels computed so far
+
+		void computeNextLevel();
+		void support(int, const vector<double> &, vector<int> &, vector<double> &);
+	public:
+		KLevelEngine() {}
+		KLevelEngine(const PayoffTensor<T> &p) : payoffs(p) {}
+
+		int getNumLevels() const 					{ return strategies.size(); } // computed so far
+		const PayoffTensor<T>& getPayoffs() const 	{ return payoffs; }
+		int strategy(int k, int x) 					{ return level(k).at(x); }
+
+		void clear();
+		vector<double> expectedUtilities(const vector<double> &);
+		const vector<int>& level(int);
+		void outcomeDistribution(const vector<double> &, vector<vector<int> > &, vector<double> &);
+		void reset(const PayoffTensor<T> &);
+};
+
+// forgets the game and its levels
+template <typename T>
+void KLevelEngine<T>::clear()
+{
+	payoffs = PayoffTensor<T>();
+	strategies.clear();
+}
+
+// the level after the last one computed
+template <typename T>
+void KLevelEngine<T>::computeNextLevel()
+{
+	int nP = payoffs.getNumPlayers();
+	vector<int> next = vector<int>(nP, 0);
+
+	if (strategies.empty())
+	{
+		// the first outcome starts as everyone's best, and its profile is all 0's
+		const T* p = payoffs.data();
+		vector<T> best = vector<T>(p, p + nP);
+		for (size_t m = 0; m < payoffs.getNumMatrices(); m++)
+			for (int i = 0; i < payoffs.getNumStrats(0); i++)
+				for (int j = 0; j < payoffs.getNumStrats(1); j++, p += nP)
+				{
+					for (int x = 0; x < nP; x++)
+					{
+						if (p[x] > best.at(x))
+						{
+							best.at(x) = p[x];
+							if (x == 0)
+								next.at(x) = i;
+							else if (x == 1)
+								next.at(x) = j;
+							else
+							{
+								// P_3's strategy varies fastest in m
+								size_t stride = 1;
+								for (int y = 2; y < x; y++)
+									stride *= payoffs.getNumStrats(y);
+								next.at(x) = (m / stride) % payoffs.getNumStrats(x);
+							}
+						}
+					}
+				}
+		strategies.push_back(next);
+		return;
+	}
+
+	vector<int> profile = strategies.back();
+	for (int x = 0; x < nP; x++)
+	{
+		T best = T();
+		for (int s = 0; s < payoffs.getNumStrats(x); s++)
+		{
+			profile.at(x) = s;
+			T value = payoffs.payoff(profile, x);
+			if (s == 0 || value >= best)
+			{
+				best = value;
+				next.at(x) = s;
+			}
+		}
+		profile.at(x) = strategies.back().at(x);
+	}
+	strategies.push_back(next);
+}
+
+/// @brief each player's expected payoff when levels are drawn independently from levelProbabilities
+/// @param levelProbabilities P(L_0), ..., P(L_K)
+/// @return one per player
+template <typename T>
+vector<double> KLevelEngine<T>::expectedUtilities(const vector<double> &levelProbabilities)
+{
+	vector<vector<int> > outcomes;
+	vector<double> probabilities;
+	outcomeDistribution(levelProbabilities, outcomes, probabilities);
+
+	vector<double> utilities = vector<double>(payoffs.getNumPlayers(), 0.0);
+	for (int x = 0; (unsigned)x < utilities.size(); x++)
+	{
+		for (int o = 0; (unsigned)o < outcomes.size(); o++)
+			utilities.at(x) += payoffs.payoff(outcomes.at(o), x) * probabilities.at(o);
+	}
+	return utilities;
+}
+
+/// @brief every player's strategy at L_k, computing the levels up to it if they haven't been
+/// @param k 0 or more
+template <typename T>
+const vector<int>& KLevelEngine<T>::level(int k)
+{
+	while (strategies.size() <= (unsigned)k)
+		computeNextLevel();
+	return strategies.at(k);
+}
+
+/// @brief every profile of strategies the levels play, with its probability, the
+/// first player's strategy varying slowest and each player's in the order their levels reach them
+/// @param levelProbabilities P(L_0), ..., P(L_K)
+/// @param outcomes receives the profiles
+/// @param probabilities receives one per profile; a profile only reached by levels of probability 0 gets 0
+template <typename T>
+void KLevelEngine<T>::outcomeDistribution(const vector<double> &levelProbabilities, vector<vector<int> > &outcomes, vector<double> &probabilities)
+{
+	int nP = payoffs.getNumPlayers();
+	vector<vector<int> > supports = vector<vector<int> >(nP);
+	vector<vector<double> > marginals = vector<vector<double> >(nP);
+	for (int x = 0; x < nP; x++)
+		support(x, levelProbabilities, supports.at(x), marginals.at(x));
+
+	outcomes.clear();
+	probabilities.clear();
+	vector<int> position = vector<int>(nP, 0), profile = vector<int>(nP);
+	while (true)
+	{
+		double probability = 1.0;
+		for (int x = 0; x < nP; x++)
+		{
+			profile.at(x) = supports.at(x).at(position.at(x));
+			probability *= marginals.at(x).at(position.at(x));
+		}
+		outcomes.push_back(profile);
+		probabilities.push_back(probability);
+
+		int x = nP - 1;
+		while (x >= 0 && (unsigned)++position.at(x) == supports.at(x).size())
+			position.at(x--) = 0;
+		if (x < 0)
+			break;
+	}
+}
+
+/// @brief replaces the game, forgetting the levels computed for the last one
+/// @param p
+template <typename T>
+void KLevelEngine<T>::reset(const PayoffTensor<T> &p)
+{
+	payoffs = p;
+	strategies.clear();
+}
+
+/// @brief the strategies P_x plays at L_0, ..., L_K, in the order first played, and the probability of each
+/// @param x
+/// @param levelProbabilities P(L_0), ..., P(L_K)
+/// @param strats receives the strategies
+/// @param probabilities receives their probabilities
+template <typename T>
+void KLevelEngine<T>::support(int x, const vector<double> &levelProbabilities, vector<int> &strats, vector<double> &probabilities)
+{
+	strats.clear();
+	probabilities.clear();
+	for (int k = 0; (unsigned)k < levelProbabilities.size(); k++)
+	{
+		int s = strategy(k, x), n = 0;
+		while ((unsigned)n < strats.size() && strats.at(n) != s)
+			n++;
+		if ((unsigned)n == strats.size())
+		{
+			strats.push_back(s);
+			probabilities.push_back(0.0);
+		}
+		probabilities.at(n) += levelProbabilities.at(k);
+	}
+}
+
+#endif
@@ -7,6 +7,7 @@ Purpose: Game theory program
 
 #ifndef KNOWLEDGE_H
 #define KNOWLEDGE_H
+#include "BitMatrix.h"
 #include "Polynomial.h"
 #include <iostream>
 #include <iomanip>
@@ -18,70 +19,58 @@ Purpose: Game theory program
 #include <ctime>
 using namespace std;
 
+// the kinds of information a player can know about another
+enum KnowledgeKind
+{
+	CHOICE_KNOWLEDGE,
+	NUM_PLAYERS_KNOWLEDGE,
+	NUM_STRATS_KNOWLEDGE,
+	PAYOFF_KNOWLEDGE,
+	PREFERENCE_KNOWLEDGE,
+	RATIONALITY_KNOWLEDGE,
+	NUM_KNOWLEDGE_KINDS
+};
+
+// what a player knows: entry (x, y) of each kind's matrix is whether they know that P_x knows P_y's information
 class Knowledge
 {
 	private:
-		int player;
-		vector<vector<bool> > choiceKnowledge;
-		vector<vector<bool> > numPlayersKnowledge;
-		vector<vector<bool> > numStratsKnowledge;
-		vector<vector<bool> > payoffKnowledge;
-		vector<vector<bool> > preferenceKnowledge;
-		vector<vector<bool> > rationalityKnowledge;
-		
+		BitMatrix matrices[NUM_KNOWLEDGE_KINDS];
+
 	public:
 		Knowledge(int numPlayers)
 		{
-			choiceKnowledge = vector<vector<bool> >(numPlayers);
-			numPlayersKnowledge = vector<vector<bool> >(numPlayers);
-			numStratsKnowledge = vector<vector<bool> >(numPlayers);
-			payoffKnowledge = vector<vector<bool> >(numPlayers);
-			preferenceKnowledge = vector<vector<bool> >(numPlayers);
-			rationalityKnowledge = vector<vector<bool> >(numPlayers);
-			
-			for (int x = 0; x < numPlayers; x++)
-			{
-				choiceKnowledge.at(x).resize(numPlayers);
-				numPlayersKnowledge.at(x).resize(numPlayers);
-				numStratsKnowledge.at(x).resize(numPlayers);
-				payoffKnowledge.at(x).resize(numPlayers);
-				preferenceKnowledge.at(x).resize(numPlayers);
-				rationalityKnowledge.at(x).resize(numPlayers);
-				for (int y = 0; y < numPlayers; y++)
-				{
-					numPlayersKnowledge.at(x).at(y) = true;
-					numStratsKnowledge.at(x).at(y) = true;
-					payoffKnowledge.at(x).at(y) = true;
-					if (x == y) // player knows that P_x knows P_x's information
-					{
-						choiceKnowledge.at(x).at(y) = true;
-						preferenceKnowledge.at(x).at(y) = true;
-						rationalityKnowledge.at(x).at(y) = true;
-					}
-					else
-					{
-						choiceKnowledge.at(x).at(y) = false;
-						preferenceKnowledge.at(x).at(y) = false;
-						rationalityKnowledge.at(x).at(y) = false;
-					}
-				}
-			}
+			// everyone knows the game; a player knows that P_x knows only P_x's own choice, preference, and rationality
+			matrices[CHOICE_KNOWLEDGE] = BitMatrix(numPlayers, false);
+			matrices[NUM_PLAYERS_KNOWLEDGE] = BitMatrix(numPlayers, true);
+			matrices[NUM_STRATS_KNOWLEDGE] = BitMatrix(numPlayers, true);
+			matrices[PAYOFF_KNOWLEDGE] = BitMatrix(numPlayers, true);
+			matrices[PREFERENCE_KNOWLEDGE] = BitMatrix(numPlayers, false);
+			matrices[RATIONALITY_KNOWLEDGE] = BitMatrix(numPlayers, false);
+			matrices[CHOICE_KNOWLEDGE].setDiagonal(true);
+			matrices[PREFERENCE_KNOWLEDGE].setDiagonal(true);
+			matrices[RATIONALITY_KNOWLEDGE].setDiagonal(true);
 		}
-		
+
 		~Knowledge(){}
-		
-		bool getchoiceKnowledge(int x, int y) 					{ return choiceKnowledge.at(x).at(y); }
-		bool getpayoffKnowledge(int x, int y) 					{ return payoffKnowledge.at(x).at(y); }
-		bool getnumPlayersKnowledge(int x, int y) 				{ return numPlayersKnowledge.at(x).at(y); }
-		bool getnumStratsKnowledge(int x, int y) 				{ return numStratsKnowledge.at(x).at(y); }
-		bool getrationalityKnowledge(int x, int y) 				{ return rationalityKnowledge.at(x).at(y); }
-		bool getpreferenceKnowledge(int x, int y) 				{ return preferenceKnowledge.at(x).at(y); }
-		void setchoiceKnowledge(int x, int y, bool val) 		{ choiceKnowledge.at(x).at(y) = val; }
-		void setpayoffKnowledge(int x, int y, bool val) 		{ payoffKnowledge.at(x).at(y) = val; }
-		void setnumPlayersKnowledge(int x, int y, bool val) 	{ numPlayersKnowledge.at(x).at(y) = val; }
-		void setnumStratsKnowledge(int x, int y, bool val) 		{ numStratsKnowledge.at(x).at(y) = val; }
-		void setrationalityKnowledge(int x, int y, bool val) 	{ rationalityKnowledge.at(x).at(y) = val; }
-		void setpreferenceKnowledge(int x, int y, bool val) 	{ preferenceKnowledge.at(x).at(y) = val; }
+
+		bool get(KnowledgeKind k, int x, int y) const 			{ return matrices[k].get(x, y); }
+		const BitMatrix &getMatrix(KnowledgeKind k) const 		{ return matrices[k]; }
+		void set(KnowledgeKind k, int x, int y, bool val) 		{ matrices[k].set(x, y, val); }
+		void setMatrix(KnowledgeKind k, const BitMatrix &m) 	{ matrices[k] = m; }
+
+		bool getchoiceKnowledge(int x, int y) 					{ return matrices[CHOICE_KNOWLEDGE].get(x, y); }
+		bool getpayoffKnowledge(int x, int y) 					{ return matrices[PAYOFF_KNOWLEDGE].get(x, y); }
+		bool getnumPlayersKnowledge(int x, int y) 				{ return matrices[NUM_PLAYERS_KNOWLEDGE].get(x, y); }
+		bool getnumStratsKnowledge(int x, int y) 				{ return matrices[NUM_STRATS_KNOWLEDGE].get(x, y); }
+		bool getrationalityKnowledge(int x, int y) 				{ return matrices[RATIONALITY_KNOWLEDGE].get(x, y); }
+		bool getpreferenceKnowledge(int x, int y) 				{ return matrices[PREFERENCE_KNOWLEDGE].get(x, y); }
+		void setchoiceKnowledge(int x, int y, bool val) 		{ matrices[CHOICE_KNOWLEDGE].set(x, y, val); }
+		void setpayoffKnowledge(int x, int y, bool val) 		{ matrices[PAYOFF_KNOWLEDGE].set(x, y, val); }
+		void setnumPlayersKnowledge(int x, int y, bool val) 	{ matrices[NUM_PLAYERS_KNOWLEDGE].set(x, y, val); }
+		void setnumStratsKnowledge(int x, int y, bool val) 		{ matrices[NUM_STRATS_KNOWLEDGE].set(x, y, val); }
+		void setrationalityKnowledge(int x, int y, bool val) 	{ matrices[RATIONALITY_KNOWLEDGE].set(x, y, val); }
+		void setpreferenceKnowledge(int x, int y, bool val) 	{ matrices[PREFERENCE_KNOWLEDGE].set(x, y, val); }
 };
 
-#endif
\ No newline at end of file
+#endif
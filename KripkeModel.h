@@ -0,0 +1,430 @@
+/*******************************
+Title: KripkeModel.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: possible-worlds models of what players know, with events and accessibility relations as bitsets
+********************************/
+
+#ifndef KRIPKEMODEL_H
+#define KRIPKEMODEL_H
+#include "BitMatrix.h"
+#include "GameResults.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+A Kripke model has worlds 0 to numWorlds - 1, each labelled with the
+strategy profile played there, and for each player a relation giving the
+worlds they consider possible at each world. An event is a set of worlds,
+packed 64 to a word. P_x knows E at w if every world P_x considers possible
+at w is in E, so knows(x, E) starts from every world and removes the ones
+that can see a world outside E, taking each such world's row of the
+transposed relation: |not E| * numWorlds / 64 word operations. Knowledge of
+knowledge nests by applying knows() again.
+E is common knowledge at w if no chain of one or more players' relations
+leads from w out of E. Rather than iterating everyone-knows to a fixpoint,
+which could take numWorlds rounds, the model keeps the transitive closure
+of the union of the relations, a BitMatrix whose row w holds the worlds w
+reaches: it's built once, in numWorlds^3 / 64 word operations, the first
+time it's needed after the relations change, and then each event is
+common knowledge at w exactly when row w is within it, numWorlds / 64 word
+operations per world. A model shouldn't be queried by several threads
+before its closure is built.
+Relations aren't required to be equivalences. setPartition() gives the
+usual S5 model in which a player knows which of their cells they're in;
+without it, every player knows which world is the actual one.
+******************************************************************************/
+
+// a set of worlds, packed 64 to a word
+class WorldSet
+{
+	private:
+		int numWorlds;
+		vector<uint64_t> words;
+
+	public:
+		WorldSet(int n = 0, bool all = false)
+		{
+			numWorlds = n;
+			words.assign((n + 63) / 64, all ? ~(uint64_t)0 : 0);
+			if (all && n % 64 != 0)
+				words.back() = ((uint64_t)1 << (n % 64)) - 1;
+		}
+
+		bool contains(int w) const 				{ return (words[w / 64] >> (w % 64)) & 1; }
+		int getNumWorlds() const 				{ return numWorlds; }
+		void insert(int w) 						{ words[w / 64] |= (uint64_t)1 << (w % 64); }
+		void erase(int w) 						{ words[w / 64] &= ~((uint64_t)1 << (w % 64)); }
+
+		WorldSet complement() const;
+		int count() const;
+		bool empty() const;
+		void intersect(const WorldSet &);
+		const vector<uint64_t>& getWords() const 	{ return words; }
+		bool isSubsetOf(const WorldSet &) const;
+		void minus(const WorldSet &);
+		int next(int) const;
+		void unite(const WorldSet &);
+
+		bool operator == (const WorldSet &s) const 	{ return numWorlds == s.numWorlds && words == s.words; }
+		bool operator != (const WorldSet &s) const 	{ return !(*this == s); }
+};
+
+// the worlds not in the set
+inline WorldSet WorldSet::complement() const
+{
+	WorldSet result = WorldSet(numWorlds, true);
+	for (size_t w = 0; w < words.size(); w++)
+		result.words[w] &= ~words[w];
+	return result;
+}
+
+// number of worlds in the set
+inline int WorldSet::count() const
+{
+	int total = 0;
+	for (size_t w = 0; w < words.size(); w++)
+		total += __builtin_popcountll(words[w]);
+	return total;
+}
+
+// true if no world is in the set
+inline bool WorldSet::empty() const
+{
+	for (size_t w = 0; w < words.size(); w++)
+	{
+		if (words[w])
+			return false;
+	}
+	return true;
+}
+
+// keeps only the worlds also in s, which must have as many worlds
+inline void WorldSet::intersect(const WorldSet &s)
+{
+	for (size_t w = 0; w < words.size(); w++)
+		words[w] &= s.words[w];
+}
+
+// true if every world in the set is in s
+inline bool WorldSet::isSubsetOf(const WorldSet &s) const
+{
+	for (size_t w = 0; w < words.size(); w++)
+	{
+		if (words[w] & ~s.words[w])
+			return false;
+	}
+	return true;
+}
+
+// removes the worlds in s
+inline void WorldSet::minus(const WorldSet &s)
+{
+	for (size_t w = 0; w < words.size(); w++)
+		words[w] &= ~s.words[w];
+}
+
+// the first world in the set from world on, or -1 if there isn't one
+inline int WorldSet::next(int world) const
+{
+	if (world >= numWorlds)
+		return -1;
+	size_t w = world / 64;
+	uint64_t word = words[w] & (~(uint64_t)0 << (world % 64));
+	while (!word)
+	{
+		if (++w == words.size())
+			return -1;
+		word = words[w];
+	}
+	return w * 64 + __builtin_ctzll(word);
+}
+
+// adds the worlds in s, which must have as many worlds
+inline void WorldSet::unite(const WorldSet &s)
+{
+	for (size_t w = 0; w < words.size(); w++)
+		words[w] |= s.words[w];
+}
+
+class KripkeModel
+{
+	private:
+		int numPlayers;
+		int numWorlds;
+		vector<vector<WorldSet> > accessible; // accessible.at(x).at(w): the worlds P_x considers possible at w
+		vector<vector<WorldSet> > accessibleFrom; // accessibleFrom.at(x).at(v): the worlds at which P_x considers v possible
+		vector<vector<int> > profiles; // the strategies played at each world
+		mutable BitMatrix reach; // (w, v): some chain of the players' relations leads from w to v; built by reachability()
+		mutable bool reachValid;
+
+		GameStatus checkPlayer(int) const;
+		GameStatus checkWorld(int) const;
+		const BitMatrix& reachability() const;
+	public:
+		KripkeModel(int nP = 0, int nW = 0);
+
+		const WorldSet& getAccessible(int x, int w) const 	{ return accessible.at(x).at(w); }
+		int getNumPlayers() const 							{ return numPlayers; }
+		int getNumWorlds() const 							{ return numWorlds; }
+		const vector<int>& getProfile(int w) const 			{ return profiles.at(w); }
+
+		WorldSet choiceEvent(int, int) const;
+		WorldSet commonKnowledge(const WorldSet &) const;
+		WorldSet everyoneKnows(const WorldSet &) const;
+		int knowledgeDepth(int, const WorldSet &, int, int) const;
+		WorldSet knows(int, const WorldSet &) const;
+		bool knowsChoice(int, int, int) const;
+		WorldSet knowsNested(const vector<int> &, const WorldSet &) const;
+		WorldSet possible(int, const WorldSet &) const;
+		GameStatus setAccessible(int, int, int, bool);
+		GameStatus setPartition(int, const vector<int> &);
+		GameStatus setProfile(int, const vector<int> &);
+};
+
+/// @brief a model in which every player knows which world is the actual one
+/// @param nP number of players
+/// @param nW number of worlds, whose profiles are empty until set
+inline KripkeModel::KripkeModel(int nP, int nW)
+{
+	numPlayers = nP;
+	numWorlds = nW;
+	accessible = vector<vector<WorldSet> >(nP, vector<WorldSet>(nW, WorldSet(nW)));
+	accessibleFrom = accessible;
+	for (int x = 0; x < nP; x++)
+		for (int w = 0; w < nW; w++)
+		{
+			accessible.at(x).at(w).insert(w);
+			accessibleFrom.at(x).at(w).insert(w);
+		}
+	profiles = vector<vector<int> >(nW);
+	reachValid = false;
+}
+
+// fails unless x is a player
+inline GameStatus KripkeModel::checkPlayer(int x) const
+{
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("P_" + to_string(x + 1) + " is not in the model");
+	return GameStatus();
+}
+
+// fails unless w is a world
+inline GameStatus KripkeModel::checkWorld(int w) const
+{
+	if (w < 0 || w >= numWorlds)
+		return GameStatus("world " + to_string(w) + " is not in the model");
+	return GameStatus();
+}
+
+/// @brief the worlds at which P_y plays s
+/// @param y
+/// @param s
+inline WorldSet KripkeModel::choiceEvent(int y, int s) const
+{
+	WorldSet event = WorldSet(numWorlds);
+	for (int w = 0; w < numWorlds; w++)
+	{
+		if ((unsigned)y < profiles.at(w).size() && profiles.at(w).at(y) == s)
+			event.insert(w);
+	}
+	return event;
+}
+
+/// @brief the worlds at which event is common knowledge: everyone knows it, everyone knows that, and so on
+/// @param event
+/// @return the worlds from which no chain of the players' relations leads outside event
+inline WorldSet KripkeModel::commonKnowledge(const WorldSet &event) const
+{
+	const BitMatrix &reaches = reachability();
+	WorldSet result = WorldSet(numWorlds);
+	for (int w = 0; w < numWorlds; w++)
+	{
+		if (reaches.rowWithin(w, event.getWords()))
+			result.insert(w);
+	}
+	return result;
+}
+
+/// @brief the worlds at which every player knows event
+/// @param event
+inline WorldSet KripkeModel::everyoneKnows(const WorldSet &event) const
+{
+	WorldSet result = WorldSet(numWorlds, true);
+	for (int x = 0; x < numPlayers; x++)
+		result.intersect(knows(x, event));
+	return result;
+}
+
+/// @brief how many levels of mutual knowledge of event P_x has at world
+/// @param x
+/// @param event
+/// @param world
+/// @param maxDepth the deepest level checked
+/// @return the largest d <= maxDepth such that P_x knows event and, for d > 1, knows that everyone knows it, to d - 1 levels
+inline int KripkeModel::knowledgeDepth(int x, const WorldSet &event, int world, int maxDepth) const
+{
+	if (maxDepth > 0 && reachability().rowWithin(world, event.getWords()))
+		return maxDepth; // common knowledge at world, so P_x knows it to every depth
+	
+	WorldSet mutual = event; // everyone knows, d - 1 times
+	for (int d = 1; d <= maxDepth; d++)
+	{
+		if (!knows(x, mutual).contains(world))
+			return d - 1;
+		if (d < maxDepth)
+		{
+			WorldSet next = everyoneKnows(mutual);
+			if (next == mutual)
+				return maxDepth; // a fixpoint, so event is common knowledge wherever P_x knows it
+			mutual = next;
+		}
+	}
+	return maxDepth;
+}
+
+/// @brief the worlds at which P_x knows event
+/// @param x
+/// @param event
+inline WorldSet KripkeModel::knows(int x, const WorldSet &event) const
+{
+	WorldSet result = WorldSet(numWorlds, true), outside = event.complement();
+	for (int v = outside.next(0); v >= 0; v = outside.next(v + 1))
+		result.minus(accessibleFrom.at(x).at(v));
+	return result;
+}
+
+/// @brief whether P_x knows P_y's strategy at world: it's the same at every world P_x considers possible there
+/// @param x
+/// @param y
+/// @param world
+inline bool KripkeModel::knowsChoice(int x, int y, int world) const
+{
+	const WorldSet &worlds = accessible.at(x).at(world);
+	int first = worlds.next(0);
+	if (first < 0 || (unsigned)y >= profiles.at(first).size())
+		return false;
+	for (int w = worlds.next(first + 1); w >= 0; w = worlds.next(w + 1))
+	{
+		if ((unsigned)y >= profiles.at(w).size() || profiles.at(w).at(y) != profiles.at(first).at(y))
+			return false;
+	}
+	return true;
+}
+
+/// @brief the worlds at which chain.at(0) knows that chain.at(1) knows that ... event
+/// @param chain players, outermost first
+/// @param event
+inline WorldSet KripkeModel::knowsNested(const vector<int> &chain, const WorldSet &event) const
+{
+	WorldSet result = event;
+	for (int n = chain.size() - 1; n >= 0; n--)
+		result = knows(chain.at(n), result);
+	return result;
+}
+
+/// @brief the worlds at which P_x considers event possible, i.e., doesn't know it's false
+/// @param x
+/// @param event
+inline WorldSet KripkeModel::possible(int x, const WorldSet &event) const
+{
+	return knows(x, event.complement()).complement();
+}
+
+// the transitive closure of the union of the players' relations, built once after they change
+inline const BitMatrix& KripkeModel::reachability() const
+{
+	if (!reachValid)
+	{
+		reach = BitMatrix(numWorlds);
+		for (int x = 0; x < numPlayers; x++)
+			for (int w = 0; w < numWorlds; w++)
+				reach.orRow(w, accessible.at(x).at(w).getWords());
+		reach.transitiveClosure();
+		reachValid = true;
+	}
+	return reach;
+}
+
+/// @brief sets whether P_x considers world v possible at world w
+/// @param x
+/// @param w
+/// @param v
+/// @param value
+inline GameStatus KripkeModel::setAccessible(int x, int w, int v, bool value)
+{
+	GameStatus status = checkPlayer(x);
+	if (status.ok)
+		status = checkWorld(w);
+	if (status.ok)
+		status = checkWorld(v);
+	if (!status.ok)
+		return status;
+	reachValid = false;
+	if (value)
+	{
+		accessible.at(x).at(w).insert(v);
+		accessibleFrom.at(x).at(v).insert(w);
+	}
+	else
+	{
+		accessible.at(x).at(w).erase(v);
+		accessibleFrom.at(x).at(v).erase(w);
+	}
+	return status;
+}
+
+/// @brief makes P_x's relation the partition in which worlds with the same cell label are indistinguishable
+/// @param x
+/// @param cells one label per world
+inline GameStatus KripkeModel::setPartition(int x, const vector<int> &cells)
+{
+	GameStatus status = checkPlayer(x);
+	if (!status.ok)
+		return status;
+	if (cells.size() != (unsigned)numWorlds)
+		return GameStatus("expected " + to_string(numWorlds) + " cell labels, not " + to_string(cells.size()));
+
+	// each cell's worlds, found in one pass
+	vector<WorldSet> members;
+	map<int, int> cellNumbers;
+	vector<int> cellOf = vector<int>(numWorlds);
+	for (int w = 0; w < numWorlds; w++)
+	{
+		map<int, int>::iterator it = cellNumbers.find(cells.at(w));
+		if (it == cellNumbers.end())
+		{
+			it = cellNumbers.insert(make_pair(cells.at(w), (int)members.size())).first;
+			members.push_back(WorldSet(numWorlds));
+		}
+		members.at(it->second).insert(w);
+		cellOf.at(w) = it->second;
+	}
+	reachValid = false;
+	for (int w = 0; w < numWorlds; w++)
+	{
+		accessible.at(x).at(w) = members.at(cellOf.at(w));
+		accessibleFrom.at(x).at(w) = members.at(cellOf.at(w)); // a partition is symmetric
+	}
+	return status;
+}
+
+/// @brief labels world w with the strategies played there
+/// @param w
+/// @param profile one strategy per player, numbered from 0
+inline GameStatus KripkeModel::setProfile(int w, const vector<int> &profile)
+{
+	GameStatus status = checkWorld(w);
+	if (!status.ok)
+		return status;
+	if (profile.size() != (unsigned)numPlayers)
+		return GameStatus("expected " + to_string(numPlayers) + " strategies, not " + to_string(profile.size()));
+	profiles.at(w) = profile;
+	return status;
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*******************************
+Title: LinearSolver.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: dense linear systems for indifference equations
+********************************/
+
+#ifndef LINEARSOLVER_H
+#define LINEARSOLVER_H
+#include "GameResults.h"
+#include "Rational.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+using namespace std;
+
+// how pivots are compared and tested for zero
+template <typename S>
+struct PivotTraits
+{
+	static S magnitude(const S &a) 		{ return a < S(0) ? -a : a; }
+	static bool isZero(const S &a) 		{ return a == S(0); }
+	static bool isNegative(const S &a) 	{ return a < S(0); }
+	static double toDouble(const S &a) 	{ return static_cast<double>(a); }
+	static bool isValid(const S &a) 	{ return true; }
+};
+
+// doubles treat anything within rounding error of zero as zero
+template <>
+struct PivotTraits<double>
+{
+	static double magnitude(const double &a) 	{ return fabs(a); }
+	static bool isZero(const double &a) 		{ return fabs(a) <= 1e-12; }
+	static bool isNegative(const double &a) 	{ return a < -1e-9; }
+	static double toDouble(const double &a) 	{ return a; }
+	static bool isValid(const double &a) 		{ return std::isfinite(a); }
+};
+
+template <>
+struct PivotTraits<Rational>
+{
+	static Rational magnitude(const Rational &a) 	{ return a < Rational(0) ? -a : a; }
+	static bool isZero(const Rational &a) 			{ return a.getNumerator() == 0; }
+	static bool isNegative(const Rational &a) 		{ return a.getNumerator() < 0; }
+	static double toDouble(const Rational &a) 		{ return a.toDouble(); }
+	static bool isValid(const Rational &a) 			{ return a.isValid(); }
+};
+
+// solves Ax = b by Gaussian elimination with partial pivoting, reusing one workspace for every call
+template <typename S>
+class LinearSolver
+{
+	private:
+		int capacity;
+		vector<S> augmented; // [A | b], row-major, n rows of n + 1 entries
+		bool overflowed; // by the last solve()
+	public:
+		LinearSolver() 			{ capacity = 0; overflowed = false; }
+		LinearSolver(int maxN) 	{ capacity = 0; overflowed = false; reserve(maxN); }
+
+		int getCapacity() const 	{ return capacity; }
+		bool hasOverflowed() const 	{ return overflowed; }
+
+		void reserve(int);
+		bool solve(int, const S*, const S*, S*);
+};
+
+// grows the workspace so systems of up to maxN unknowns never allocate
+template <typename S>
+void LinearSolver<S>::reserve(int maxN)
+{
+	if (maxN > capacity)
+	{
+		capacity = maxN;
+		augmented.resize(capacity * (capacity + 1));
+	}
+}
+
+/// @brief solves the n x n system A x = b; A and b are left untouched
+/// @param n number of unknowns
+/// @param A row-major coefficient matrix
+/// @param b right-hand side
+/// @param x receives the solution
+/// @return false if A is singular or, with Rationals, if the arithmetic overflowed, which hasOverflowed() then tells
+template <typename S>
+bool LinearSolver<S>::solve(int n, const S* A, const S* b, S* x)
+{
+	reserve(n);
+	int width = n + 1;
+	overflowed = false;
+
+	for (int r = 0; r < n; r++)
+	{
+		for (int c = 0; c < n; c++)
+			augmented[r * width + c] = A[r * n + c];
+		augmented[r * width + n] = b[r];
+	}
+
+	// forward elimination
+	for (int c = 0; c < n; c++)
+	{
+		// partial pivoting: largest entry in column c at or below the diagonal
+		int pivot = c;
+		S best = PivotTraits<S>::magnitude(augmented[c * width + c]);
+		overflowed = !PivotTraits<S>::isValid(best);
+		for (int r = c + 1; r < n && !overflowed; r++)
+		{
+			S mag = PivotTraits<S>::magnitude(augmented[r * width + c]);
+			overflowed = !PivotTraits<S>::isValid(mag);
+			if (best < mag)
+			{
+				best = mag;
+				pivot = r;
+			}
+		}
+		if (overflowed || PivotTraits<S>::isZero(best))
+			return false;
+
+		if (pivot != c)
+			swap_ranges(augmented.begin() + c * width + c, augmented.begin() + c * width + width, augmented.begin() + pivot * width + c);
+
+		for (int r = c + 1; r < n; r++)
+		{
+			if (PivotTraits<S>::isZero(augmented[r * width + c]))
+				continue;
+
+			S factor = augmented[r * width + c] / augmented[c * width + c];
+			augmented[r * width + c] = S(0);
+			for (int k = c + 1; k < width; k++)
+				augmented[r * width + k] -= factor * augmented[c * width + k];
+		}
+	}
+
+	// back substitution
+	for (int r = n - 1; r >= 0; r--)
+	{
+		S sum = augmented[r * width + n];
+		for (int k = r + 1; k < n; k++)
+			sum -= augmented[r * width + k] * x[k];
+		x[r] = sum / augmented[r * width + r];
+		if (!PivotTraits<S>::isValid(x[r]))
+			overflowed = true;
+	}
+	return !overflowed;
+}
+
+/***********************************************************************
+many small systems (e.g., one per candidate support) stored back to back
+in preallocated blocks and solved with a single shared workspace
+***********************************************************************/
+template <typename S>
+class BatchSolver
+{
+	private:
+		int maxN;
+		int numSystems;
+		vector<int> sizes;
+		vector<S> matrices; // maxN * maxN per system
+		vector<S> rhs; // maxN per system
+		vector<S> solutions; // maxN per system
+		vector<char> solved;
+		LinearSolver<S> solver;
+	public:
+		BatchSolver(int maxSystems, int n)
+		{
+			maxN = n;
+			numSystems = 0;
+			solver.reserve(maxN);
+			reserve(maxSystems);
+		}
+
+		void clear() 						{ numSystems = 0; }
+		int getMaxN() const 				{ return maxN; }
+		int getNumSystems() const 			{ return numSystems; }
+		int getSize(int k) const 			{ return sizes.at(k); }
+		S* getMatrix(int k) 				{ return &matrices[k * maxN * maxN]; }
+		S* getRHS(int k) 					{ return &rhs[k * maxN]; }
+		const S* getSolution(int k) const 	{ return &solutions[k * maxN]; }
+		bool isSolved(int k) const 			{ return solved.at(k) != 0; }
+
+		GameStatus addSystem(int, int &);
+		void reserve(int);
+		GameStatus solveAll();
+};
+
+// makes room for maxSystems systems without reallocating
+template <typename S>
+void BatchSolver<S>::reserve(int maxSystems)
+{
+	if ((unsigned)maxSystems > sizes.size())
+	{
+		sizes.resize(maxSystems);
+		matrices.resize(maxSystems * maxN * maxN);
+		rhs.resize(maxSystems * maxN);
+		solutions.resize(maxSystems * maxN);
+		solved.resize(maxSystems);
+	}
+}
+
+/// @brief appends an n x n system whose coefficients are then filled through getMatrix() and getRHS()
+/// @param n number of unknowns, from 1 to getMaxN()
+/// @param k receives the index of the new system
+template <typename S>
+GameStatus BatchSolver<S>::addSystem(int n, int &k)
+{
+	if (n > maxN || n < 1)
+		return GameStatus("a system of " + to_string(n) + " unknowns doesn't fit in a batch of systems of up to " + to_string(maxN));
+
+	if ((unsigned)numSystems == sizes.size())
+		reserve(2 * numSystems + 1);
+
+	sizes.at(numSystems) = n;
+	solved.at(numSystems) = 0;
+	k = numSystems++;
+	return GameStatus();
+}
+
+// solves every system in the batch; isSolved() then tells which were nonsingular. Fails if the arithmetic overflows
+template <typename S>
+GameStatus BatchSolver<S>::solveAll()
+{
+	for (int k = 0; k < numSystems; k++)
+	{
+		solved.at(k) = solver.solve(sizes.at(k), getMatrix(k), getRHS(k), &solutions[k * maxN]);
+		if (solver.hasOverflowed())
+			return GameStatus("the numbers in system " + to_string(k) + " grew too large for exact arithmetic");
+	}
+	return GameStatus();
+}
+
+#endif
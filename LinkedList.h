@@ -7,7 +7,10 @@ Purpose: Linked list class for game theory program
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include "BufferedWriter.h"
+
 #include <iostream>
+#include <vector>
 using namespace std;
 
 // linked list (payoff matrix entry) of the form [payoff, BR] -> ... -> [payoff, BR]
@@ -44,11 +47,17 @@ class LinkedList
 		void displayPayoffs() const;
 		void displayBRs() const;
 		T getNodeValue(int);
+		void getNodeValues(T*) const;
 		void setNodeValue(int, int);
+		void setNodeValues(const T*);
 		bool getNodeBestResponse(int);
+		void getNodeBestResponses(vector<bool> &) const;
 		void setNodeBestResponse(int, bool);
 		void insertNode(T, int);
 		int getPos(string) const;
+		template <typename W> void writeBRs(W &) const;
+		template <typename W> int writeList(W &) const;
+		template <typename W> int writePayoffs(W &) const;
 };
 
 template<typename T>
@@ -134,108 +143,21 @@ void LinkedList<T>::deleteNode(int position)
 template<typename T>
 void LinkedList<T>::displayBRs() const
 {
-	ListNode* curNode;
-	
-	if (!head)
-		cout << "The list is empty.\n\n";
-	else
-	{
-		curNode = head;
-		
-		cout << "(";
-		while (curNode)
-		{
-			if (curNode->bestResponse)
-			{
-				cout << "1";
-				if (curNode->next)
-					cout << ", ";
-			}
-			else if (!curNode->bestResponse)
-			{
-				cout << "0";
-				if (curNode->next)
-					cout << ", ";
-			}
-			curNode = curNode->next;
-		}
-		cout << ")";
-	}
+	writeBRs(cout);
 }
 
 // print payoffs and BR's as n-tuple
 template<typename T>
 void LinkedList<T>::displayList(vector<vector<vector<bool> > > extraSpaces, int m, int j) const // FINISH: spacing for bracketed br notation
 {
-	int x = 0;
-	ListNode* curNode;
-	
-	if (!head)
-		cout << "The list is empty.\n\n";
-	else
-	{
-		curNode = head;
-		
-		cout << "(";
-		while (curNode)
-		{
-			if (curNode->bestResponse)
-			{
-				cout << "[" << curNode->value << ", 1]";
-				// cout << "[" << curNode->value << "]";
-			}
-			else if (!curNode->bestResponse)
-			{
-				// adding extra spacing	
-				// if (extraSpaces.at(m).at(j).at(x))
-					// cout << " ";
-				
-				cout << "[" << curNode->value << ", 0]";
-				// cout << curNode->value;
-			}
-			if (curNode->next)
-					cout << "-";
-			// if (curNode->next)
-			// {
-				// if (!curNode->bestResponse && extraSpaces.at(m).at(j).at(x))
-					// cout << " ";
-				
-				// cout << ", ";
-			// }
-			// else
-			// {
-				// if (!curNode->bestResponse)
-					// cout << " ";
-			// }
-			curNode = curNode->next;
-			x++;
-		}
-		cout << ")";
-	}
+	writeList(cout);
 }
 
 // print payoffs as n-tuple
 template<typename T>
 void LinkedList<T>::displayPayoffs() const
 {
-	ListNode* curNode;
-	
-	if (!head)
-		cout << "The list is empty.\n\n";
-	else
-	{
-		curNode = head;
-		
-		cout << "(";
-		while (curNode)
-		{
-			cout << curNode->value;
-			if (curNode->next)
-				cout << ", ";
-			curNode = curNode->next;
-		}
-		cout << ")";
-	}
+	writePayoffs(cout);
 }
 
 // get node value
@@ -267,6 +189,24 @@ T LinkedList<T>::getNodeValue(int position)
 	return -std::numeric_limits<int>::max();
 }
 
+// copy every node's value to values, in order, in one pass
+template<typename T>
+void LinkedList<T>::getNodeValues(T* values) const
+{
+	int n = 0;
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+		values[n++] = curNode->value;
+}
+
+// copy every node's best response flag to bestResponses, which has a flag per node, in order, in one pass
+template<typename T>
+void LinkedList<T>::getNodeBestResponses(vector<bool> &bestResponses) const
+{
+	int n = 0;
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+		bestResponses[n++] = curNode->bestResponse;
+}
+
 // get node BR
 template<typename T>
 bool LinkedList<T>::getNodeBestResponse(int position)
@@ -441,4 +381,87 @@ void LinkedList<T>::setNodeValue(int position, int val)
 	return;
 }
 
+// set every node's value from values, in order, in one pass
+template<typename T>
+void LinkedList<T>::setNodeValues(const T* values)
+{
+	int n = 0;
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+		curNode->value = values[n++];
+}
+
+/// @brief writes the BR's as an n-tuple, e.g., (1, 0)
+/// @param out an ostream or a BufferedWriter
+template<typename T>
+template<typename W>
+void LinkedList<T>::writeBRs(W &out) const
+{
+	if (!head)
+	{
+		out << "The list is empty.\n\n";
+		return;
+	}
+	
+	out << "(";
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+	{
+		out << (curNode->bestResponse ? "1" : "0");
+		if (curNode->next)
+			out << ", ";
+	}
+	out << ")";
+}
+
+/// @brief writes the payoffs and BR's as an n-tuple, e.g., ([3, 1]-[0, 0])
+/// @param out an ostream or a BufferedWriter
+/// @return the payoffs' total length, as for writePayoffs()
+template<typename T>
+template<typename W>
+int LinkedList<T>::writeList(W &out) const
+{
+	int length = 0;
+	if (!head)
+	{
+		out << "The list is empty.\n\n";
+		return length;
+	}
+	
+	out << "(";
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+	{
+		out << "[" << curNode->value << (curNode->bestResponse ? ", 1]" : ", 0]");
+		length += formattedLength(curNode->value);
+		if (curNode->next)
+			out << "-";
+	}
+	out << ")";
+	return length;
+}
+
+/// @brief writes the payoffs as an n-tuple, e.g., (3, 0)
+/// @param out an ostream or a BufferedWriter
+/// @return the payoffs' total length as to_string() gives them, which the print functions pad columns by
+template<typename T>
+template<typename W>
+int LinkedList<T>::writePayoffs(W &out) const
+{
+	int length = 0;
+	if (!head)
+	{
+		out << "The list is empty.\n\n";
+		return length;
+	}
+	
+	out << "(";
+	for (ListNode* curNode = head; curNode; curNode = curNode->next)
+	{
+		out << curNode->value;
+		length += formattedLength(curNode->value);
+		if (curNode->next)
+			out << ", ";
+	}
+	out << ")";
+	return length;
+}
+
 #endif
\ No newline at end of file
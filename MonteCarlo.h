@@ -0,0 +1,308 @@
+/*******************************
+Title: MonteCarlo.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: simulated populations of players with random levels of rationality and noisy choices
+********************************/
+
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+#include "GameResults.h"
+#include "KLevelEngine.h"
+#include "RandomPayoffs.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+simulatePopulations() draws populations of options.populationSize players
+for each role. Each player's level is drawn from the level probabilities and
+they play their level's strategy (see KLevelEngine.h), or, with probability
+errorRate, a strategy chosen uniformly at random, the same model fitLevels()
+in Estimation.h estimates. The i-th players of the roles play each other.
+The result has how often each outcome was played and, for each role, the
+distribution over populations of its players' average payoff: the mean and
+variance, by Welford's method, and the extremes and quantiles, from a
+histogram over the role's range of payoffs.
+
+Population n is drawn from RandomStream(seed, 0, n), and the populations are
+split into NUM_SIMULATION_LANES blocks, each with its own accumulator, that
+the threads take as they're free and that are merged in order at the end, so
+a seed gives the same results for any number of threads.
+******************************************************************************/
+
+const int NUM_SIMULATION_LANES = 64;
+const double SIMULATION_QUANTILES[] = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+const int NUM_SIMULATION_QUANTILES = sizeof(SIMULATION_QUANTILES) / sizeof(SIMULATION_QUANTILES[0]);
+
+// one block's counts and statistics
+struct SimulationLane
+{
+	uint64_t numPopulations;
+	vector<uint64_t> outcomeCounts; // indexed by outcome, for games with few enough of them
+	unordered_map<size_t, uint64_t> sparseCounts; // otherwise
+	vector<double> means;
+	vector<double> squares; // sums of squared deviations from the means
+	vector<double> mins;
+	vector<double> maxes;
+	vector<vector<uint64_t> > histograms;
+
+	SimulationLane() { numPopulations = 0; }
+
+	void addOutcome(size_t);
+	void merge(const SimulationLane &);
+	void reset(size_t, int, int);
+};
+
+// counts a game with the outcome whose index in PayoffTensor order is outcome
+inline void SimulationLane::addOutcome(size_t outcome)
+{
+	if (outcomeCounts.empty())
+		sparseCounts[outcome]++;
+	else
+		outcomeCounts[outcome]++;
+}
+
+/// @brief adds lane's populations, by Chan et al.'s update for the means and variances
+/// @param lane
+inline void SimulationLane::merge(const SimulationLane &lane)
+{
+	if (lane.numPopulations == 0)
+		return;
+	for (int o = 0; (unsigned)o < outcomeCounts.size(); o++)
+		outcomeCounts[o] += lane.outcomeCounts[o];
+	for (unordered_map<size_t, uint64_t>::const_iterator it = lane.sparseCounts.begin(); it != lane.sparseCounts.end(); it++)
+		sparseCounts[it->first] += it->second;
+
+	double n = numPopulations, m = lane.numPopulations;
+	for (int x = 0; (unsigned)x < means.size(); x++)
+	{
+		double delta = lane.means.at(x) - means.at(x);
+		means.at(x) += delta * m / (n + m);
+		squares.at(x) += lane.squares.at(x) + delta * delta * n * m / (n + m);
+		mins.at(x) = numPopulations == 0 ? lane.mins.at(x) : min(mins.at(x), lane.mins.at(x));
+		maxes.at(x) = numPopulations == 0 ? lane.maxes.at(x) : max(maxes.at(x), lane.maxes.at(x));
+		for (int b = 0; (unsigned)b < histograms.at(x).size(); b++)
+			histograms.at(x).at(b) += lane.histograms.at(x).at(b);
+	}
+	numPopulations += lane.numPopulations;
+}
+
+/// @brief empties the lane
+/// @param numOutcomes
+/// @param numPlayers
+/// @param numBins
+inline void SimulationLane::reset(size_t numOutcomes, int numPlayers, int numBins)
+{
+	numPopulations = 0;
+	outcomeCounts.assign(numOutcomes <= (1 << 16) ? numOutcomes : 0, 0);
+	sparseCounts.clear();
+	means.assign(numPlayers, 0.0);
+	squares.assign(numPlayers, 0.0);
+	mins.assign(numPlayers, 0.0);
+	maxes.assign(numPlayers, 0.0);
+	histograms.assign(numPlayers, vector<uint64_t>(numBins, 0));
+}
+
+/// @brief simulates populations playing the game
+/// @param payoffs
+/// @param options
+/// @return outcome frequencies and the distributions of the roles' average payoffs
+template <typename T>
+SimulationResult simulatePopulations(const PayoffTensor<T> &payoffs, const SimulationOptions &options)
+{
+	SimulationResult result;
+	int nP = payoffs.getNumPlayers();
+	if (options.numPopulations == 0 || options.populationSize < 1)
+	{
+		result.status = GameStatus("there must be at least one population of at least one player");
+		return result;
+	}
+	if (!(options.errorRate >= 0.0 && options.errorRate <= 1.0))
+	{
+		result.status = GameStatus("the error rate must be from 0 to 1");
+		return result;
+	}
+	if (options.numBins < 1)
+	{
+		result.status = GameStatus("the histograms need at least one bin");
+		return result;
+	}
+
+	// the cumulative level probabilities, the remainder going to the next level
+	vector<double> cumulative;
+	double sum = 0.0;
+	for (int k = 0; (unsigned)k < options.levelProbabilities.size(); k++)
+	{
+		double p = options.levelProbabilities.at(k);
+		if (!(p >= 0.0 && p <= 1.0))
+		{
+			result.status = GameStatus("P(L_" + to_string(k) + ") must be from 0 to 1");
+			return result;
+		}
+		sum += p;
+		cumulative.push_back(sum);
+	}
+	if (sum > 1.0 + 1e-9)
+	{
+		result.status = GameStatus("the level probabilities sum to more than 1");
+		return result;
+	}
+	if (cumulative.empty() || sum < 1.0 - 1e-9)
+		cumulative.push_back(1.0);
+	cumulative.back() = 1.0;
+
+	KLevelEngine<T> levels(payoffs);
+	vector<vector<int> > strategies;
+	for (int k = 0; (unsigned)k < cumulative.size(); k++)
+		strategies.push_back(levels.level(k));
+
+	// each role's payoffs' range, which holds its average
+	vector<double> lows = vector<double>(nP), widths = vector<double>(nP);
+	for (int x = 0; x < nP; x++)
+	{
+		double lo = payoffs.data()[x], hi = lo;
+		for (size_t o = 0; o < payoffs.getNumOutcomes(); o++)
+		{
+			lo = min(lo, (double)payoffs.data()[o * nP + x]);
+			hi = max(hi, (double)payoffs.data()[o * nP + x]);
+		}
+		lows.at(x) = lo;
+		widths.at(x) = hi - lo;
+	}
+
+	// an outcome's index in PayoffTensor order is the sum of its strategies times these
+	vector<size_t> strides = vector<size_t>(nP);
+	strides.at(1) = 1;
+	strides.at(0) = payoffs.getNumStrats(1);
+	size_t stride = (size_t)payoffs.getNumStrats(0) * payoffs.getNumStrats(1);
+	for (int x = 2; x < nP; x++)
+	{
+		strides.at(x) = stride;
+		stride *= payoffs.getNumStrats(x);
+	}
+
+	result.seed = options.seed ? options.seed : (unsigned long long)time(NULL);
+	unsigned long long seed = result.seed;
+	int numLanes = (int)min((unsigned long long)NUM_SIMULATION_LANES, options.numPopulations);
+	vector<SimulationLane> lanes = vector<SimulationLane>(numLanes);
+	{
+		ThreadPool pool(options.numThreads);
+		for (int l = 0; l < numLanes; l++)
+		{
+			pool.push([&, l]()
+			{
+				SimulationLane &lane = lanes.at(l);
+				lane.reset(payoffs.getNumOutcomes(), nP, options.numBins);
+				uint64_t first = options.numPopulations * l / numLanes, last = options.numPopulations * (l + 1) / numLanes;
+				vector<double> totals = vector<double>(nP);
+
+				for (uint64_t n = first; n < last; n++)
+				{
+					RandomStream draws(seed, 0, n);
+					totals.assign(nP, 0.0);
+					for (int g = 0; g < options.populationSize; g++)
+					{
+						// 32 bits are plenty for choosing a level or an error, and take one word each
+						size_t outcome = 0;
+						for (int x = 0; x < nP; x++)
+						{
+							int s;
+							if (options.errorRate > 0.0 && draws.next() * (1.0 / 4294967296.0) < options.errorRate)
+								s = draws.uniformInteger(0, payoffs.getNumStrats(x) - 1);
+							else
+							{
+								double u = draws.next() * (1.0 / 4294967296.0);
+								int k = 0;
+								while (u >= cumulative.at(k) && (unsigned)k < cumulative.size() - 1)
+									k++;
+								s = strategies.at(k).at(x);
+							}
+							outcome += s * strides.at(x);
+						}
+						lane.addOutcome(outcome);
+						for (int x = 0; x < nP; x++)
+							totals.at(x) += payoffs.data()[outcome * nP + x];
+					}
+
+					// Welford's update with this population's averages
+					lane.numPopulations++;
+					for (int x = 0; x < nP; x++)
+					{
+						double average = totals.at(x) / options.populationSize, delta = average - lane.means.at(x);
+						lane.means.at(x) += delta / lane.numPopulations;
+						lane.squares.at(x) += delta * (average - lane.means.at(x));
+						lane.mins.at(x) = lane.numPopulations == 1 ? average : min(lane.mins.at(x), average);
+						lane.maxes.at(x) = lane.numPopulations == 1 ? average : max(lane.maxes.at(x), average);
+						int b = widths.at(x) > 0.0 ? (int)((average - lows.at(x)) / widths.at(x) * options.numBins) : 0;
+						lane.histograms.at(x).at(max(0, min(b, options.numBins - 1)))++;
+					}
+				}
+			});
+		}
+		pool.wait();
+	}
+
+	SimulationLane total;
+	total.reset(payoffs.getNumOutcomes(), nP, options.numBins);
+	for (int l = 0; l < numLanes; l++)
+		total.merge(lanes.at(l));
+
+	// the outcomes played, in order
+	vector<pair<size_t, uint64_t> > counts;
+	for (size_t o = 0; o < total.outcomeCounts.size(); o++)
+	{
+		if (total.outcomeCounts[o] > 0)
+			counts.push_back(make_pair(o, total.outcomeCounts[o]));
+	}
+	counts.insert(counts.end(), total.sparseCounts.begin(), total.sparseCounts.end());
+	sort(counts.begin(), counts.end());
+	double numGames = (double)options.numPopulations * options.populationSize;
+	for (int c = 0; (unsigned)c < counts.size(); c++)
+	{
+		size_t o = counts.at(c).first;
+		vector<int> profile = vector<int>(nP);
+		profile.at(1) = o % payoffs.getNumStrats(1);
+		o /= payoffs.getNumStrats(1);
+		profile.at(0) = o % payoffs.getNumStrats(0);
+		o /= payoffs.getNumStrats(0);
+		for (int x = 2; x < nP; x++)
+		{
+			profile.at(x) = o % payoffs.getNumStrats(x);
+			o /= payoffs.getNumStrats(x);
+		}
+		result.outcomes.push_back(profile);
+		result.outcomeFrequencies.push_back(counts.at(c).second / numGames);
+	}
+
+	// the quantiles, interpolated within their bins and kept within the extremes
+	result.meanPayoffs = total.means;
+	result.minPayoffs = total.mins;
+	result.maxPayoffs = total.maxes;
+	result.payoffVariances = vector<double>(nP);
+	result.payoffQuantiles = vector<vector<double> >(nP, vector<double>(NUM_SIMULATION_QUANTILES));
+	for (int x = 0; x < nP; x++)
+	{
+		result.payoffVariances.at(x) = options.numPopulations > 1 ? total.squares.at(x) / (options.numPopulations - 1) : 0.0;
+		uint64_t below = 0;
+		int b = 0;
+		for (int q = 0; q < NUM_SIMULATION_QUANTILES; q++)
+		{
+			double rank = SIMULATION_QUANTILES[q] * options.numPopulations;
+			while (b < options.numBins - 1 && below + total.histograms.at(x).at(b) < rank)
+				below += total.histograms.at(x).at(b++);
+			double within = total.histograms.at(x).at(b) > 0 ? (rank - below) / total.histograms.at(x).at(b) : 0.0;
+			double value = lows.at(x) + widths.at(x) * (b + min(1.0, max(0.0, within))) / options.numBins;
+			result.payoffQuantiles.at(x).at(q) = min(total.maxes.at(x), max(total.mins.at(x), value));
+		}
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,164 @@
+/*******************************
+Title: PayoffSource.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: payoffs read a range of outcomes at a time, for games too large to load
+********************************/
+
+#ifndef PAYOFFSOURCE_H
+#define PAYOFFSOURCE_H
+#include "BinaryGame.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+a game's payoffs in PayoffTensor order, handed out by range: read(first, n)
+gives the numPlayers payoffs of each of outcomes first to first + n - 1,
+valid until the next read. Outcome u is P_x's payoff at u * numPlayers + x.
+******************************************************************************/
+template <typename T>
+class PayoffSource
+{
+	protected:
+		vector<int> numStrats;
+		uint64_t numOutcomes;
+
+		void setNumStrats(const vector<int> &);
+	public:
+		PayoffSource() { numOutcomes = 0; }
+		virtual ~PayoffSource() {}
+
+		int getNumPlayers() const 				{ return numStrats.size(); }
+		int getNumStrats(int x) const 			{ return numStrats.at(x); }
+		const vector<int>& getNumStrats() const { return numStrats; }
+		uint64_t getNumOutcomes() const 		{ return numOutcomes; }
+
+		virtual const T* read(uint64_t, size_t) = 0; // NULL if the payoffs can't be read
+};
+
+// numStrats and numOutcomes
+template <typename T>
+void PayoffSource<T>::setNumStrats(const vector<int> &nS)
+{
+	numStrats = nS;
+	numOutcomes = 1;
+	for (int x = 0; (unsigned)x < nS.size(); x++)
+		numOutcomes *= nS.at(x);
+}
+
+/******************************************************************************
+payoffs that are already addressable: a tensor in memory, or a binary game
+mapped by open(), in which case the operating system pages the file in and
+out as the analysis moves through it
+******************************************************************************/
+template <typename T>
+class MappedPayoffSource : public PayoffSource<T>
+{
+	private:
+		BinaryGame binary;
+		const T* payoffs;
+	public:
+		MappedPayoffSource() { payoffs = NULL; }
+		MappedPayoffSource(const PayoffTensor<T> &tensor) { payoffs = tensor.data(); this->setNumStrats(tensor.getNumStrats()); }
+
+		GameStatus open(const string &);
+		const T* read(uint64_t first, size_t) { return payoffs ? payoffs + first * this->numStrats.size() : NULL; }
+};
+
+/// @brief maps a binary game file
+/// @param filename
+/// @return the first problem with its header
+template <typename T>
+GameStatus MappedPayoffSource<T>::open(const string &filename)
+{
+	PayoffTensor<T> tensor;
+	GameStatus status = binary.open(filename);
+	if (status.ok)
+		status = binary.payoffs(tensor);
+	if (!status.ok)
+		return status;
+
+	payoffs = tensor.data();
+	this->setNumStrats(tensor.getNumStrats());
+	return GameStatus();
+}
+
+/******************************************************************************
+reads a binary game file with ordinary reads into a buffer of at least
+readAhead outcomes, so memory use is bounded even where the file can't be
+mapped (e.g., files larger than the address space)
+******************************************************************************/
+template <typename T>
+class StreamPayoffSource : public PayoffSource<T>
+{
+	private:
+		ifstream infile;
+		uint64_t payoffOffset;
+		size_t readAhead;
+		vector<T> buffer;
+		uint64_t bufferFirst; // outcomes bufferFirst to bufferFirst + bufferCount - 1 are in buffer
+		size_t bufferCount;
+	public:
+		StreamPayoffSource() { payoffOffset = 0; readAhead = 0; bufferFirst = 0; bufferCount = 0; }
+
+		GameStatus open(const string &, size_t = 1 << 16);
+		const T* read(uint64_t, size_t);
+};
+
+/// @brief opens a binary game file after checking its header
+/// @param filename
+/// @param numOutcomes how many outcomes to read at once when a read asks for fewer
+/// @return the first problem with its header
+template <typename T>
+GameStatus StreamPayoffSource<T>::open(const string &filename, size_t numOutcomes)
+{
+	// only the header is checked, so the payoffs are never paged in
+	BinaryGame binary;
+	GameStatus status = binary.open(filename);
+	if (!status.ok)
+		return status;
+	if (binary.getScalarType() != BinaryScalar<T>::code)
+		return GameStatus(filename + "'s payoffs are not of the requested type");
+	payoffOffset = binary.getPayoffOffset();
+	this->setNumStrats(binary.getNumStrats());
+	binary.close();
+
+	infile.close();
+	infile.clear();
+	infile.open(filename.c_str(), ios::in | ios::binary);
+	if (!infile)
+		return GameStatus("could not open " + filename);
+	readAhead = numOutcomes > 0 ? numOutcomes : 1;
+	bufferCount = 0;
+	return GameStatus();
+}
+
+// outcomes first to first + count - 1, from the buffer if they're already there
+template <typename T>
+const T* StreamPayoffSource<T>::read(uint64_t first, size_t count)
+{
+	size_t nP = this->numStrats.size();
+	if (first >= bufferFirst && first + count <= bufferFirst + bufferCount)
+		return &buffer[(first - bufferFirst) * nP];
+	if (first + count > this->numOutcomes || !infile.is_open())
+		return NULL;
+
+	bufferFirst = first;
+	bufferCount = max((uint64_t)count, min((uint64_t)readAhead, this->numOutcomes - first));
+	buffer.resize(bufferCount * nP);
+	infile.clear();
+	infile.seekg(payoffOffset + first * nP * sizeof(T));
+	infile.read(reinterpret_cast<char*>(&buffer[0]), bufferCount * nP * sizeof(T));
+	if (!infile)
+	{
+		bufferCount = 0;
+		return NULL;
+	}
+	return &buffer[0];
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*******************************
+Title: PayoffTensor.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: every payoff of a game in one flat array
+********************************/
+
+#ifndef PAYOFFTENSOR_H
+#define PAYOFFTENSOR_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+payoffs in the order of the game file: matrix m (P_3 varying fastest, as in
+simGame::hash()), then P_1's strategy i, then P_2's strategy j, then player x,
+i.e., payoff (m, i, j, x) is at ((m * nS_1 + i) * nS_2 + j) * numPlayers + x.
+The payoffs are either owned or a view of memory owned by someone else, e.g.,
+a mapped file, which must outlive the tensor.
+******************************************************************************/
+template <typename T>
+class PayoffTensor
+{
+	private:
+		int numPlayers;
+		vector<int> numStrats;
+		size_t numMatrices;
+		size_t numOutcomes;
+		vector<T> storage; // empty for views
+		const T* payoffs;
+
+		void setDimensions(const vector<int> &);
+	public:
+		PayoffTensor() { numPlayers = 0; numMatrices = 0; numOutcomes = 0; payoffs = NULL; }
+		PayoffTensor(const vector<int> &nS) { payoffs = NULL; reset(nS); }
+
+		// copying a view keeps viewing the same memory; copying owned payoffs copies them
+		PayoffTensor(const PayoffTensor &t)
+			: numPlayers(t.numPlayers), numStrats(t.numStrats), numMatrices(t.numMatrices), numOutcomes(t.numOutcomes), storage(t.storage)
+		{
+			payoffs = t.isView() ? t.payoffs : (storage.empty() ? NULL : &storage[0]);
+		}
+		PayoffTensor& operator=(const PayoffTensor &t)
+		{
+			if (this != &t)
+			{
+				numPlayers = t.numPlayers;
+				numStrats = t.numStrats;
+				numMatrices = t.numMatrices;
+				numOutcomes = t.numOutcomes;
+				storage = t.storage;
+				payoffs = t.isView() ? t.payoffs : (storage.empty() ? NULL : &storage[0]);
+			}
+			return *this;
+		}
+
+		const T* data() const 					{ return payoffs; }
+		T* mutableData() 						{ return storage.empty() ? NULL : &storage[0]; }
+		int getNumPlayers() const 				{ return numPlayers; }
+		int getNumStrats(int x) const 			{ return numStrats.at(x); }
+		const vector<int>& getNumStrats() const { return numStrats; }
+		size_t getNumMatrices() const 			{ return numMatrices; }
+		size_t getNumOutcomes() const 			{ return numOutcomes; }
+		size_t size() const 					{ return numOutcomes * numPlayers; }
+		bool isView() const 					{ return storage.empty() && payoffs != NULL; }
+
+		// index of P_1's payoff in the outcome (m, i, j); the other players' follow it
+		size_t offset(size_t m, int i, int j) const
+		{ return ((m * numStrats[0] + i) * numStrats[1] + j) * numPlayers; }
+
+		T payoff(size_t m, int i, int j, int x) const { return payoffs[offset(m, i, j) + x]; }
+
+		void attach(const T*, const vector<int> &);
+		size_t matrixIndex(const vector<int> &) const;
+		T payoff(const vector<int> &, int) const;
+		void reset(const vector<int> &);
+		void swap(PayoffTensor &);
+};
+
+// numbers of matrices and outcomes for nS
+template <typename T>
+void PayoffTensor<T>::setDimensions(const vector<int> &nS)
+{
+	numStrats = nS;
+	numPlayers = nS.size();
+	numMatrices = 1;
+	for (int x = 2; x < numPlayers; x++)
+		numMatrices *= nS.at(x);
+	numOutcomes = numPlayers < 2 ? 0 : numMatrices * nS.at(0) * nS.at(1);
+}
+
+// view payoffs owned elsewhere, laid out as described above
+template <typename T>
+void PayoffTensor<T>::attach(const T* external, const vector<int> &nS)
+{
+	setDimensions(nS);
+	storage.clear();
+	storage.shrink_to_fit();
+	payoffs = external;
+}
+
+// matrix holding profile; the same as simGame::hash() for games that aren't impartial
+template <typename T>
+size_t PayoffTensor<T>::matrixIndex(const vector<int> &profile) const
+{
+	size_t m = 0, stride = 1;
+	for (int x = 2; x < numPlayers; x++)
+	{
+		m += stride * profile.at(x);
+		stride *= numStrats.at(x);
+	}
+	return m;
+}
+
+// P_x's payoff in profile
+template <typename T>
+T PayoffTensor<T>::payoff(const vector<int> &profile, int x) const
+{
+	return payoffs[offset(matrixIndex(profile), profile.at(0), profile.at(1)) + x];
+}
+
+// owned, zeroed payoffs for a game where P_x has nS.at(x) strategies
+template <typename T>
+void PayoffTensor<T>::reset(const vector<int> &nS)
+{
+	setDimensions(nS);
+	storage.assign(size(), T());
+	payoffs = storage.empty() ? NULL : &storage[0];
+}
+
+// exchanges contents without copying payoffs; owned payoffs keep their addresses
+template <typename T>
+void PayoffTensor<T>::swap(PayoffTensor &t)
+{
+	std::swap(numPlayers, t.numPlayers);
+	numStrats.swap(t.numStrats);
+	std::swap(numMatrices, t.numMatrices);
+	std::swap(numOutcomes, t.numOutcomes);
+	storage.swap(t.storage);
+	std::swap(payoffs, t.payoffs);
+}
+
+#endif
@@ -30,11 +30,8 @@ class Player
 		Knowledge* knowledge;
 		Polynomial* preference;
 		
-		~Player() 							{ delete preference; }
 		int getKChoice() const 				{ return kChoice; }
 		void printPlayer() const 			{ cout << this; }
-		Polynomial* getPreference() const 	{ return preference; }
-		void setPreference(Polynomial* p) 	{ preference = p; }
 		
 		friend ostream& operator << (ostream& os, const Player& p)
 		{
@@ -64,16 +61,22 @@ class Player
 			rationality = r;
 			numStrats = n;
 			choice = s;
+			kChoice = -1;
+			knowledge = NULL;
 			preference = p;
 		}
 		
+		~Player() 					{ delete knowledge; delete preference; }
+		
 		int getChoice() const		{ return choice; }
 		Knowledge* getKnowledge()	{ return knowledge; }
 		int getNumStrats() const	{ return numStrats; }
+		Polynomial* getPreference() const 	{ return preference; }
 		int getRationality() const	{ return rationality; }
 		void setChoice(int c)		{ choice = c; }
 		void setKChoice(int c)		{ kChoice = c; }
 		void setNumStrats(int n)	{ numStrats = n; }
+		void setPreference(Polynomial* p) 	{ preference = p; }
 		void setRationality(int r)	{ rationality = r; }
 };
 
@@ -20,11 +20,17 @@ Purpose: for holding EU's
 #include <algorithm>
 #include <cmath>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <sstream>
 using namespace std;
 
+class PolynomialBuilder;
+
 // polynomials of the form [coefficient, exponents] -> ... -> [coefficient, exponents]
 class Polynomial
 {
@@ -36,6 +42,11 @@ class Polynomial
 		int totalDegree = -1;
 		vector<vector<Polynomial*> > derivatives;
 		bool linear;
+		
+		void copyTerms(const Polynomial &);
+		void deleteTerms();
+		
+		friend class PolynomialBuilder;
 	public:		
 		double getCoefficient(int i) const 				{ return getTerm(i)->coefficient; }
 		vector<vector<Polynomial*> > getDerivatives() 	{ return derivatives; }
@@ -58,11 +69,10 @@ class Polynomial
 		Polynomial();
 		Polynomial(int, int, int);
 		Polynomial(string);
+		Polynomial(const Polynomial &);
 		~Polynomial();
 		
-		Polynomial* operator+(const Polynomial &p);
-		Polynomial operator*(const Polynomial &p);
-		Polynomial* operator-(const Polynomial &p);
+		Polynomial& operator=(const Polynomial &p);
 		bool operator==(const Polynomial &p);
 		bool operator!=(const Polynomial &p);
 		bool operator<(const Polynomial &p);
@@ -95,8 +105,117 @@ class Polynomial
 		void simplify();
 		vector<string> split(string, const char);
 		void tokenize(string const &, const char, vector<string> &);
+		
+		bool parse(const char*, const char*, int = 0);
+		string toString() const;
+		static bool readPolynomials(string, vector<Polynomial*> &, int = 0);
+		static bool writePolynomials(string, const vector<Polynomial*> &, const vector<string> & = vector<string>());
 };
 
+/****************************************************************************
+collects terms in flat arrays, then combines like terms, drops zero terms,
+and links the result into a Polynomial in lexicographic order in one pass
+****************************************************************************/
+class PolynomialBuilder
+{
+	private:
+		int numVariables;
+		vector<double> coefficients;
+		vector<int> exponents; // numVariables per term
+		
+		bool greaterExponents(int, int) const;
+		bool sameExponents(int, int) const;
+	public:
+		PolynomialBuilder(int nV, int reserveTerms = 0)
+		{
+			numVariables = nV;
+			coefficients.reserve(reserveTerms);
+			exponents.reserve(reserveTerms * nV);
+		}
+		
+		int getNumTerms() const { return coefficients.size(); }
+		void clear() 			{ coefficients.clear(); exponents.clear(); }
+		
+		void addTerm(double, const int*, int);
+		void addTerm(double c, const vector<int> &e) { addTerm(c, e.empty() ? NULL : &e[0], e.size()); }
+		
+		void build(Polynomial &) const;
+};
+
+// append a term, padding or truncating its exponents to numVariables
+void PolynomialBuilder::addTerm(double c, const int* e, int n)
+{
+	coefficients.push_back(c);
+	for (int v = 0; v < numVariables; v++)
+		exponents.push_back(v < n ? e[v] : 0);
+}
+
+// lexicographic order: the first differing exponent is larger
+bool PolynomialBuilder::greaterExponents(int a, int b) const
+{
+	for (int v = 0; v < numVariables; v++)
+	{
+		if (exponents[a * numVariables + v] != exponents[b * numVariables + v])
+			return exponents[a * numVariables + v] > exponents[b * numVariables + v];
+	}
+	return false;
+}
+
+// whether terms a and b are like terms
+bool PolynomialBuilder::sameExponents(int a, int b) const
+{
+	return equal(exponents.begin() + a * numVariables, exponents.begin() + (a + 1) * numVariables, exponents.begin() + b * numVariables);
+}
+
+// orders the collected terms, sums like terms, and replaces p's terms with the result
+void PolynomialBuilder::build(Polynomial &p) const
+{
+	int n = coefficients.size();
+	vector<int> order = vector<int>(n);
+	for (int t = 0; t < n; t++)
+		order.at(t) = t;
+	
+	// like terms end up adjacent, in the order they were added, so they're summed in that order
+	stable_sort(order.begin(), order.end(), [this](int a, int b) { return greaterExponents(a, b); });
+	
+	p.deleteTerms();
+	p.numVariables = numVariables;
+	p.numTerms = 0;
+	p.totalDegree = 0;
+	
+	int t = 0;
+	while (t < n)
+	{
+		int first = order.at(t);
+		double sum = 0.0;
+		while (t < n && sameExponents(first, order.at(t)))
+		{
+			sum += coefficients.at(order.at(t));
+			t++;
+		}
+		if (sum != 0)
+		{
+			vector<int> e(exponents.begin() + first * numVariables, exponents.begin() + (first + 1) * numVariables);
+			int degree = 0;
+			for (int v = 0; v < numVariables; v++)
+				degree += e.at(v);
+			if (degree > p.totalDegree)
+				p.totalDegree = degree;
+			
+			p.appendTerm(sum, e);
+			p.numTerms++;
+		}
+	}
+	
+	// everything cancelled: the zero polynomial
+	if (p.numTerms == 0)
+	{
+		p.appendTerm(0.0, vector<int>(numVariables));
+		p.numTerms = 1;
+	}
+	p.linear = p.totalDegree <= 1;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// @brief default constructor
@@ -134,7 +253,6 @@ Polynomial::Polynomial(int nT, int nV, int var)
 		}
 		leading->next = NULL;
 		
-		trailing = new Term;
 		trailing = leading;
 		
 		totalDegree = 1;
@@ -234,78 +352,44 @@ vector<string> Polynomial::split(string str, const char c)
 	return subStrings;
 }
 
-/// @brief creates a polynomial of the form given in s
+/// @brief creates a polynomial of the form given in s, e.g., "3x^2 - x + 1" or "2x_1x_3^2 - x_2 + 4"
 /// @param s 
 Polynomial::Polynomial(string s)
 {
-	// removing spaces
-	s.erase(remove_if(s.begin(), s.end(), ::isspace), s.end());
-
-	// input validation
-	for (int i = 0; i < s.length(); i++)
-	{
-		if (isalpha(s[i]) && s[i] != 'x')
-		{
-			cout << "ERROR: input string must be of the form ax^n + bx^{n-1} + ... + yx + z" << endl;
-			delete this;
-			return;
-		}
-	}
-
-	// getting each term
-	vector<string> terms = split(s, '+');
-	numTerms = terms.size();
-
-	numVariables = 1;
-
-	// splitting over ^'s, components contains (cx, e)
-	vector<vector<string> > components;
-	for (auto t : terms)
-		components.push_back(split(t, '^'));
-
-	// saving in coeffs and exponents
-	vector<double> coeffs;
-	vector<int> exponents;
-	for (int i = 0; i < terms.size(); i++)
-	{
-		vector<string> pair = split(components[i][0], 'x');
-		if (pair[0] == "")
-			coeffs.push_back(1.0);
-		else
-			coeffs.push_back(stod(pair[0]));
-
-		if (components[i].size() > 1)
-			exponents.push_back(stoi(components[i][1]));
-		else
-			exponents.push_back(1);
-	}
-
-	// building the polynomial
 	leading = NULL;
 	trailing = NULL;
+	linear = true;
+	
+	parse(s.c_str(), s.c_str() + s.length());
+}
 
-	for (int i = 0; i < numTerms; i++)
-	{
-		vector<int> temp(numTerms);
-		temp.at(0) = exponents.at(i);
-		this->appendTerm(coeffs.at(i), temp);
-	}
-
-	this->printPolynomial();
+/// @brief copy constructor
+/// @param p 
+Polynomial::Polynomial(const Polynomial &p)
+{
+	leading = NULL;
+	trailing = NULL;
+	copyTerms(p);
 }
 
 // destructor
 Polynomial::~Polynomial()
 {
-	Term* curTerm;
-	
-	curTerm = leading;
-	while (curTerm)
+	deleteTerms();
+}
+
+/// @brief assignment operator
+/// @param p 
+/// @return 
+Polynomial& Polynomial::operator=(const Polynomial &p)
+{
+	if (this != &p)
 	{
-		delete curTerm;
-		curTerm = curTerm->next;
+		deleteTerms();
+		copyTerms(p);
+		derivatives.clear();
 	}
-	delete this;
+	return *this;
 }
 
 /// @brief polynomial equality
@@ -378,6 +462,34 @@ void Polynomial::computeTotalDegree()
 	setTotalDegree(max);
 }
 
+// deep copy of p's terms and attributes; this must have no terms
+void Polynomial::copyTerms(const Polynomial &p)
+{
+	for (Term* curTerm = p.leading; curTerm; curTerm = curTerm->next)
+		appendTerm(curTerm->coefficient, curTerm->exponents);
+	
+	numTerms = p.numTerms;
+	numVariables = p.numVariables;
+	totalDegree = p.totalDegree;
+	linear = p.linear;
+}
+
+// frees every term
+void Polynomial::deleteTerms()
+{
+	Term* curTerm = leading;
+	Term* nextTerm;
+	
+	while (curTerm)
+	{
+		nextTerm = curTerm->next;
+		delete curTerm;
+		curTerm = nextTerm;
+	}
+	leading = NULL;
+	trailing = NULL;
+}
+
 // get derivative
 // FINISH: linear derivatives from nonlinear polynomials
 Polynomial* Polynomial::derivative(int var)
@@ -748,6 +860,162 @@ void Polynomial::lexOrder()
 	}
 }
 
+/// @brief replaces this polynomial with the one written in [first, last) in a single pass
+/// @param first start of the text, e.g., "3x^2 - x + 1" or "2x_1x_3^2 - x_{2} + 4"
+/// @param last one past the end of the text
+/// @param minVariables lower bound on numVariables, e.g., numPlayers for preferences
+/// @return false if the text is not a polynomial, in which case this is left empty
+bool Polynomial::parse(const char* first, const char* last, int minVariables)
+{
+	vector<double> coeffs; // one per term
+	vector<int> factorEnd; // one past each term's last factor
+	vector<int> vars, expos; // factors x_{var + 1}^{expo}
+	const char* p = first;
+	int maxVar = 0;
+	
+	deleteTerms();
+	numTerms = -1;
+	numVariables = -1;
+	totalDegree = -1;
+	derivatives.clear();
+	
+	while (p < last && isspace(*p))
+		p++;
+	if (p == last)
+	{
+		cout << "ERROR: empty polynomial" << endl;
+		return false;
+	}
+	
+	while (p < last)
+	{
+		// sign, required between terms
+		double sign = 1.0;
+		if (*p == '+' || *p == '-')
+		{
+			sign = *p == '-' ? -1.0 : 1.0;
+			p++;
+			while (p < last && isspace(*p))
+				p++;
+		}
+		else if (!coeffs.empty())
+		{
+			cout << "ERROR: expected + or - at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+			return false;
+		}
+		
+		// coefficient: copied into a small buffer so strtod stops at last and rounds exactly
+		double c = 1.0;
+		bool hasCoeff = false;
+		if (p < last && (isdigit(*p) || *p == '.'))
+		{
+			char buffer[64];
+			int len = 0;
+			while (p < last && len < 63 && (isdigit(*p) || *p == '.'))
+				buffer[len++] = *p++;
+			if (p + 1 < last && len < 61 && (*p == 'e' || *p == 'E') 
+				&& (isdigit(p[1]) || ((p[1] == '-' || p[1] == '+') && p + 2 < last && isdigit(p[2]))))
+			{
+				buffer[len++] = *p++;
+				buffer[len++] = *p++;
+				while (p < last && len < 63 && isdigit(*p))
+					buffer[len++] = *p++;
+			}
+			buffer[len] = '\0';
+			c = strtod(buffer, NULL);
+			hasCoeff = true;
+			while (p < last && (isspace(*p) || *p == '*'))
+				p++;
+		}
+		
+		// factors x, x_k, x_{k}, each with an optional ^e or ^{e}
+		int numFactors = 0;
+		while (p < last && *p == 'x')
+		{
+			int v = 1, e = 1;
+			p++;
+			if (p < last && *p == '_')
+			{
+				p++;
+				bool braced = p < last && *p == '{';
+				if (braced)
+					p++;
+				if (p == last || !isdigit(*p))
+				{
+					cout << "ERROR: expected a variable index at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+					return false;
+				}
+				for (v = 0; p < last && isdigit(*p); p++)
+					v = 10 * v + (*p - '0');
+				if (braced && (p == last || *p++ != '}'))
+				{
+					cout << "ERROR: expected } at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+					return false;
+				}
+				if (v < 1)
+				{
+					cout << "ERROR: variables are numbered from x_1 in \"" << string(first, last) << "\"" << endl;
+					return false;
+				}
+			}
+			while (p < last && isspace(*p))
+				p++;
+			if (p < last && *p == '^')
+			{
+				p++;
+				while (p < last && isspace(*p))
+					p++;
+				bool braced = p < last && *p == '{';
+				if (braced)
+					p++;
+				if (p == last || !isdigit(*p))
+				{
+					cout << "ERROR: expected a nonnegative exponent at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+					return false;
+				}
+				for (e = 0; p < last && isdigit(*p); p++)
+					e = 10 * e + (*p - '0');
+				if (braced && (p == last || *p++ != '}'))
+				{
+					cout << "ERROR: expected } at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+					return false;
+				}
+			}
+			vars.push_back(v - 1);
+			expos.push_back(e);
+			maxVar = max(maxVar, v);
+			numFactors++;
+			while (p < last && (isspace(*p) || *p == '*'))
+				p++;
+		}
+		
+		if (!hasCoeff && numFactors == 0)
+		{
+			if (p < last)
+				cout << "ERROR: unexpected '" << *p << "' at position " << p - first << " in \"" << string(first, last) << "\"" << endl;
+			else
+				cout << "ERROR: polynomial ends with a sign in \"" << string(first, last) << "\"" << endl;
+			return false;
+		}
+		coeffs.push_back(sign * c);
+		factorEnd.push_back(vars.size());
+	}
+	
+	// like terms are combined and the terms put in lexicographic order
+	int nV = max(max(maxVar, minVariables), 1);
+	PolynomialBuilder builder(nV, coeffs.size());
+	vector<int> alpha = vector<int>(nV);
+	for (int t = 0, f = 0; (unsigned)t < coeffs.size(); t++)
+	{
+		fill(alpha.begin(), alpha.end(), 0);
+		for (; f < factorEnd.at(t); f++)
+			alpha.at(vars.at(f)) += expos.at(f);
+		builder.addTerm(coeffs.at(t), alpha);
+	}
+	builder.build(*this);
+	return true;
+}
+
 // print polynomial
 void Polynomial::printPolynomial()
 {
@@ -808,8 +1076,6 @@ void Polynomial::printPolynomial()
 							if (getExponent(t, v) != 1)
 								cout << "^" << getExponent(t, v);
 					}
-					else
-						cout << "HERE";
 				}
 				
 				if (t < numTerms - 1 && oneMoreNonZero && getCoefficient(t + 1) >= 0) // && exists(a_k)[i < k <= n && a_k != 0]
@@ -901,6 +1167,61 @@ void Polynomial::printPolynomial(int player, int strat)
 	cout << endl;
 }
 
+/// @brief reads one polynomial per line; blank lines and lines starting with # are skipped
+/// @param filename 
+/// @param polys receives the polynomials, which the caller deletes
+/// @param minVariables passed to parse()
+/// @return false if the file can't be read or a line isn't a polynomial
+bool Polynomial::readPolynomials(string filename, vector<Polynomial*> &polys, int minVariables)
+{
+	ifstream file(filename.c_str(), ios::in | ios::binary);
+	if (!file)
+	{
+		cout << "ERROR: could not open " << filename << endl;
+		return false;
+	}
+	
+	// the whole file in one buffer; each line is parsed in place
+	string buffer;
+	file.seekg(0, ios::end);
+	buffer.resize(file.tellg());
+	file.seekg(0, ios::beg);
+	if (!buffer.empty())
+		file.read(&buffer[0], buffer.size());
+	file.close();
+	
+	const char* p = buffer.c_str();
+	const char* end = p + buffer.size();
+	polys.reserve(polys.size() + count(buffer.begin(), buffer.end(), '\n') + 1);
+	for (int line = 1; p < end; line++)
+	{
+		const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+		if (!lineEnd)
+			lineEnd = end;
+		
+		const char* q = p;
+		while (q < lineEnd && isspace(*q))
+			q++;
+		const char* last = lineEnd;
+		while (last > q && isspace(last[-1]))
+			last--;
+		
+		if (q < last && *q != '#')
+		{
+			Polynomial* poly = new Polynomial();
+			if (!poly->parse(q, last, minVariables))
+			{
+				cout << "ERROR: line " << line << " of " << filename << " is not a polynomial" << endl;
+				delete poly;
+				return false;
+			}
+			polys.push_back(poly);
+		}
+		p = lineEnd + 1;
+	}
+	return true;
+}
+
 // remove term
 void Polynomial::removeTerm(int &t)
 {	
@@ -1024,4 +1345,91 @@ void Polynomial::simplify()
 	this->lexOrder();
 }
 
+/// @brief text that parse() reads back to the same polynomial, e.g., "2x_1x_3^2 - x_2 + 4"
+/// @return 
+string Polynomial::toString() const
+{
+	string s;
+	char buffer[32];
+	
+	for (Term* curTerm = leading; curTerm; curTerm = curTerm->next)
+	{
+		double c = curTerm->coefficient;
+		if (c == 0)
+			continue;
+		
+		if (s.empty())
+		{
+			if (c < 0)
+				s += "-";
+		}
+		else
+			s += c < 0 ? " - " : " + ";
+		
+		bool constant = true;
+		for (int v = 0; (unsigned)v < curTerm->exponents.size(); v++)
+		{
+			if (curTerm->exponents.at(v) != 0)
+				constant = false;
+		}
+		
+		// shortest of 15 or 17 significant digits that reads back exactly
+		if (fabs(c) != 1 || constant)
+		{
+			snprintf(buffer, sizeof(buffer), "%.15g", fabs(c));
+			if (strtod(buffer, NULL) != fabs(c))
+				snprintf(buffer, sizeof(buffer), "%.17g", fabs(c));
+			s += buffer;
+		}
+		
+		for (int v = 0; (unsigned)v < curTerm->exponents.size(); v++)
+		{
+			if (curTerm->exponents.at(v) != 0)
+			{
+				s += "x";
+				if (numVariables > 1)
+				{
+					snprintf(buffer, sizeof(buffer), "_%d", v + 1);
+					s += buffer;
+				}
+				if (curTerm->exponents.at(v) != 1)
+				{
+					snprintf(buffer, sizeof(buffer), "^%d", curTerm->exponents.at(v));
+					s += buffer;
+				}
+			}
+		}
+	}
+	
+	if (s.empty() && leading)
+		s = "0";
+	return s;
+}
+
+/// @brief writes one polynomial per line in the format readPolynomials() reads
+/// @param filename 
+/// @param polys 
+/// @param labels optional, written as a # comment above each polynomial
+/// @return false if the file can't be written
+bool Polynomial::writePolynomials(string filename, const vector<Polynomial*> &polys, const vector<string> &labels)
+{
+	string buffer;
+	for (int n = 0; (unsigned)n < polys.size(); n++)
+	{
+		if ((unsigned)n < labels.size())
+			buffer += "# " + labels.at(n) + "\n";
+		buffer += polys.at(n)->toString() + "\n";
+	}
+	
+	ofstream file(filename.c_str(), ios::out | ios::binary);
+	if (!file)
+	{
+		cout << "ERROR: could not open " << filename << endl;
+		return false;
+	}
+	file.write(buffer.data(), buffer.size());
+	file.close();
+	return !file.fail();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,564 @@
+/*******************************
+Title: QuantalResponse.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: logit quantal response equilibria, their derivatives in the precision, and the branch of them traced from lambda = 0
+********************************/
+
+#ifndef QUANTALRESPONSE_H
+#define QUANTALRESPONSE_H
+#include "ExpectedUtility.h"
+#include "GameResults.h"
+#include "LinearSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+McKelvey and Palfrey's logit quantal response equilibrium (1995): every
+player plays s with probability proportional to exp(lambda * EU(s)), EU
+taken against the others' QRE strategies. At lambda = 0 play is uniform;
+as lambda grows, the principal branch of QREs approaches a Nash
+equilibrium. Profiles are vector<vector<double> >, profile.at(x).at(s)
+being the probability P_x plays s.
+******************************************************************************/
+
+/// @brief P_x's logit response to profile with precision lambda
+/// @param payoffs
+/// @param x
+/// @param lambda
+/// @param profile
+/// @param response receives one probability per strategy of P_x
+template <typename T>
+void logitResponse(const PayoffTensor<T> &payoffs, int x, double lambda, const vector<vector<double> > &profile, vector<double> &response)
+{
+	expectedPayoffs(payoffs, x, profile, response);
+	double best = response.at(0);
+	for (int s = 1; (unsigned)s < response.size(); s++)
+		best = max(best, response.at(s));
+
+	double sum = 0.0;
+	for (int s = 0; (unsigned)s < response.size(); s++)
+	{
+		response.at(s) = exp(lambda * (response.at(s) - best)); // at most 1, so it can't overflow
+		sum += response.at(s);
+	}
+	for (int s = 0; (unsigned)s < response.size(); s++)
+		response.at(s) /= sum;
+}
+
+/// @brief the uniform profile, the QRE at lambda = 0
+/// @param payoffs
+template <typename T>
+vector<vector<double> > uniformProfile(const PayoffTensor<T> &payoffs)
+{
+	vector<vector<double> > profile = vector<vector<double> >(payoffs.getNumPlayers());
+	for (int x = 0; x < payoffs.getNumPlayers(); x++)
+		profile.at(x).assign(payoffs.getNumStrats(x), 1.0 / payoffs.getNumStrats(x));
+	return profile;
+}
+
+/// @brief every player's logit response to profile and the largest difference between the two
+/// @param payoffs
+/// @param lambda
+/// @param profile
+/// @param responses receives the responses
+template <typename T>
+double qreResidual(const PayoffTensor<T> &payoffs, double lambda, const vector<vector<double> > &profile, vector<vector<double> > &responses)
+{
+	double residual = 0.0;
+	responses.resize(payoffs.getNumPlayers());
+	for (int x = 0; x < payoffs.getNumPlayers(); x++)
+	{
+		logitResponse(payoffs, x, lambda, profile, responses.at(x));
+		for (int s = 0; (unsigned)s < responses.at(x).size(); s++)
+			residual = max(residual, fabs(responses.at(x).at(s) - profile.at(x).at(s)));
+	}
+	return residual;
+}
+
+/******************************************************************************
+Along a branch of QREs, d(profile)/d(lambda) solves (I - J) d = b, where
+b_xs = p_xs (EU_x(s) - EU_x) and J, the derivative of the logit responses in
+the others' probabilities, has J_xs,yu = lambda p_xs (EU_x(s | u) -
+sum_t p_xt EU_x(t | u)), EU_x(s | u) being P_x's payoff from s when P_y
+plays u. I - J is singular only where the branch turns back or bifurcates.
+******************************************************************************/
+
+/// @brief I - J and b at (lambda, profile), the rows and columns going through P_1's strategies, then P_2's, and so on
+/// @param payoffs
+/// @param lambda
+/// @param profile
+/// @param A receives I - J, row-major
+/// @param b receives b
+template <typename T>
+void qreSystem(const PayoffTensor<T> &payoffs, double lambda, const vector<vector<double> > &profile, vector<double> &A, vector<double> &b)
+{
+	int nP = payoffs.getNumPlayers(), N = 0;
+	vector<int> first = vector<int>(nP); // each player's first row in the system
+	for (int x = 0; x < nP; x++)
+	{
+		first.at(x) = N;
+		N += payoffs.getNumStrats(x);
+	}
+
+	A.assign((size_t)N * N, 0.0);
+	b.assign(N, 0.0);
+	for (int i = 0; i < N; i++)
+		A[(size_t)i * N + i] = 1.0;
+
+	vector<double> utilities;
+	vector<vector<double> > conditional = profile;
+	for (int x = 0; x < nP; x++)
+	{
+		const vector<double> &p = profile.at(x);
+		expectedPayoffs(payoffs, x, profile, utilities);
+		double average = 0.0;
+		for (int s = 0; (unsigned)s < p.size(); s++)
+			average += p.at(s) * utilities.at(s);
+		for (int s = 0; (unsigned)s < p.size(); s++)
+			b.at(first.at(x) + s) = p.at(s) * (utilities.at(s) - average);
+
+		for (int y = 0; y < nP; y++)
+		{
+			if (y == x)
+				continue;
+			for (int u = 0; u < payoffs.getNumStrats(y); u++)
+			{
+				conditional.at(y).assign(payoffs.getNumStrats(y), 0.0);
+				conditional.at(y).at(u) = 1.0;
+				expectedPayoffs(payoffs, x, conditional, utilities);
+				average = 0.0;
+				for (int t = 0; (unsigned)t < p.size(); t++)
+					average += p.at(t) * utilities.at(t);
+				for (int s = 0; (unsigned)s < p.size(); s++)
+					A[(size_t)(first.at(x) + s) * N + first.at(y) + u] -= lambda * p.at(s) * (utilities.at(s) - average);
+			}
+			conditional.at(y) = profile.at(y);
+		}
+	}
+}
+
+/// @brief the derivative of the QRE in lambda at (lambda, profile)
+/// @param payoffs
+/// @param lambda
+/// @param profile a QRE at lambda
+/// @param derivative receives d(profile.at(x).at(s))/d(lambda)
+/// @return false if I - J is singular
+template <typename T>
+bool qreDerivative(const PayoffTensor<T> &payoffs, double lambda, const vector<vector<double> > &profile, vector<vector<double> > &derivative)
+{
+	vector<double> A, b;
+	qreSystem(payoffs, lambda, profile, A, b);
+	int N = b.size();
+	vector<double> d = vector<double>(N);
+	LinearSolver<double> solver(N);
+	if (!solver.solve(N, &A[0], &b[0], &d[0]))
+		return false;
+	derivative = profile;
+	for (int x = 0, i = 0; x < (int)profile.size(); x++)
+		for (int s = 0; (unsigned)s < profile.at(x).size(); s++, i++)
+			derivative.at(x).at(s) = d.at(i);
+	return true;
+}
+
+/// @brief the logit QRE at lambda from profile: damped fixed-point iteration, then Newton's method on
+/// profile - response(profile) if that stalls
+/// @param payoffs
+/// @param lambda
+/// @param profile the starting point, e.g., the QRE at a nearby lambda; receives the QRE
+/// @param tolerance on the largest change in a probability
+/// @param maxIterations of each method
+/// @return false if it didn't converge, in which case profile is the last iterate
+template <typename T>
+bool logitQRE(const PayoffTensor<T> &payoffs, double lambda, vector<vector<double> > &profile, double tolerance = 1e-10, int maxIterations = 10000)
+{
+	int nP = payoffs.getNumPlayers();
+	vector<vector<double> > responses = vector<vector<double> >(nP);
+	double damping = 1.0, previous = HUGE_VAL, residual = 0.0;
+
+	// the iteration converges quickly where the QRE is stable and lambda is small
+	int numFixedPoint = min(maxIterations, 200);
+	for (int n = 0; n <= numFixedPoint; n++)
+	{
+		residual = qreResidual(payoffs, lambda, profile, responses);
+		if (residual < tolerance)
+			return true;
+		if (n == numFixedPoint)
+			break;
+		if (residual > previous && damping > 1.0 / 1024)
+			damping /= 2;
+		previous = residual;
+
+		for (int x = 0; x < nP; x++)
+			for (int s = 0; (unsigned)s < responses.at(x).size(); s++)
+				profile.at(x).at(s) += damping * (responses.at(x).at(s) - profile.at(x).at(s));
+	}
+
+	vector<double> A, b, step;
+	vector<vector<double> > next = profile, nextResponses = responses;
+	for (int n = 0; n < maxIterations; n++)
+	{
+		qreSystem(payoffs, lambda, profile, A, b);
+		int N = b.size();
+		for (int x = 0, i = 0; x < nP; x++)
+			for (int s = 0; (unsigned)s < responses.at(x).size(); s++, i++)
+				b.at(i) = responses.at(x).at(s) - profile.at(x).at(s);
+		step.assign(N, 0.0);
+		LinearSolver<double> solver(N);
+		if (!solver.solve(N, &A[0], &b[0], &step[0]))
+			return false;
+
+		// halve the step until it stays inside the simplex and shrinks the residual
+		double t = 1.0, nextResidual = HUGE_VAL;
+		for (; t > 1e-10; t /= 2)
+		{
+			bool inside = true;
+			for (int x = 0, i = 0; x < nP; x++)
+				for (int s = 0; (unsigned)s < profile.at(x).size(); s++, i++)
+				{
+					next.at(x).at(s) = profile.at(x).at(s) + t * step.at(i);
+					inside = inside && next.at(x).at(s) > 0.0;
+				}
+			if (!inside)
+				continue;
+			nextResidual = qreResidual(payoffs, lambda, next, nextResponses);
+			if (nextResidual < residual)
+				break;
+		}
+		if (!(nextResidual < residual))
+			return false;
+		profile.swap(next);
+		responses.swap(nextResponses);
+		residual = nextResidual;
+		if (residual < tolerance)
+			return true;
+	}
+	return false;
+}
+
+/******************************************************************************
+traceLogitQRE() follows the principal branch, the QREs connected to the
+uniform profile at lambda = 0, by pseudo-arclength continuation. A point is
+(w, lambda), w being the log probabilities, and the branch is where, for
+each player x,
+	w_xs - w_x1 = lambda (EU_x(s) - EU_x(1)) 	for s > 1
+	sum_s exp(w_xs) = 1
+Log probabilities keep their precision as strategies lose probability, and
+measuring steps along the curve rather than in lambda lets the branch turn
+back where it bends. A step along the tangent predicts the next point, and
+Newton's method on the equations, kept on the hyperplane through the
+prediction normal to the tangent, corrects it. Steps double while the
+corrector converges quickly and halve when it doesn't or the tangent turns
+too sharply to trust, so they grow without limit once the branch has
+settled. The branch is generically unique, which makes the equilibrium it
+approaches a selection, found even where best responses cycle: the
+strategies left with almost no probability at the end are dropped, and the
+equilibrium is polished on the rest.
+******************************************************************************/
+
+/// @brief the most any player gains by deviating from profile
+/// @param payoffs
+/// @param profile
+template <typename T>
+double regret(const PayoffTensor<T> &payoffs, const vector<vector<double> > &profile)
+{
+	double most = 0.0;
+	vector<double> utilities;
+	for (int x = 0; x < payoffs.getNumPlayers(); x++)
+	{
+		expectedPayoffs(payoffs, x, profile, utilities);
+		double average = 0.0, best = utilities.at(0);
+		for (int s = 0; (unsigned)s < utilities.size(); s++)
+		{
+			average += profile.at(x).at(s) * utilities.at(s);
+			best = max(best, utilities.at(s));
+		}
+		most = max(most, best - average);
+	}
+	return most;
+}
+
+/// @brief the Nash equilibrium near a QRE at a large lambda: the strategies with less than cutoff are dropped,
+/// and Newton's method equalizes each player's payoffs from the rest
+/// @param payoffs
+/// @param profile
+/// @param cutoff
+/// @return the polished profile, or the one with strategies dropped if Newton's method fails
+template <typename T>
+vector<vector<double> > nearestEquilibrium(const PayoffTensor<T> &payoffs, const vector<vector<double> > &profile, double cutoff = 1e-4)
+{
+	int nP = payoffs.getNumPlayers(), N = 0;
+	vector<vector<double> > rounded = profile;
+	vector<vector<int> > supports = vector<vector<int> >(nP);
+	for (int x = 0; x < nP; x++)
+	{
+		double sum = 0.0;
+		for (int s = 0; (unsigned)s < rounded.at(x).size(); s++)
+		{
+			if (rounded.at(x).at(s) < cutoff)
+				rounded.at(x).at(s) = 0.0;
+			else
+				supports.at(x).push_back(s);
+			sum += rounded.at(x).at(s);
+		}
+		if (supports.at(x).empty())
+			return profile;
+		for (int s = 0; (unsigned)s < rounded.at(x).size(); s++)
+			rounded.at(x).at(s) /= sum;
+		N += supports.at(x).size();
+	}
+
+	// each player's probabilities sum to 1, and each of their strategies in the support pays what the first does
+	vector<vector<double> > polished = rounded, conditional;
+	vector<double> A, F = vector<double>(N), delta = vector<double>(N), utilities;
+	LinearSolver<double> solver(N);
+	for (int n = 0; n < 20; n++)
+	{
+		A.assign((size_t)N * N, 0.0);
+		double residual = 0.0;
+		for (int x = 0, row = 0; x < nP; x++)
+		{
+			const vector<int> &S = supports.at(x);
+			expectedPayoffs(payoffs, x, polished, utilities);
+			F.at(row) = -1.0;
+			for (int a = 0; (unsigned)a < S.size(); a++)
+				F.at(row) += polished.at(x).at(S.at(a));
+			for (int a = 1; (unsigned)a < S.size(); a++)
+				F.at(row + a) = utilities.at(S.at(a)) - utilities.at(S.at(0));
+			for (int a = 0; (unsigned)a < S.size(); a++)
+				residual = max(residual, fabs(F.at(row + a)));
+
+			for (int y = 0, column = 0; y < nP; y++)
+			{
+				for (int c = 0; (unsigned)c < supports.at(y).size(); c++, column++)
+				{
+					if (y == x)
+					{
+						A[(size_t)row * N + column] = 1.0;
+						continue;
+					}
+					conditional = polished;
+					conditional.at(y).assign(payoffs.getNumStrats(y), 0.0);
+					conditional.at(y).at(supports.at(y).at(c)) = 1.0;
+					expectedPayoffs(payoffs, x, conditional, utilities);
+					for (int a = 1; (unsigned)a < S.size(); a++)
+						A[(size_t)(row + a) * N + column] = utilities.at(S.at(a)) - utilities.at(S.at(0));
+				}
+			}
+			row += S.size();
+		}
+		if (residual < 1e-12)
+			break;
+
+		for (int i = 0; i < N; i++)
+			F.at(i) = -F.at(i);
+		if (!solver.solve(N, &A[0], &F[0], &delta[0]))
+			return rounded;
+		for (int x = 0, i = 0; x < nP; x++)
+			for (int a = 0; (unsigned)a < supports.at(x).size(); a++, i++)
+				polished.at(x).at(supports.at(x).at(a)) += delta.at(i);
+	}
+
+	// the polished profile must still be a profile and no worse an equilibrium
+	for (int x = 0; x < nP; x++)
+		for (int s = 0; (unsigned)s < polished.at(x).size(); s++)
+		{
+			if (polished.at(x).at(s) < 0.0)
+				return rounded;
+		}
+	return regret(payoffs, polished) <= regret(payoffs, rounded) ? polished : rounded;
+}
+
+/// @brief traces the principal branch of logit QREs from lambda = 0 to maxLambda and finds the equilibrium it approaches
+/// @param payoffs
+/// @param maxLambda
+/// @param maxSteps
+/// @return the points along the branch, the number of turning points, and the equilibrium and its regret; the status
+/// is an error if the branch couldn't be followed to maxLambda and hadn't yet come to an equilibrium
+template <typename T>
+QREPathResult traceLogitQRE(const PayoffTensor<T> &payoffs, double maxLambda = 1e6, int maxSteps = 10000)
+{
+	QREPathResult result;
+	int nP = payoffs.getNumPlayers(), N = 0;
+	vector<int> first = vector<int>(nP); // each player's first row and column
+	for (int x = 0; x < nP; x++)
+	{
+		first.at(x) = N;
+		N += payoffs.getNumStrats(x);
+	}
+
+	// a point is w, P_1's log probabilities first, then lambda
+	vector<double> point = vector<double>(N + 1), tangent = vector<double>(N + 1, 0.0), predicted = vector<double>(N + 1);
+	vector<double> trial = vector<double>(N + 1), nextTangent = vector<double>(N + 1), delta = vector<double>(N + 1);
+	vector<double> M = vector<double>((size_t)(N + 1) * (N + 1)), F = vector<double>(N + 1), rhs = vector<double>(N + 1);
+	vector<vector<double> > profile = uniformProfile(payoffs), conditional;
+	vector<double> utilities, conditionalUtilities;
+	LinearSolver<double> solver(N + 1);
+
+	// profile = exp(w) at z, F = the equations' values at z, with tangent . (z - predicted) last, and M = their Jacobian
+	function<bool(const vector<double> &)> buildSystem = [&](const vector<double> &z)
+	{
+		double lambda = z.at(N);
+		for (int x = 0; x < nP; x++)
+			for (int s = 0; (unsigned)s < profile.at(x).size(); s++)
+			{
+				if (!isfinite(z.at(first.at(x) + s)))
+					return false;
+				profile.at(x).at(s) = exp(z.at(first.at(x) + s));
+			}
+
+		fill(M.begin(), M.end(), 0.0);
+		for (int x = 0; x < nP; x++)
+		{
+			int row = first.at(x), n = profile.at(x).size();
+			expectedPayoffs(payoffs, x, profile, utilities);
+			F.at(row) = -1.0;
+			for (int s = 0; s < n; s++)
+			{
+				F.at(row) += profile.at(x).at(s);
+				M[(size_t)row * (N + 1) + row + s] = profile.at(x).at(s);
+			}
+			for (int s = 1; s < n; s++)
+			{
+				F.at(row + s) = z.at(row + s) - z.at(row) - lambda * (utilities.at(s) - utilities.at(0));
+				M[(size_t)(row + s) * (N + 1) + row + s] = 1.0;
+				M[(size_t)(row + s) * (N + 1) + row] = -1.0;
+				M[(size_t)(row + s) * (N + 1) + N] = -(utilities.at(s) - utilities.at(0));
+			}
+
+			conditional = profile;
+			for (int y = 0; y < nP; y++)
+			{
+				if (y == x)
+					continue;
+				for (int u = 0; (unsigned)u < profile.at(y).size(); u++)
+				{
+					conditional.at(y).assign(profile.at(y).size(), 0.0);
+					conditional.at(y).at(u) = 1.0;
+					expectedPayoffs(payoffs, x, conditional, conditionalUtilities);
+					for (int s = 1; s < n; s++)
+						M[(size_t)(row + s) * (N + 1) + first.at(y) + u] = -lambda * profile.at(y).at(u)
+							* (conditionalUtilities.at(s) - conditionalUtilities.at(0));
+				}
+				conditional.at(y) = profile.at(y);
+			}
+		}
+
+		F.at(N) = 0.0;
+		for (int i = 0; i <= N; i++)
+		{
+			M[(size_t)N * (N + 1) + i] = tangent.at(i);
+			F.at(N) += tangent.at(i) * (z.at(i) - predicted.at(i));
+		}
+		return true;
+	};
+	// the unit tangent at the point buildSystem() was last given, pointing the same way as tangent
+	function<bool(vector<double> &)> findTangent = [&](vector<double> &t)
+	{
+		rhs.assign(N + 1, 0.0);
+		rhs.at(N) = 1.0;
+		if (!solver.solve(N + 1, &M[0], &rhs[0], &t[0]))
+			return false;
+		double norm = 0.0;
+		for (int i = 0; i <= N; i++)
+			norm += t.at(i) * t.at(i);
+		for (int i = 0; i <= N; i++)
+			t.at(i) /= sqrt(norm);
+		return true;
+	};
+
+	// the branch leaves the uniform profile toward higher lambda
+	for (int x = 0; x < nP; x++)
+		for (int s = 0; (unsigned)s < profile.at(x).size(); s++)
+			point.at(first.at(x) + s) = log(profile.at(x).at(s));
+	point.at(N) = 0.0;
+	tangent.at(N) = 1.0;
+	predicted = point;
+	buildSystem(point);
+	findTangent(tangent);
+	result.lambdas.push_back(0.0);
+	result.profiles.push_back(profile);
+
+	double h = 0.1;
+	for (int step = 0; point.at(N) < maxLambda; step++)
+	{
+		if (step == maxSteps)
+		{
+			result.status = GameStatus("the branch was still short of lambda = " + to_string(maxLambda) + " after "
+				+ to_string(maxSteps) + " steps");
+			break;
+		}
+		if (h < 1e-12)
+		{
+			result.status = GameStatus("the branch couldn't be followed past lambda = " + to_string(point.at(N)));
+			break;
+		}
+
+		// predict, then correct on the hyperplane through the prediction normal to the tangent
+		for (int i = 0; i <= N; i++)
+			predicted.at(i) = trial.at(i) = point.at(i) + h * tangent.at(i);
+		bool converged = false;
+		int n = 0;
+		for (; n < 8 && !converged; n++)
+		{
+			if (!buildSystem(trial))
+				break;
+			for (int i = 0; i <= N; i++)
+				rhs.at(i) = -F.at(i);
+			if (!solver.solve(N + 1, &M[0], &rhs[0], &delta[0]))
+				break;
+
+			// rounding errors in w grow with lambda
+			converged = true;
+			for (int i = 0; i <= N; i++)
+			{
+				trial.at(i) += delta.at(i);
+				converged = converged && fabs(delta.at(i)) < 1e-10 * max(max(1.0, fabs(trial.at(i))), trial.at(N));
+			}
+		}
+
+		// the tangent at the new point, which must not turn too sharply from the last
+		double cosine = 0.0;
+		if (converged)
+			converged = buildSystem(trial) && findTangent(nextTangent);
+		for (int i = 0; converged && i <= N; i++)
+			cosine += nextTangent.at(i) * tangent.at(i);
+		if (!converged || cosine < 0.9)
+		{
+			h /= 2;
+			continue;
+		}
+
+		if ((nextTangent.at(N) < 0.0) != (tangent.at(N) < 0.0))
+			result.numTurningPoints++;
+		point.swap(trial);
+		tangent.swap(nextTangent);
+		result.lambdas.push_back(point.at(N));
+		result.profiles.push_back(profile);
+		if (n <= 3)
+			h *= 2;
+	}
+
+	result.equilibrium = nearestEquilibrium(payoffs, result.profiles.back());
+	result.regret = regret(payoffs, result.equilibrium);
+	if (!result.status.ok)
+	{
+		// being stuck doesn't matter once the branch is at an equilibrium
+		double scale = 1.0, distance = 0.0;
+		for (size_t i = 0; i < payoffs.getNumOutcomes() * nP; i++)
+			scale = max(scale, fabs((double)payoffs.data()[i]));
+		for (int x = 0; x < nP; x++)
+			for (int s = 0; (unsigned)s < profile.at(x).size(); s++)
+				distance = max(distance, fabs(result.profiles.back().at(x).at(s) - result.equilibrium.at(x).at(s)));
+		if (result.regret < 1e-9 * scale && distance < 1e-3)
+			result.status = GameStatus();
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*******************************
+Title: RandomPayoffs.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: reproducible random payoffs from a counter-based generator, drawn in parallel
+********************************/
+
+#ifndef RANDOMPAYOFFS_H
+#define RANDOMPAYOFFS_H
+#include "GameResults.h"
+#include "PayoffTensor.h"
+
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3",
+2011): four 32-bit words that are a bijection of a 128-bit counter under a
+64-bit key. Nothing is carried from one draw to the next, so any draw can be
+made by any thread in any order and still be the same.
+******************************************************************************/
+class Philox4x32
+{
+	private:
+		uint32_t key[2];
+	public:
+		Philox4x32(uint64_t k) { key[0] = (uint32_t)k; key[1] = (uint32_t)(k >> 32); }
+
+		void generate(const uint32_t*, uint32_t*) const;
+};
+
+/// @brief the four words for counter
+/// @param counter 4 words
+/// @param words 4 words
+void Philox4x32::generate(const uint32_t* counter, uint32_t* words) const
+{
+	uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+	uint32_t k0 = key[0], k1 = key[1];
+	for (int round = 0; round < 10; round++)
+	{
+		if (round > 0)
+		{
+			k0 += 0x9E3779B9;
+			k1 += 0xBB67AE85;
+		}
+		uint64_t p0 = (uint64_t)0xD2511F53 * c0, p1 = (uint64_t)0xCD9E8D57 * c2;
+		uint32_t hi0 = p0 >> 32, lo0 = (uint32_t)p0, hi1 = p1 >> 32, lo1 = (uint32_t)p1;
+		c0 = hi1 ^ c1 ^ k0;
+		c1 = lo1;
+		c2 = hi0 ^ c3 ^ k1;
+		c3 = lo0;
+	}
+	words[0] = c0;
+	words[1] = c1;
+	words[2] = c2;
+	words[3] = c3;
+}
+
+/******************************************************************************
+the draws for one index (e.g., one outcome) of one stream under one seed: the
+counter is (index, stream, block), and block counts up as words are used, so
+the draws for an index never depend on how many another index used
+******************************************************************************/
+class RandomStream
+{
+	private:
+		Philox4x32 philox;
+		uint32_t counter[4];
+		uint32_t words[4];
+		int numUsed; // of words
+		double spareNormal;
+		bool hasSpare;
+	public:
+		RandomStream(uint64_t seed, uint32_t stream, uint64_t index) : philox(seed)
+		{
+			counter[0] = (uint32_t)index;
+			counter[1] = (uint32_t)(index >> 32);
+			counter[2] = stream;
+			counter[3] = 0;
+			numUsed = 4;
+			hasSpare = false;
+		}
+
+		uint32_t next();
+		double normal();
+		double uniform();
+		long long uniformInteger(long long, long long);
+};
+
+// the next 32 random bits
+uint32_t RandomStream::next()
+{
+	if (numUsed == 4)
+	{
+		philox.generate(counter, words);
+		counter[3]++;
+		numUsed = 0;
+	}
+	return words[numUsed++];
+}
+
+// standard normal, by the Box-Muller transform; each pair of uniforms gives two
+double RandomStream::normal()
+{
+	if (hasSpare)
+	{
+		hasSpare = false;
+		return spareNormal;
+	}
+	double radius = sqrt(-2.0 * log(1.0 - uniform())); // 1 - uniform() is never 0
+	double angle = 6.283185307179586 * uniform();
+	spareNormal = radius * sin(angle);
+	hasSpare = true;
+	return radius * cos(angle);
+}
+
+// in [0, 1), with 53 random bits
+double RandomStream::uniform()
+{
+	uint64_t bits = ((uint64_t)next() << 32) | next();
+	return (bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/// @brief uniform from lo to hi, inclusive, without modulo bias (Lemire's multiply-and-reject)
+/// @param lo
+/// @param hi at least lo
+long long RandomStream::uniformInteger(long long lo, long long hi)
+{
+	uint64_t range = (uint64_t)hi - (uint64_t)lo + 1; // 0 if every long long is possible
+	if (range == 0)
+		return (long long)(((uint64_t)next() << 32) | next());
+	if (range > 0xFFFFFFFFULL)
+	{
+		// the bias is at most range / 2^64
+		uint64_t bits = ((uint64_t)next() << 32) | next();
+		return lo + (long long)(bits % range);
+	}
+
+	uint32_t r = (uint32_t)range;
+	uint64_t product = (uint64_t)next() * r;
+	if ((uint32_t)product < r)
+	{
+		uint32_t threshold = (0 - r) % r;
+		while ((uint32_t)product < threshold)
+			product = (uint64_t)next() * r;
+	}
+	return lo + (long long)(product >> 32);
+}
+
+/// @brief checks options before any payoffs are drawn
+/// @param options
+/// @return the first problem
+inline GameStatus checkRandomOptions(const RandGameOptions &options)
+{
+	if (options.numStrats.size() < 2)
+		return GameStatus("a game needs at least 2 players");
+	for (int x = 0; (unsigned)x < options.numStrats.size(); x++)
+	{
+		if (options.numStrats.at(x) < 1)
+			return GameStatus("P_" + to_string(x + 1) + " needs at least 1 strategy");
+	}
+	if (options.randomRationalities && (options.maxRationality < 0 || options.maxRationality > MAX_RATIONALITY))
+		return GameStatus("random rationalities are from L_0 to at most L_" + to_string(MAX_RATIONALITY));
+	if (options.distribution == UNIFORM_PAYOFFS && options.maxPayoff < options.minPayoff)
+		return GameStatus("the maximum payoff is less than the minimum payoff");
+	if (options.distribution != UNIFORM_PAYOFFS && !(options.standardDeviation >= 0.0))
+		return GameStatus("the standard deviation is negative");
+	if (options.distribution == COVARIANT_PAYOFFS)
+	{
+		double least = -1.0 / (options.numStrats.size() - 1);
+		if (!(options.covariance >= least && options.covariance <= 1.0))
+			return GameStatus("the covariance must be from " + to_string(least) + " to 1 for "
+				+ to_string(options.numStrats.size()) + " players");
+	}
+	return GameStatus();
+}
+
+/// @brief the seed options asks for, or one from the clock if it's 0
+/// @param options
+inline unsigned long long randomSeed(const RandGameOptions &options)
+{
+	return options.seed ? options.seed : (unsigned long long)time(NULL);
+}
+
+// value rounded if T is an integer type
+template <typename T>
+T randomPayoff(double value)
+{
+	return numeric_limits<T>::is_integer ? (T)llround(value) : (T)value;
+}
+
+/// @brief draws the payoffs of outcomes first to first + count - 1 in PayoffTensor order;
+/// each outcome's payoffs depend only on the seed, the stream, and the outcome
+/// @param payoffs count * numPlayers of them
+/// @param first
+/// @param count
+/// @param options checked by checkRandomOptions()
+/// @param seed randomSeed(options), drawn once for all the pieces of a game
+template <typename T>
+void drawRandomPayoffs(T* payoffs, uint64_t first, uint64_t count, const RandGameOptions &options, unsigned long long seed)
+{
+	int nP = options.numStrats.size();
+
+	// the covariant payoffs are a * (e_x - mean of e) + b * (mean of e) for independent standard normals e,
+	// which have variance 1 and correlation covariance between players
+	double spread = 0.0, common = 0.0;
+	if (options.distribution == COVARIANT_PAYOFFS)
+	{
+		spread = sqrt(max(0.0, 1.0 - options.covariance));
+		common = sqrt(max(0.0, 1.0 + (nP - 1) * options.covariance));
+	}
+	vector<double> normals = vector<double>(nP);
+
+	for (uint64_t u = 0; u < count; u++, payoffs += nP)
+	{
+		RandomStream draws(seed, options.stream, first + u);
+		if (options.distribution == UNIFORM_PAYOFFS)
+		{
+			for (int x = 0; x < nP; x++)
+			{
+				if (numeric_limits<T>::is_integer)
+					payoffs[x] = (T)draws.uniformInteger(options.minPayoff, options.maxPayoff);
+				else
+					payoffs[x] = (T)(options.minPayoff + ((double)options.maxPayoff - options.minPayoff) * draws.uniform());
+			}
+		}
+		else if (options.distribution == NORMAL_PAYOFFS)
+		{
+			for (int x = 0; x < nP; x++)
+				payoffs[x] = randomPayoff<T>(options.mean + options.standardDeviation * draws.normal());
+		}
+		else
+		{
+			double average = 0.0;
+			for (int x = 0; x < nP; x++)
+			{
+				normals.at(x) = draws.normal();
+				average += normals.at(x);
+			}
+			average /= nP;
+			for (int x = 0; x < nP; x++)
+			{
+				double z = spread * (normals.at(x) - average) + common * average;
+				payoffs[x] = randomPayoff<T>(options.mean + options.standardDeviation * z);
+			}
+		}
+	}
+}
+
+/// @brief replaces tensor with a random game, its outcomes split among options.numThreads threads;
+/// the payoffs are the same for any number of threads
+/// @param tensor
+/// @param options
+/// @return the first problem with options
+template <typename T>
+GameStatus randomPayoffs(PayoffTensor<T> &tensor, const RandGameOptions &options)
+{
+	GameStatus status = checkRandomOptions(options);
+	if (!status.ok)
+		return status;
+	unsigned long long seed = randomSeed(options);
+
+	tensor.reset(options.numStrats);
+	uint64_t numOutcomes = tensor.getNumOutcomes();
+	int nP = options.numStrats.size();
+	T* payoffs = tensor.mutableData();
+
+	uint64_t numThreads = options.numThreads > 0 ? options.numThreads : thread::hardware_concurrency();
+	numThreads = max((uint64_t)1, min(numThreads, numOutcomes / 4096 + 1)); // a thread isn't worth starting for fewer
+	if (numThreads == 1)
+	{
+		drawRandomPayoffs(payoffs, 0, numOutcomes, options, seed);
+		return GameStatus();
+	}
+
+	vector<thread> threads;
+	for (uint64_t t = 0; t < numThreads; t++)
+	{
+		uint64_t first = numOutcomes * t / numThreads, last = numOutcomes * (t + 1) / numThreads;
+		threads.push_back(thread(drawRandomPayoffs<T>, payoffs + first * nP, first, last - first, cref(options), seed));
+	}
+	for (int t = 0; (unsigned)t < threads.size(); t++)
+		threads.at(t).join();
+	return GameStatus();
+}
+
+#endif
@@ -0,0 +1,148 @@
+/*******************************
+Title: Rational.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: exact fractions for the linear solver
+********************************/
+
+#ifndef RATIONAL_H
+#define RATIONAL_H
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+/******************************************************************************
+Fractions of the form numerator / denominator, always reduced with a
+positive denominator. Every product and sum is checked, and one that
+doesn't fit in a long long, or a zero denominator, makes the fraction
+invalid, like a double's NaN: anything computed from it is invalid too,
+so a whole calculation can be checked once at the end with isValid().
+******************************************************************************/
+class Rational
+{
+	private:
+		long long numerator;
+		long long denominator; // 0 when invalid
+
+		static long long gcd(long long a, long long b)
+		{
+			if (a < 0)
+				a = -a;
+			if (b < 0)
+				b = -b;
+			while (b != 0)
+			{
+				long long r = a % b;
+				a = b;
+				b = r;
+			}
+			return a;
+		}
+
+		static Rational invalid()
+		{
+			Rational r;
+			r.denominator = 0;
+			return r;
+		}
+
+		void reduce()
+		{
+			// LLONG_MIN can't be negated, so it's treated as an overflow
+			if (denominator == 0 || numerator == LLONG_MIN || denominator == LLONG_MIN)
+			{
+				numerator = 0;
+				denominator = 0;
+				return;
+			}
+			if (denominator < 0)
+			{
+				numerator = -numerator;
+				denominator = -denominator;
+			}
+			long long g = gcd(numerator, denominator);
+			if (g > 1)
+			{
+				numerator /= g;
+				denominator /= g;
+			}
+		}
+	public:
+		Rational() 							{ numerator = 0; denominator = 1; }
+		Rational(long long n) 				{ numerator = n; denominator = 1; reduce(); }
+		Rational(long long n, long long d) 	{ numerator = n; denominator = d; reduce(); }
+
+		long long getNumerator() const 		{ return numerator; }
+		long long getDenominator() const 	{ return denominator; }
+		bool isValid() const 				{ return denominator != 0; }
+		double toDouble() const 			{ return static_cast<double>(numerator) / static_cast<double>(denominator); }
+
+		Rational operator-() const { return isValid() ? Rational(-numerator, denominator) : invalid(); }
+
+		// cross-cancelling first keeps the intermediate products small
+		Rational operator*(const Rational &r) const
+		{
+			if (!isValid() || !r.isValid())
+				return invalid();
+			long long g1 = gcd(numerator, r.denominator), g2 = gcd(r.numerator, denominator), n, d;
+			if (g1 == 0)
+				g1 = 1;
+			if (g2 == 0)
+				g2 = 1;
+			if (__builtin_mul_overflow(numerator / g1, r.numerator / g2, &n)
+				|| __builtin_mul_overflow(denominator / g2, r.denominator / g1, &d))
+				return invalid();
+			return Rational(n, d);
+		}
+
+		// invalid if r is 0
+		Rational operator/(const Rational &r) const
+		{
+			if (!r.isValid() || r.numerator == 0)
+				return invalid();
+			return *this * Rational(r.denominator, r.numerator);
+		}
+
+		Rational operator+(const Rational &r) const
+		{
+			if (!isValid() || !r.isValid())
+				return invalid();
+			long long g = gcd(denominator, r.denominator), a, b, n, d;
+			if (__builtin_mul_overflow(numerator, r.denominator / g, &a)
+				|| __builtin_mul_overflow(r.numerator, denominator / g, &b)
+				|| __builtin_add_overflow(a, b, &n)
+				|| __builtin_mul_overflow(denominator / g, r.denominator, &d))
+				return invalid();
+			return Rational(n, d);
+		}
+
+		Rational operator-(const Rational &r) const 	{ return *this + (-r); }
+		Rational& operator+=(const Rational &r) 		{ *this = *this + r; return *this; }
+		Rational& operator-=(const Rational &r) 		{ *this = *this - r; return *this; }
+		Rational& operator*=(const Rational &r) 		{ *this = *this * r; return *this; }
+		Rational& operator/=(const Rational &r) 		{ *this = *this / r; return *this; }
+
+		// an invalid fraction is unequal to everything and neither less nor greater than anything;
+		// comparisons cross-multiply in 128 bits, so they can't overflow
+		bool operator==(const Rational &r) const 	{ return isValid() && numerator == r.numerator && denominator == r.denominator; }
+		bool operator!=(const Rational &r) const 	{ return !(*this == r); }
+		bool operator<(const Rational &r) const 	{ return isValid() && r.isValid() && (__int128)numerator * r.denominator < (__int128)r.numerator * denominator; }
+		bool operator>(const Rational &r) const 	{ return r < *this; }
+		bool operator<=(const Rational &r) const 	{ return *this < r || *this == r; }
+		bool operator>=(const Rational &r) const 	{ return r < *this || *this == r; }
+
+		friend ostream& operator << (ostream& os, const Rational& r)
+		{
+			if (!r.isValid())
+				return os << "overflow";
+			os << r.numerator;
+			if (r.denominator != 1)
+				os << "/" << r.denominator;
+			return os;
+		}
+};
+
+#endif
@@ -0,0 +1,351 @@
+/*******************************
+Title: ResultWriter.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: writes analysis results as TSV, CSV, or JSON Lines while they're produced
+********************************/
+
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+#include "BufferedWriter.h"
+
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+enum ResultFormat { TSV_RESULTS, CSV_RESULTS, JSON_LINES_RESULTS };
+
+/******************************************************************************
+Each record is one analysis of one game, made of key-value fields:
+	TSV 		file<TAB>analysis<TAB>key<TAB>value, a line per field
+	CSV 		the same four columns, a row per field, with the values quoted
+	JSON Lines 	{"file":...,"analysis":...,"key":value,...}, a line per record
+Fields go out as soon as they're added, so nothing is held but the
+BufferedWriter's buffer. Profiles are numbered from 1. In TSV and CSV a
+profile is (1,2), a list of them (1,2);(2,1) or none, and a mixed profile
+((0.5,0.5),(1,0)); in JSON they're arrays, and the key "-", which TSV uses
+for records with one field, is called "value".
+******************************************************************************/
+class ResultWriter
+{
+	private:
+		BufferedWriter out;
+		ResultFormat format;
+		string file;
+		string analysis;
+		bool inRecord;
+
+		void beginField(const string &);
+		void endField();
+		void writeMixedProfile(const vector<vector<double> > &);
+		void writeNumber(double);
+		void writeProfile(const vector<int> &);
+		void writeString(const string &);
+	public:
+		ResultWriter(ostream &o, ResultFormat f, size_t capacity = 1 << 16) : out(o, capacity), format(f) { inRecord = false; }
+
+		void addInteger(const string &, long long);
+		void addMixedProfile(const string &, const vector<vector<double> > &);
+		void addMixedProfiles(const string &, const vector<vector<vector<double> > > &);
+		void addNumber(const string &, double);
+		void addProfile(const string &, const vector<int> &);
+		void addProfiles(const string &, const vector<vector<int> > &);
+		void addText(const string &, const string &);
+		void beginRecord(const string &, const string &);
+		void endRecord();
+		bool flush() { return out.flush(); }
+		void writeHeader();
+};
+
+/// @brief adds a whole number
+/// @param key
+/// @param value
+void ResultWriter::addInteger(const string &key, long long value)
+{
+	beginField(key);
+	out << value;
+	endField();
+}
+
+/// @brief adds one probability distribution per player
+/// @param key
+/// @param profile profile.at(x).at(s) is the probability P_x plays s
+void ResultWriter::addMixedProfile(const string &key, const vector<vector<double> > &profile)
+{
+	beginField(key);
+	writeMixedProfile(profile);
+	endField();
+}
+
+/// @brief adds a list of mixed profiles; TSV and CSV give each its own field, keyed 1, 2, ..., or key - and value none if there are none
+/// @param key the JSON key
+/// @param profiles
+void ResultWriter::addMixedProfiles(const string &key, const vector<vector<vector<double> > > &profiles)
+{
+	if (format != JSON_LINES_RESULTS)
+	{
+		if (profiles.empty())
+			addText("-", "none");
+		for (int n = 0; (unsigned)n < profiles.size(); n++)
+			addMixedProfile(to_string(n + 1), profiles.at(n));
+		return;
+	}
+
+	beginField(key);
+	out << '[';
+	for (int n = 0; (unsigned)n < profiles.size(); n++)
+	{
+		if (n > 0)
+			out << ',';
+		writeMixedProfile(profiles.at(n));
+	}
+	out << ']';
+	endField();
+}
+
+/// @brief adds a number, written as the stream's precision says
+/// @param key
+/// @param value
+void ResultWriter::addNumber(const string &key, double value)
+{
+	beginField(key);
+	writeNumber(value);
+	endField();
+}
+
+/// @brief adds a pure strategy profile
+/// @param key
+/// @param profile numbered from 0; written from 1
+void ResultWriter::addProfile(const string &key, const vector<int> &profile)
+{
+	beginField(key);
+	writeProfile(profile);
+	endField();
+}
+
+/// @brief adds a list of pure strategy profiles
+/// @param key
+/// @param profiles numbered from 0; written from 1
+void ResultWriter::addProfiles(const string &key, const vector<vector<int> > &profiles)
+{
+	beginField(key);
+	if (format == JSON_LINES_RESULTS)
+		out << '[';
+	else if (profiles.empty())
+		out << "none";
+	for (int n = 0; (unsigned)n < profiles.size(); n++)
+	{
+		if (n > 0)
+			out << (format == JSON_LINES_RESULTS ? ',' : ';');
+		writeProfile(profiles.at(n));
+	}
+	if (format == JSON_LINES_RESULTS)
+		out << ']';
+	endField();
+}
+
+/// @brief adds a string
+/// @param key
+/// @param value
+void ResultWriter::addText(const string &key, const string &value)
+{
+	beginField(key);
+	if (format == JSON_LINES_RESULTS)
+		writeString(value);
+	else if (format == CSV_RESULTS)
+	{
+		// inside the value's quotes
+		for (int c = 0; (unsigned)c < value.size(); c++)
+		{
+			if (value.at(c) == '"')
+				out << '"';
+			out << value.at(c);
+		}
+	}
+	else
+		out << value;
+	endField();
+}
+
+// starts a field: a row's first three columns, or a JSON key
+void ResultWriter::beginField(const string &key)
+{
+	if (format == JSON_LINES_RESULTS)
+	{
+		out << ',';
+		writeString(key == "-" ? "value" : key);
+		out << ':';
+		return;
+	}
+
+	char separator = format == TSV_RESULTS ? '\t' : ',';
+	writeString(file);
+	out << separator;
+	writeString(analysis);
+	out << separator;
+	writeString(key);
+	out << separator;
+
+	// CSV values are quoted whole, since profiles have commas
+	if (format == CSV_RESULTS)
+		out << '"';
+}
+
+/// @brief starts the results of one analysis of one game
+/// @param f the game's file
+/// @param a the analysis
+void ResultWriter::beginRecord(const string &f, const string &a)
+{
+	if (inRecord)
+		endRecord();
+	file = f;
+	analysis = a;
+	inRecord = true;
+
+	if (format == JSON_LINES_RESULTS)
+	{
+		out << "{\"file\":";
+		writeString(file);
+		out << ",\"analysis\":";
+		writeString(analysis);
+	}
+}
+
+// ends a row; JSON fields are ended by the next one or the record's end
+void ResultWriter::endField()
+{
+	if (format == CSV_RESULTS)
+		out << "\"\n";
+	else if (format == TSV_RESULTS)
+		out << '\n';
+}
+
+// ends the record started by beginRecord()
+void ResultWriter::endRecord()
+{
+	if (inRecord && format == JSON_LINES_RESULTS)
+		out << "}\n";
+	inRecord = false;
+}
+
+// ((p, ...), ...) or [[p, ...], ...]
+void ResultWriter::writeMixedProfile(const vector<vector<double> > &profile)
+{
+	char open = format == JSON_LINES_RESULTS ? '[' : '(', close = format == JSON_LINES_RESULTS ? ']' : ')';
+	out << open;
+	for (int x = 0; (unsigned)x < profile.size(); x++)
+	{
+		if (x > 0)
+			out << ',';
+		out << open;
+		for (int s = 0; (unsigned)s < profile.at(x).size(); s++)
+		{
+			if (s > 0)
+				out << ',';
+			writeNumber(profile.at(x).at(s));
+		}
+		out << close;
+	}
+	out << close;
+}
+
+// value, or null in JSON if it isn't finite
+void ResultWriter::writeNumber(double value)
+{
+	if (format == JSON_LINES_RESULTS && !isfinite(value))
+		out << "null";
+	else
+		out << value;
+}
+
+// (s_1,s_2,...) or [s_1,s_2,...], numbered from 1
+void ResultWriter::writeProfile(const vector<int> &profile)
+{
+	out << (format == JSON_LINES_RESULTS ? '[' : '(');
+	for (int x = 0; (unsigned)x < profile.size(); x++)
+	{
+		if (x > 0)
+			out << ',';
+		out << profile.at(x) + 1;
+	}
+	out << (format == JSON_LINES_RESULTS ? ']' : ')');
+}
+
+// s quoted and escaped for JSON or CSV; TSV fields are written as they are
+void ResultWriter::writeString(const string &s)
+{
+	if (format == TSV_RESULTS)
+	{
+		out << s;
+		return;
+	}
+
+	if (format == CSV_RESULTS)
+	{
+		if (s.find_first_of(",\"\r\n") == string::npos)
+		{
+			out << s;
+			return;
+		}
+		out << '"';
+		for (int c = 0; (unsigned)c < s.size(); c++)
+		{
+			if (s.at(c) == '"')
+				out << '"';
+			out << s.at(c);
+		}
+		out << '"';
+		return;
+	}
+
+	out << '"';
+	for (int c = 0; (unsigned)c < s.size(); c++)
+	{
+		unsigned char ch = s.at(c);
+		if (ch == '"' || ch == '\\')
+			out << '\\' << (char)ch;
+		else if (ch == '\n')
+			out << "\\n";
+		else if (ch == '\t')
+			out << "\\t";
+		else if (ch < 0x20)
+		{
+			char escape[7];
+			snprintf(escape, sizeof(escape), "\\u%04x", ch);
+			out << escape;
+		}
+		else
+			out << (char)ch;
+	}
+	out << '"';
+}
+
+// the column names, for TSV and CSV
+void ResultWriter::writeHeader()
+{
+	if (format == TSV_RESULTS)
+		out << "file\tanalysis\tkey\tvalue\n";
+	else if (format == CSV_RESULTS)
+		out << "file,analysis,key,value\n";
+}
+
+/// @brief reads a format's name
+/// @param name tsv, csv, or json (JSON Lines)
+/// @param format
+/// @return false if name isn't one of them
+inline bool parseResultFormat(const string &name, ResultFormat &format)
+{
+	if (name == "tsv")
+		format = TSV_RESULTS;
+	else if (name == "csv")
+		format = CSV_RESULTS;
+	else if (name == "json" || name == "jsonl")
+		format = JSON_LINES_RESULTS;
+	else
+		return false;
+	return true;
+}
+
+#endif
@@ -1,341 +1,127 @@
 /**********************************************
-Title: seqGame.h
+Title: SeqGame.h
 Author: Andrew Lounsbury
-Date: 6/6/2020
+Date: 10/19/2026
 Purpose: class for sequential aspects of games
 **********************************************/
 
 #ifndef SEQGAME_H
 #define SEQGAME_H
 #include "Player.h"
-#include "TreeNode.h"
+#include "GameTree.h"
+#include "BackwardInduction.h"
 
-// WIP, search tree of payoffs
+// a sequential game: its players and its game tree (see GameTree.h)
 class SeqGame
 {
 	private:
-		TreeNode* root;
-		int numNodes;
 		int numPlayers;
 		vector<Player*> players; // array of pointers to Players
-		
-		void insert(TreeNode*&, TreeNode* &);
-		void destroySubTree(TreeNode*);
-		void displayInOrder(TreeNode*) const;
-		// void displayPreOrder(TreeNode*) const;
-		void displayPostOrder(TreeNode*) const;
+		GameTree<int> tree;
+
+		void display(uint32_t, int, const vector<uint16_t> &) const;
 	public:
-		SeqGame()
-		{
-			root = new TreeNode;
-			root = NULL;
-			numNodes = 0;
-			numPlayers = 2;
-			players = vector<Player*>(numPlayers);
-		}
-		
-		SeqGame(int nP)
+		SeqGame(int nP = 2) : tree(nP)
 		{
-			root = new TreeNode;
-			root = NULL;
-			numNodes = 0;
 			numPlayers = nP;
-			players = vector<Player*>(numPlayers);
+			for (int x = 0; x < numPlayers; x++)
+				players.push_back(new Player(numPlayers, x));
 		}
-		
-		~SeqGame()
-		{ destroySubTree(root); }
-		
-		void displayPreOrder(TreeNode*) const;
-		
-		Player* getPlayer(int i) const
-		{ return players.at(i); }
-		
-		TreeNode* getRoot()
-		{ return root; }
-		
-		void setRoot(TreeNode* node)
-		{ root = node; }
-		
-		void computePath(TreeNode*);
-		int difference(TreeNode*);
-		void display(TreeNode* , int);
-		int height(TreeNode*);
-		void insert(TreeNode*, vector<int>);
-		int numNodesPerLevel(int);
-		bool search(TreeNode*);
-};
 
-void SeqGame::computePath(TreeNode* node) // FINISH
-{
-	TreeNode* curNode = root;
-	vector<TreeNode*> temp = vector<TreeNode*>(node->getLevel() - 1); // tracks nodes on the way to node
-	// vector<int> checking;
-	
-	// curNode at level - 1
-	while (curNode->getLevel() < node->getLevel() - 1)
-	{
-		// keep track of the nodes curNode passes on the way to node
-		temp.at(curNode->getLevel()) = curNode;
-		
-		
-		// checking = vector<int>(node->getLevel() - 1);
-		// for (int i = 0; i < node->getLevel() - 1; i++)
-			// checking.at(i) = node->getLevel();
-		
-		/*
-		will always be the 0-th, 1st, 2nd,... node 
-		in the path down to level - i */
-		for (int i = 1; i < node->getLevel(); i++) // each level (level - i)
-		{
-			for (int j = 0; j < players[curNode->getNodePlayer()]->getNumStrats(); j++)
-			{
-				curNode = curNode->getNext(j);
-			}
-		}
-	}
-	
-	// players[curNode->getNodePlayer()]->getNumStrats()
-	// each strategy in that node in level - i
-	for (int j = 0; j < players[curNode->getNodePlayer()]->getNumStrats(); j++)
-	{
-		if (curNode->getNext(j) == node)
+		~SeqGame()
 		{
-			// if node is found, all nodes recorded in temp are the path for node
-			node->setPathVertex(0, 0);
-			for (int n = 1; n < curNode->getLevel(); n++)
-				node->setPathVertex(n, temp.at(n)->getStrategy());
-			
-			node->setPathVertex(curNode->getLevel(), j);
-			return;
+			for (int x = 0; x < numPlayers; x++)
+				delete players.at(x);
 		}
-	}
-	
-	// move up a level to check the next level - 1 node to the right
-	curNode = temp.at(curNode->getLevel() - 1);
-}
 
-void SeqGame::destroySubTree(TreeNode* curNode)
-{
-	if (curNode)
-	{
-		for (int i = 0; i < players[curNode->getNodePlayer()]->getNumStrats(); i++)
-		{
-			if (curNode->getNext(i) != NULL)
-				destroySubTree(curNode = curNode->getNext(i + 1));
-		}
-		delete curNode;
-	}
-}
+		int getNumPlayers() const 				{ return numPlayers; }
+		Player* getPlayer(int i) const 			{ return players.at(i); }
+		GameTree<int>& getTree() 				{ return tree; }
+		const GameTree<int>& getTree() const 	{ return tree; }
+
+		SubgamePerfectResult<int> computeSubgamePerfect(int numThreads = 0) const 	{ return subgamePerfect(tree, numThreads); }
+		void display() const;
+		int height() const 						{ return tree.height(); }
+		GameStatus insert(const vector<int> &, int, int);
+		uint32_t numNodesPerLevel(int) const;
+		uint32_t search(const vector<int> &) const;
+};
 
-int SeqGame::difference(TreeNode* node)
+// prints the tree, each node under its parent and indented by its depth, marking the subgame-perfect actions
+void SeqGame::display() const
 {
-	int size = players[node->getNodePlayer()]->getNumStrats();
-	vector<int> heights = vector<int>(size);
-	int maxHeight = -1;
-	int minHeight = std::numeric_limits<int>::max();
-	int diff;
-	
-	for (int i = 0; i < size; i++)
-		heights.at(i) = height(node->getNext(i));
-	for (int i = 0; i < size; i++)
+	SubgamePerfectResult<int> result = computeSubgamePerfect(1);
+	display(0, 0, result.status.ok ? result.actions : vector<uint16_t>());
+	if (result.status.ok)
 	{
-		if (heights.at(i) > maxHeight)
-			maxHeight = heights.at(i);
-		if (heights.at(i) < minHeight)
-			minHeight = heights.at(i);
+		cout << "\nSubgame-perfect outcome:  (";
+		for (int x = 0; x < numPlayers; x++)
+			cout << (x > 0 ? ", " : "") << result.payoffs.at(x);
+		cout << ")\n";
 	}
-	diff = maxHeight - minHeight;
-	return diff;
 }
 
-/*
-			-1
-		0		1
-	0	1
-	
-			1
-		2		3
-	
-d1
-	d2
-
-	ed2
-	d3
-	
-	ed3
-ed1
-*/
-
-void SeqGame::display(TreeNode* node, int level)
+// prints node and the nodes below it; a * marks the actions in best, if any are given
+void SeqGame::display(uint32_t node, int level, const vector<uint16_t> &best) const
 {
-	int num = rand();
-	cout << "\nDISPLAY:  " << num << endl;
-	// cout << num << endl;
-	
-	int i, strat;
-	if (node)
+	for (int i = 0; i < level; i++)
+		cout << "        ";
+	if (node == 0)
+		cout << "root";
+	else
 	{
-		for (strat = 0; strat < node->getSizeNext() - 1; strat++)
-		{
-			cout << "\nstrat: " << strat << endl;
-			
-			display(node->getNext(strat), level + 1);
-		
-			printf("\n");
-			
-			for (i = 0; i < level && node != root; i++)
-				cout << "        ";
-			
-			if (node == root)
-				cout << "P_" << node->getNodePlayer() + 1 << ", s_{" << node->getStrategy() << "}";
-			else
-				cout << "P_" << node->getNodePlayer() + 1 << ", s_" << node->getStrategy() + 1;
-		}
-		
-		display(node->getNext(node->getSizeNext() - 1), level + 1);
+		cout << "s_" << tree.action(node) + 1;
+		if (!best.empty() && best.at(tree.getParent(node)) == tree.action(node))
+			cout << "*";
 	}
-	cout << "   DONE:  " << num << "\n";
-}
 
-void SeqGame::displayPreOrder(TreeNode* node) const
-{
-	cout << "DISPLAYPREORDER\n";
-	if (node)
+	if (tree.isTerminal(node))
 	{
-		cout << "P_" << node->getNodePlayer() << ", s_" << node->getStrategy() << "  ";
-		cout << node->getPayoff() << endl;
-		for (int i = 0; i < players[1 - node->getNodePlayer()]->getNumStrats(); i++)
-			displayPreOrder(node->getNext(i));
+		cout << "  (";
+		for (int x = 0; x < numPlayers; x++)
+			cout << (x > 0 ? ", " : "") << tree.getPayoff(node, x);
+		cout << ")\n";
 	}
-	
-	cout << "END OF DISPLAYPREORDER\n";
-}
-
-int SeqGame::height(TreeNode* node) // FINISH
-{
-	cout << "GETTING HEIGHT\n";
-	
-	int size = players[node->getNodePlayer()]->getNumStrats();
-	vector<int> heights = vector<int>(size);
-	int maxHeight = -1;
-	int h = 0;
-	
-	if (node)
+	else if (tree.getNumChildren(node) > 0)
 	{
-		for (int i = 0; i < size; i++)
-			heights.at(i) = height(node->getNext(i));
-		for (int i = 0; i < size; i++)
-		{
-			if (heights.at(i) > maxHeight)
-				maxHeight = heights.at(i);
-		}
-		h = maxHeight + 1;
+		cout << "  P_" << tree.getPlayer(node) + 1 << endl;
+		for (int a = 0; a < tree.getNumChildren(node); a++)
+			display(tree.getChild(node, a), level + 1, best);
 	}
-	return h;
+	else
+		cout << endl;
 }
 
-/*
-			-1
-		0		1
-	0	1
-*/
-
-// Copy tree from level l down from previous node in l
-// insert new payoffs NLR
-void SeqGame::insert(TreeNode* root, vector<int> p) // FINISH
+/// @brief gives the node at the end of path to player x with numActions actions
+/// @param path the actions from the root, numbered from 0; the root is {}
+/// @param x
+/// @param numActions
+GameStatus SeqGame::insert(const vector<int> &path, int x, int numActions)
 {
-	cout << "INSERTING\n";
-	
-	TreeNode* curNode;
-	TreeNode* newNode = new TreeNode;
-	newNode->setPath(p);
-	
-	if (!root)
-	{
-		setRoot(newNode);
-		getRoot()->setStrategy(-1); // all paths start with -1
-		cout << "DONE INSERTING\n\n";
-		return;
-	}
-	
-	// if (path.size() != (unsigned)height(this->getRoot()))
-	// {
-		// cout << "This is an invalid node.\n";
-		// return;
-	// }
-	
-	curNode = root;
-	int lev = 0;
-	// follow path to spot before the new spot
-	while (curNode && (unsigned)lev < p.size() - 2) // && curNode->getNext(path.at(i))       && curNode->getPath() != path
-	{		
-		lev++;
-		cout << "lev: " << lev << endl;
-		cout << "path at " << lev << ": " << p.at(lev) << endl;
-		cout << "size: " << curNode->getSizeNext() << endl;
-		curNode = curNode->getNext(p.at(lev));
-		cout << "test1\n";
-	}
-	cout << "test2\n";
-	curNode->addNext(); // create spot in next, will be the last position
-	cout << "test3\n";
-	curNode->setNext(curNode->getSizeNext() - 1, newNode);
-	curNode->setNextPlayer(curNode->getSizeNext() - 1, 1 - curNode->getNodePlayer());
-	cout << "DONE INSERTING\n\n";
+	uint32_t node = search(path), first;
+	if (node == NO_NODE)
+		return GameStatus("the path doesn't lead to a node of the tree");
+	return tree.expand(node, x, numActions, first);
 }
 
-int SeqGame::numNodesPerLevel(int i)
+// the number of nodes i moves from the root
+uint32_t SeqGame::numNodesPerLevel(int i) const
 {
-	int num = -1;
-	int r = -1;
-	
-	if (i == 0)
-		return 0;
-	else if (i % numPlayers == 0)
-	{
-		for (int x = 0; x < numPlayers; i++)
-			num *= pow(players[x]->getNumStrats(), i / numPlayers);
-	}
-	else if (i % numPlayers > 0)
-	{
-		r = i % numPlayers;
-		for (int x = 0; x < numPlayers; i++)
-		{
-			if (r > 0)
-			{
-				num *= pow(players[x]->getNumStrats(), (i / numPlayers) + 1);
-				r--;
-			}
-			else
-				num *= pow(players[x]->getNumStrats(), i / numPlayers);
-		}
-	}
-	return num;
+	vector<uint32_t> counts = tree.nodesPerLevel();
+	return i >= 0 && (unsigned)i < counts.size() ? counts.at(i) : 0;
 }
 
-bool SeqGame::search(TreeNode* item) // FINISH
+// the node the actions in path lead to from the root, or NO_NODE if there isn't one
+uint32_t SeqGame::search(const vector<int> &path) const
 {
-	TreeNode* curNode = root;
-	
-	while (curNode)
+	uint32_t node = 0;
+	for (int d = 0; (unsigned)d < path.size(); d++)
 	{
-		while (curNode->getLevel() != item->getLevel())
-		{
-			curNode->getNext(0);
-		}
-		for (int i = 0; i < players[curNode->getNodePlayer()]->getNumStrats(); i++)
-		{
-			if (curNode->getStrategy() == item->getStrategy())
-				return true;
-			else
-			{
-				cout << "else\n";
-				return false;
-			}
-		}
+		if (path.at(d) < 0 || path.at(d) >= tree.getNumChildren(node))
+			return NO_NODE;
+		node = tree.getChild(node, path.at(d));
 	}
-	return true;
+	return node;
 }
 
-#endif
\ No newline at end of file
+#endif
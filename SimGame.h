@@ -9,6 +9,24 @@ Purpose: class for simultaneous aspects of games
 #define SIMGAME_H
 #include "Player.h"
 #include "LinkedList.h"
+#include "LinearSolver.h"
+#include "GameResults.h"
+#include "GameCorpus.h"
+#include "BufferedWriter.h"
+#include "RandomPayoffs.h"
+#include "KLevelEngine.h"
+#include "CognitiveHierarchy.h"
+#include "QuantalResponse.h"
+#include "MonteCarlo.h"
+#include "KripkeModel.h"
+
+#include <map>
+
+// computeRevelations() tries all 2^numPlayers sets of players, so it stops at this many
+const int MAX_REVEALING_PLAYERS = 16;
+
+// what each entry shows when writeMatrices() prints the payoff matrices
+enum MatrixLayout { PAYOFFS_AND_BRS, PAYOFFS_AND_BRS_SANS_INFO, PAYOFFS_ONLY, BRS_ONLY, PAYOFFS_THEN_BRS };
 
 // "Simultaneous Game" a vector of matrices (vectors of vectors) of linked lists and relevant data
 template <typename T>
@@ -21,20 +39,27 @@ class simGame
 		vector<vector<vector<LinkedList<T>*> > > payoffMatrix;
 		
 		// k-rationalizability 
-		vector<vector<vector<vector<int> > > > kMatrix;
-		vector<double> rationalityProbabilities = vector<double>(4); // probability a player is L_i, i = 0,...3
-		vector<double> outcomeProbabilities; // probability of each outcome in kMatrix stored in kOutcomes; P(s_i, s_j)
-		vector<vector<int> > kOutcomes; // n-tuples that appear in kMatrix; won't be all of them
-		vector<vector<int> > kStrategies = vector<vector<int> >(4); // 2D matrix containing the strategies each player would play for k-levels 0,...,3
+		KLevelEngine<T> kLevels; // the levels' strategies, computed as they're needed
+		vector<double> rationalityProbabilities = vector<double>(4); // probability a player is L_i, i = 0,...,K
+		vector<double> outcomeProbabilities; // probability of each outcome in kOutcomes; P(s_i, s_j)
+		vector<vector<int> > kOutcomes; // n-tuples the levels play; won't be all of them
 		
-		vector<vector<int> > mixedEquilibria; // probabilities each player will play each strategy
+		vector<vector<vector<double> > > mixedEquilibria; // probabilities each player will play each strategy
 		vector<vector<int> > paretoPureEquilibria;
 		vector<vector<int> > pureEquilibria; // contains strategy profiles of numPlayers length
 		int maxR;
 		bool bos, chicken, ih, pd, pc, sh, null, zs;
 		bool impartial;
 		bool mixed;
+		bool verbose; // diagnostics from computations, e.g., computeChoices()
+		
+		// printing
+		PrintWindow window; // the part of the matrices the print functions show
+		vector<vector<int> > payoffLengths; // maxPayoffLengths(), kept until the payoffs change
+		bool payoffLengthsValid;
 		
+		const vector<vector<int> >& cachedPayoffLengths();
+		void invalidatePayoffLengths() { payoffLengthsValid = false; }
 		vector<vector<int> > maxBestResponseLengths();
 		vector<vector<int> > maxPayoffLengths();
 		// vector<vector<int> > maxEntryLengths(vector<vector<vector<bool> > >);
@@ -50,17 +75,13 @@ class simGame
 		bool getIH() 												{ return ih; }
 		bool getImpartial() 										{ return impartial; }
 		vector<int> getKOutcome(int i) 								{ return kOutcomes.at(i); }
-		vector<int> getKStrategy(int i) 							{ return kStrategies.at(i); }
+		vector<int> getKStrategy(int i) 							{ return kLevels.level(i); }
 		int getMaxRationality() 									{ return maxR; }
-		int getNumOutcomes() const 									{ return numOutcomes; }
-		int getNumPlayers() const 									{ return numPlayers; }
 		double getOutcomeProbability(int i) 						{ return outcomeProbabilities.at(i); }
 		vector<int> getParetoEquilibrium(int i) 					{ return paretoPureEquilibria.at(i); }
-		vector<vector<int> > getParetoPureEquilibria() 				{ return paretoPureEquilibria; }
 		vector<vector<vector<LinkedList<T>*> > > getPayoffMatrix()	{ return payoffMatrix; }
 		bool getPC() 												{ return pc; }
 		bool getPD() 												{ return pd; }
-		vector<vector<int> > getPureEquilibria() 					{ return pureEquilibria; }
 		vector<int> getPureEquilibrium(int i)						{ return pureEquilibria.at(i); }
 		double getRationalityProbability(double i)					{ return rationalityProbabilities.at(i); }
 		
@@ -100,13 +121,13 @@ class simGame
 		bool checkSHConditions();
 		bool checkZSConditions();
 		bool chickenCondition(vector<int>, vector<int>);
-		void computeBestResponses();
+		OutcomeReport<T> cachedOutcomeReport(const vector<int> &, map<vector<int>, OutcomeReport<T> > &);
+		CommunicationResult<T> communicate(const vector<int> &, const KripkeModel &, int, map<vector<int>, OutcomeReport<T> > &);
 		void computeChoices();
 		vector<vector<Polynomial*> > computeExpectedUtilities();
 		void computeImpartiality();
 		void computeKStrategies();
 		void computeNumOutcomes();
-		void computePureEquilibria();
 		bool coordination();
 		void determineType();
 		vector<int> enterStratProfile();
@@ -123,28 +144,84 @@ class simGame
 		int maxPayoffInRowColOrMatrices(int, vector<int>);
 		int maxStratInRowColOrMatrices(int, vector<int>);
 		int maxStrat(int);
+		bool nextLevelProfile(vector<int> &, int);
+		int matrixIndex(const vector<int> &, const vector<int> &) const;
+		vector<int> matrixProfile(int, const vector<int> &) const;
+		bool movePrintWindow();
+		OutcomeReport<T> outcomeReport(vector<int>);
+		void printOutcome(const OutcomeReport<T> &);
 		void printKOutcomes();
 		void printKOutcomeProbabilities();
 		void printKProbabilities();
 		void printKStrategies();
+		void printMatrices(MatrixLayout);
 		void printPayoffMatrixSansInfo();
 		void properDominantStrategies();
 		bool PO(vector<int>);
+		GameStatus predictChoices(vector<int> &);
 		void randType();
+		void remapStrategies(int, int, const vector<int> &);
 		// void removePlayer();
-		void removeStrategy(int, int);
 		void removeStrategyPrompt(int);
+		void resizePayoffMatrix();
 		int rHash(vector<int>);
-		vector<int> rUnhash(int matrixIndex);
 		void saveKMatrixAsLatex(vector<int>, vector<double>);
+		string typeName() const;
+		void setDimensions(const vector<int> &);
 		bool shCondition(vector<int>, vector<int>);
-		double solve(Polynomial*, Polynomial*);
+		double solve(const Polynomial*, const Polynomial*);
+		template <typename S> void printMixedEquilibria(vector<vector<vector<S> > >);
+		template <typename S> void printMixedEquilibria(const SupportEnumerationResult<S> &);
+		template <typename S> SupportEnumerationResult<S> supportEnumeration();
 		vector<int> unhash(int);
+		bool writeMatrices(MatrixLayout);
+		void writeMatrixLabel(BufferedWriter &, int);
 	public:
-		Player* getPlayer(int i) const { return players.at(i); }
+		int getNumOutcomes() const 							{ return numOutcomes; }
+		int getNumPlayers() const 							{ return numPlayers; }
+		vector<vector<int> > getParetoPureEquilibria() 		{ return paretoPureEquilibria; }
+		Player* getPlayer(int i) const 						{ return players.at(i); }
+		const PrintWindow& getPrintWindow() const 			{ return window; }
+		vector<vector<int> > getPureEquilibria() 			{ return pureEquilibria; }
+		bool getVerbose() const 							{ return verbose; }
+		void setPrintWindow(const PrintWindow &w) 			{ window = w; }
+		void setVerbose(bool v) 							{ verbose = v; }
 	
 		simGame(int);
 		~simGame();
+		
+		// non-interactive; nothing is read from cin and results are returned rather than printed
+		GameStatus appendStrategy(int);
+		void computeBestResponses();
+		CognitiveHierarchyResult computeCognitiveHierarchy(vector<double>);
+		BitMatrix computeCommonKnowledge(KnowledgeKind) const;
+		CommunicationResult<T> computeCommunication();
+		CommunicationResult<T> computeCommunication(const KripkeModel &, int);
+		EpistemicLevelResult<T> computeEpistemicLevels(const KripkeModel &, const vector<WorldSet> &, int, int);
+		KMatrixResult<T> computeKMatrix(vector<double>);
+		QREPathResult computeLogitEquilibrium(double);
+		RevelationResult<T> computeRevelations();
+		SimulationResult computeSimulation(const SimulationOptions &);
+		void computePureEquilibria();
+		string computeType();
+		SupportEnumerationResult<double> findMixedEquilibria();
+		bool getBestResponse(vector<int>, int);
+		T getPayoff(vector<int>, int);
+		GameStatus loadFromCorpus(const GameCorpus &, size_t);
+		GameStatus loadFromFile(string);
+		void loadPayoffs(const PayoffTensor<T> &);
+		GameStatus randomize(const RandGameOptions &);
+		int removeDominatedStrategies();
+		GameStatus removeStrategy(int, int);
+		GameStatus setPayoff(vector<int>, int, T);
+		GameStatus setRationality(int, int);
+		PayoffTensor<T> toPayoffTensor();
+		GameStatus writeBinaryFile(string);
+		GameStatus writeLatexFile(string);
+		GameStatus writeNfgFile(string);
+		GameStatus writeToFile(string);
+		
+		// interactive
 		void addPlayer();
 		bool commonKnowledge() const;
 		void communication();
@@ -153,6 +230,7 @@ class simGame
 		void editPlayer();		
 		void printBestResponses();
 		void printBothSeparately();
+		void printCognitiveHierarchy();
 		void printKMatrix();
 		void printPayoffMatrix();
 		void printPayoffs();
@@ -161,8 +239,11 @@ class simGame
 		void printPureEquilibria();
 		void randGame();
 		void readFromFile();
+		bool readPreferences(string);
 		void reduce();
+		bool saveExpectedUtilities(string);
 		void savePayoffMatrixAsLatex();
+		bool savePreferences(string);
 		void saveToFile();
 		void setAllNumStrats(char);
 		void setAllRationalities();
@@ -186,34 +267,12 @@ simGame<T>::simGame(int nP)
 	
 	numOutcomes = 4;
 	mixed = true;
+	verbose = true;
+	payoffLengthsValid = false;
 	
-	// Creating kStrategies' 4 arrays of vectors of size numPlayers and setting rationalityProbabilities
-	for (int r = 0; r < 4; r++)
-	{
-		kStrategies.at(r).resize(numPlayers);
+	// setting rationalityProbabilities; the levels' strategies are computed when they're needed
+	for (int r = 0; (unsigned)r < rationalityProbabilities.size(); r++)
 		setRationalityProbability(r, 0.0);
-	}
-	
-	// maximum rationality is 3, meaning there are 4 rationality levels
-	int size = 1;
-	if (numPlayers > 2)
-		size = pow(4, numPlayers);
-	
-	kMatrix.resize(size);
-	
-	for (int m = 0; (unsigned)m < kMatrix.size(); m++)
-	{
-		kMatrix.at(m).resize(4);
-		for(int i = 0; i < 4; i++)
-		{
-			kMatrix.at(m).at(i).resize(4);
-			for(int j = 0; j < 4; j++)
-			{
-				vector<int> vect(numPlayers, -1);
-				kMatrix.at(m).at(i).at(j) = vect;
-			}
-		}
-	}
 	
 	// creating pureEquilibria
 	for (int i = 0; (unsigned)i < pureEquilibria.size(); i++)
@@ -231,7 +290,7 @@ simGame<T>::simGame(int nP)
 	}
 	
 	// default player has 2 strategies
-	size = 1;
+	int size = 1;
 	if (numPlayers > 2)
 	{
 		for (int x = 0; x < numPlayers; x++)
@@ -270,13 +329,13 @@ simGame<T>::simGame(int nP)
 template <typename T>
 simGame<T>::~simGame()
 {
-	for (int x = 0; x < numPlayers; x++)
-		delete players.at(x);
-		
 	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
 		for(int i = 0; i < players.at(0)->getNumStrats(); i++) // each row
 			for(int j = 0; j < players.at(1)->getNumStrats(); j++) // each column in row i
 				delete payoffMatrix.at(m).at(i).at(j);
+	
+	for (int x = 0; x < numPlayers; x++)
+		delete players.at(x);
 }
 
 // add Player and set attributes
@@ -288,13 +347,14 @@ void simGame<T>::addPlayer()
 	// int nT = -1, nV = 1;
 	LinkedList<T>* curList; 
 	Polynomial* p;
+	invalidatePayoffLengths();
 	
 	// cout << "\nUtility: ";
 	// cin >> u;
 	
 	cout << "Rationality:  ";
 	cin >> r;
-	validate(r, 0, 3);
+	validate(r, 0, MAX_RATIONALITY);
 	
 	cout << "Number of Strategies:  ";
 	cin >> nS;
@@ -428,61 +488,22 @@ void simGame<T>::addPlayer()
 template <typename T>
 void simGame<T>::addStrategy(int x)
 {	
-	int val = -1;
-	LinkedList<T>* curList;
-	vector<int> profile = vector<int>(numPlayers);
-
-	players.at(x)->setNumStrats(players.at(x)->getNumStrats() + 1); // increase the player's number of strategies
+	T val;
+	vector<int> profile;
+	
+	appendStrategy(x);
+	
 	cout << "Enter the payoffs for all players in the new outcomes:\n";
-	if (x == 0)
-	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			profile = unhash(m);
-			// add a new row to each matrix and set the size of each new row
-			payoffMatrix.at(m).resize(payoffMatrix.at(m).size() + 1);
-			payoffMatrix.at(m).at(players.at(x)->getNumStrats() - 1).resize(players.at(1)->getNumStrats());
-			
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++) // add new lists to each new row
-			{				
-				LinkedList<T>* newList = new LinkedList<T>;
-				profile.at(0) = players.at(x)->getNumStrats() - 1;
-				profile.at(1) = j;
-				
-				cout << "(";
-				for (int y = 0; y < numPlayers; y++)
-				{
-					cout << profile.at(y) + 1;
-					if (y < numPlayers - 1)
-						cout << ", ";
-				}
-				cout << "):\n";
-				payoffMatrix.at(m).at(players.at(x)->getNumStrats() - 1).at(j) = newList;
-				curList = payoffMatrix.at(m).at(players.at(x)->getNumStrats() - 1).at(j);
-				for (int y = 0; y < numPlayers; y++)
-				{
-					cout << "\tP_" << y + 1 << ":  ";
-					cin >> val;
-					curList->appendNode(val, false);
-				}
-			}
-		}
-	}
-	else if (x == 1)
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
 	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			profile = unhash(m);
-			// add a new row to each matrix and set the size of each new row
-			payoffMatrix.at(m).resize(payoffMatrix.at(m).size() + 1);
-			
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++) // add new lists to each new column
+		profile = unhash(m);
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 			{
-				payoffMatrix.at(m).at(i).resize(players.at(1)->getNumStrats());
-				
-				LinkedList<T>* newList = new LinkedList<T>;
 				profile.at(0) = i;
-				profile.at(1) = players.at(x)->getNumStrats() - 1;
+				profile.at(1) = j;
+				if (profile.at(x) != players.at(x)->getNumStrats() - 1)
+					continue;
 				
 				cout << "(";
 				for (int y = 0; y < numPlayers; y++)
@@ -492,74 +513,34 @@ void simGame<T>::addStrategy(int x)
 						cout << ", ";
 				}
 				cout << "):\n";
-				payoffMatrix.at(m).at(i).at(players.at(x)->getNumStrats() - 1) = newList;
-				curList = payoffMatrix.at(m).at(i).at(players.at(x)->getNumStrats() - 1);
 				for (int y = 0; y < numPlayers; y++)
 				{
 					cout << "\tP_" << y + 1 << ":  ";
 					cin >> val;
-					curList->appendNode(val, false);
+					setPayoff(profile, y, val);
 				}
 			}
-		}
-	}
-	else // x >= 2
-	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			profile = unhash(m);
-			if (profile.at(x) == players.at(x)->getNumStrats() - 2) // - 2 because we already incremented numStrats at the beginning
-			{
-				// create and insert new matrix
-				vector<vector<LinkedList<T>*> > newMatrix = vector<vector<LinkedList<T>*> >(players.at(0)->getNumStrats());
-				for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-					newMatrix.at(i).resize(players.at(1)->getNumStrats());
-				if ((unsigned)m == payoffMatrix.size() - 1)
-					payoffMatrix.push_back(newMatrix);
-				else
-					payoffMatrix.insert(payoffMatrix.begin() + m + 1, newMatrix);
-				
-				// enter values into new matrix m + 1
-				for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-				{
-					for (int j = 0; j < players.at(1)->getNumStrats(); j++) // add new lists to each new row
-					{				
-						profile.at(0) = i;
-						profile.at(1) = j;
-						
-						cout << "\t(";
-						for (int y = 0; y < numPlayers; y++)
-						{
-							if (y == x)
-								cout << profile.at(y) + 2;
-							else
-								cout << profile.at(y) + 1;
-							if (y < numPlayers - 1)
-								cout << ", ";
-						}
-						cout << "):\n";
-						
-						LinkedList<T>* newList = new LinkedList<T>;
-						payoffMatrix.at(m + 1).at(i).at(j) = newList;
-						curList = payoffMatrix.at(m + 1).at(i).at(j);
-						for (int y = 0; y < numPlayers; y++)
-						{
-							cout << "\t\tP_" << y + 1 << ":  ";
-							cin >> val;
-							curList->appendNode(val, false);
-						}
-					}
-				}
-				m = m + 2; // skip the matrix we just entered
-				}
-		}
 	}
-	if (impartial)
-		impartial = false;
 	
 	printPayoffMatrix();
 }
 
+// adds a strategy for P_x whose outcomes all have payoffs of 0
+template <typename T>
+GameStatus simGame<T>::appendStrategy(int x)
+{
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("there is no P_" + to_string(x + 1));
+	
+	vector<int> oldStrats = vector<int>(players.at(x)->getNumStrats() + 1);
+	for (int s = 0; s < players.at(x)->getNumStrats(); s++)
+		oldStrats.at(s) = s;
+	oldStrats.back() = -1;
+	
+	remapStrategies(x, oldStrats.size(), oldStrats);
+	return GameStatus();
+}
+
 // check if all equilibria are equal
 template <typename T>
 bool simGame<T>::allEqualEquilibria()
@@ -601,45 +582,59 @@ bool simGame<T>::bosCondition(vector<int> eq1, vector<int> eq2)
 		return false;
 }
 
+/* maxPayoffLengths(), which the print functions line the columns up with; 
+	it's computed on the first print and again only after an edit */
+template <typename T>
+const vector<vector<int> >& simGame<T>::cachedPayoffLengths()
+{
+	if (!payoffLengthsValid)
+	{
+		payoffLengths = maxPayoffLengths();
+		payoffLengthsValid = true;
+	}
+	return payoffLengths;
+}
+
 // change an individual payoff
 template <typename T>
 void simGame<T>::changeAPayoff(int x)
 {
-	int firstStrat, secondStrat, val;
-	LinkedList<T>* curList;
+	T val;
+	vector<int> profile = vector<int>(numPlayers, 0);
 	
 	cout << "For which strategy pair would you like to change P_" << x + 1 << "'s payoff?\n";
 	cout << "Enter P_1's strategy.  ";
-	cin >> firstStrat;
-	validate(firstStrat, 1, players.at(0)->getNumStrats());
+	cin >> profile.at(0);
+	validate(profile.at(0), 1, players.at(0)->getNumStrats());
 	
 	cout << "Enter P_2's strategy.  ";
-	cin >> secondStrat;
-	validate(secondStrat, 1, players.at(1)->getNumStrats());
+	cin >> profile.at(1);
+	validate(profile.at(1), 1, players.at(1)->getNumStrats());
 	cout << endl;
 	
 	cout << "Enter the value you would like to put in the matrix.  ";
 	cin >> val;
-	curList = payoffMatrix.at(0).at(firstStrat - 1).at(secondStrat - 1);
-	curList->setNodeValue(x, val);
+	profile.at(0)--;
+	profile.at(1)--;
+	setPayoff(profile, x, val);
 }
 
 // change all payoffs for a player
 template <typename T>
 void simGame<T>::changePayoffs(int x)
 {
-	int val = -1;
-	LinkedList<T>* curList;
+	T val;
+	vector<int> profile = vector<int>(numPlayers, 0);
 	
 	cout << "Enter the new payoffs for P_" << x + 1 << ".\n";
 	for (int i = 0; i < players.at(0)->getNumStrats(); i++)
 		for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 		{
-			curList = payoffMatrix.at(0).at(i).at(j);
-			
 			cout << "(s_" << i + 1 << ", s_" << j + 1 << "): ";
 			cin >> val;
-			curList->setNodeValue(x, val);
+			profile.at(0) = i;
+			profile.at(1) = j;
+			setPayoff(profile, x, val);
 		}
 }
 
@@ -927,74 +922,103 @@ bool simGame<T>::chickenCondition(vector<int> eq1, vector<int> eq2)
 		return false;
 }
 
-// checks if common knowledge
+// checks if every choice is common knowledge: every player knows that every player knows it, directly or passed on
 template <typename T>
 bool simGame<T>::commonKnowledge() const
 {
+	return computeCommonKnowledge(CHOICE_KNOWLEDGE).all();
+}
+
+// profile's outcome report, made once per profile in reports
+template <typename T>
+OutcomeReport<T> simGame<T>::cachedOutcomeReport(const vector<int> &profile, map<vector<int>, OutcomeReport<T> > &reports)
+{
+	typename map<vector<int>, OutcomeReport<T> >::iterator it = reports.find(profile);
+	if (it == reports.end())
+		it = reports.insert(make_pair(profile, outcomeReport(profile))).first;
+	return it->second;
+}
+
+/// @brief the outcomes of communication once the players' original choices are known; the players' stored choices are left alone
+/// @param originalChoices what players choose knowing nothing of the others' choices
+/// @param model
+/// @param world
+/// @param reports outcome reports already made, shared by calls on the same game
+template <typename T>
+CommunicationResult<T> simGame<T>::communicate(const vector<int> &originalChoices, const KripkeModel &model, int world,
+	map<vector<int>, OutcomeReport<T> > &reports)
+{
+	CommunicationResult<T> result;
+	vector<int> choices = originalChoices; // contains all knowledgable choices at end
+	vector<vector<int> > beliefs = vector<vector<int> >(numPlayers, originalChoices); // what each player thinks the others choose
+	vector<bool> ignorant = vector<bool>(numPlayers, false); // knows none of the others' choices, so keeps their own
+	const vector<int> &actual = model.getProfile(world);
+	
+	result.undecided = zs;
+	result.original = cachedOutcomeReport(originalChoices, reports);
+	
 	for (int x = 0; x < numPlayers; x++)
 	{
+		ignorant.at(x) = numPlayers > 1;
 		for (int y = 0; y < numPlayers; y++)
 		{
-			for (int z = 0; z < numPlayers; z++)
+			if (y != x && model.knowsChoice(x, y, world))
 			{
-				if (!players.at(x)->getKnowledge()->getchoiceKnowledge(y, z))
-					return false;
+				beliefs.at(x).at(y) = actual.at(y);
+				ignorant.at(x) = false;
 			}
 		}
+		vector<int> tempChoices = originalChoices; // contains only one knowledgable choice
+		if (!ignorant.at(x))
+			choices.at(x) = maxStratInRowColOrMatrices(x, beliefs.at(x)); // chooses P_x's choice based on other choices
+		tempChoices.at(x) = choices.at(x);
+		result.oneKnows.push_back(cachedOutcomeReport(tempChoices, reports));
+	}
+	result.allKnow = cachedOutcomeReport(choices, reports);
+	
+	// a player can anticipate another's response only if that player's choice is common knowledge
+	vector<bool> common = vector<bool>(numPlayers);
+	for (int y = 0; y < numPlayers; y++)
+		common.at(y) = model.commonKnowledge(model.choiceEvent(y, actual.at(y))).contains(world);
+	vector<int> responses = choices;
+	for (int x = 0; x < numPlayers; x++)
+	{
+		if (ignorant.at(x))
+			continue;
+		vector<int> anticipated = beliefs.at(x);
+		for (int y = 0; y < numPlayers; y++)
+		{
+			if (y == x || common.at(y))
+				anticipated.at(y) = responses.at(y);
+		}
+		choices.at(x) = maxStratInRowColOrMatrices(x, anticipated);
 	}
-	return true;
+	result.commonKnowledge = cachedOutcomeReport(choices, reports);
+	
+	return result;
 }
 
 // add communication
 template <typename T>
 void simGame<T>::communication()
 {
-	LinkedList<T>* curList;
-	vector<int> choices = vector<int>(numPlayers); // contains all knowledgable choices at end
-	vector<int> originalChoices = vector<int>(numPlayers); // contains no knowledgable choices
-	vector<int> tempChoices = vector<int>(numPlayers); // contains only one knowledgable choice
-	
-	computePureEquilibria(); // calls computeBestResponses()
-	determineType();
-	isMixed(); // needs pureEquilibria() and determineType()
-	computeChoices();
-	
-	// setting choices, originalChoices and tempChoices
-	for (int x = 0; x < numPlayers; x++)
+	CommunicationResult<T> result = computeCommunication();
+	if (!result.status.ok)
 	{
-		choices.at(x) = players.at(x)->getChoice();
-		originalChoices.at(x) = players.at(x)->getChoice();
-		tempChoices.at(x) = players.at(x)->getChoice();
+		cout << "\nERROR: " << result.status.error << endl;
+		return;
 	}
 	
-	/////////////////////////////////////////////////////////////////////////////
 	printPayoffMatrixSansInfo();
 	
 	cout << "Original Outcome: ";
-	if (zs)
+	if (result.undecided)
 		cout << "undecided for zero-sum games\n";
 	else
-	{
-		cout << "(";
-		for (int x = 0; x < numPlayers; x++)
-		{
-			cout << "s_" << originalChoices.at(x) + 1;
-			if (x < numPlayers - 1)
-				cout << ", ";
-		}
-		cout << ") -> ";
-		
-		if (numPlayers < 3)
-			curList = payoffMatrix.at(0).at(originalChoices.at(0)).at(originalChoices.at(1));
-		else
-			curList = payoffMatrix.at(hash(originalChoices)).at(originalChoices.at(0)).at(originalChoices.at(1));
-		
-		curList->displayPayoffs();
-	}
-	///////////////////////////////////////////////////////////////////////////////////////////////
+		printOutcome(result.original);
 	
 	cout << "\nPareto-optimal:  ";
-	if (PO(tempChoices))
+	if (result.original.paretoOptimal)
 		cout << "yes\n\n";
 	else
 		cout << "no\n\n";
@@ -1006,85 +1030,173 @@ void simGame<T>::communication()
 		else
 			cout << "If P_" << x + 1 << " knows the other players' choices:\n";
 		cout << "----------------------------------------\n";
-		players.at(x)->setChoice(maxStratInRowColOrMatrices(x, originalChoices)); // chooses P_x's choice based on other choices
-		choices.at(x) = players.at(x)->getChoice(); // choices should contain all players' choices at the end of this loop
-		tempChoices.at(x) = players.at(x)->getChoice();
-		
-		cout << "Current Outcome:  (";
-		for (int y = 0; y < numPlayers; y++)
-		{
-			cout << "s_" << tempChoices.at(y) + 1;
-			if (y < numPlayers - 1)
-				cout << ", ";
-		}
-		cout << ") -> ";
-		if (x == 0)
-			curList = payoffMatrix.at(hash(originalChoices)).at(tempChoices.at(0)).at(originalChoices.at(1));
-		else if (x == 1)
-			curList = payoffMatrix.at(hash(originalChoices)).at(originalChoices.at(0)).at(tempChoices.at(1));
-		else
-			curList = payoffMatrix.at(hash(tempChoices)).at(tempChoices.at(0)).at(tempChoices.at(1));
-		
-		curList->displayPayoffs();
+		cout << "Current Outcome:  ";
+		printOutcome(result.oneKnows.at(x));
 		
 		cout << "\nPareto-optimal:  ";
-		if (PO(tempChoices))
+		if (result.oneKnows.at(x).paretoOptimal)
 			cout << "yes\n\n";
 		else
 			cout << "no\n\n";
-		
-		tempChoices = originalChoices; // resetting tempChoices
 	}
 	
-	// all knowledgable choices
 	if (numPlayers == 2)
 		cout << "If both players know each other's choice:\n";
 	else
 		cout << "If all players know the others' choices:\n";
 	cout << "------------------------------------------\n";
-	cout << "Current Outcome:  (";
-	for (int x = 0; x < numPlayers; x++)
-	{
-		cout << "s_" << choices.at(x) + 1;
-		if (x < numPlayers - 1)
-			cout << ", ";
-	}
-	cout << ") -> ";
-	
-	curList = payoffMatrix.at(hash(choices)).at(choices.at(0)).at(choices.at(1));
-	curList->displayPayoffs();
+	cout << "Current Outcome:  ";
+	printOutcome(result.allKnow);
 	
 	cout << "\nPareto-optimal:  ";
-	if (PO(choices))
+	if (result.allKnow.paretoOptimal)
 		cout << "yes\n\n";
 	else
 		cout << "no\n\n";
 	
-	tempChoices = choices; // tempChoices not needed anymore, can repurpose it
-	for (int x = 0; x < numPlayers; x++)
-		choices.at(x) = maxStratInRowColOrMatrices(x, tempChoices);
-	
 	cout << "Common Knowledge:\n";
 	cout << "---------------------------------------\n";
-	cout << "Current Outcome:  (";
-	for (int x = 0; x < numPlayers; x++)
-	{
-		cout << "s_" << players.at(x)->getChoice() + 1;
-		if (x < numPlayers - 1)
-			cout << ", ";
-	}
-	cout << ") -> ";
-	
-	curList = payoffMatrix.at(hash(choices)).at(choices.at(0)).at(choices.at(1));
-	curList->displayPayoffs();
+	cout << "Current Outcome:  ";
+	printOutcome(result.commonKnowledge);
 	
 	cout << "\nPareto-optimal:  ";
-	if (PO(choices))
+	if (result.commonKnowledge.paretoOptimal)
 		cout << "yes\n";
 	else
 		cout << "no\n";
 }
 
+/// @brief the cognitive hierarchy model (see CognitiveHierarchy.h), which, unlike the k-matrix, handles mixed games
+/// @param levelProbabilities P(L_0), ..., P(L_K), e.g., from poissonLevels(); they're scaled to sum to 1
+/// @return each level's strategies, the predicted strategies, and expected utilities
+template <typename T>
+CognitiveHierarchyResult simGame<T>::computeCognitiveHierarchy(vector<double> levelProbabilities)
+{
+	return cognitiveHierarchy(toPayoffTensor(), levelProbabilities);
+}
+
+/// @brief what is common knowledge of one kind: (x, y) is set if every player knows that P_x knows P_y's information,
+/// either directly or through a chain of such links, players passing on what they know
+/// @param kind
+/// @return the least fixpoint of R = M or R * R, M being the and of the players' matrices, found by a transitive closure
+template <typename T>
+BitMatrix simGame<T>::computeCommonKnowledge(KnowledgeKind kind) const
+{
+	BitMatrix common = BitMatrix(numPlayers, true);
+	for (int x = 0; x < numPlayers; x++)
+	{
+		// a player added without knowledge of this game knows nothing of it
+		const Knowledge* knowledge = players.at(x)->getKnowledge();
+		if (knowledge == NULL || knowledge->getMatrix(kind).getSize() != numPlayers)
+			return BitMatrix(numPlayers);
+		common.andWith(knowledge->getMatrix(kind));
+	}
+	common.transitiveClosure();
+	return common;
+}
+
+// outcomes when one player, then every player, then every player with common knowledge, learns the others' choices
+template <typename T>
+CommunicationResult<T> simGame<T>::computeCommunication()
+{
+	vector<int> originalChoices;
+	GameStatus status = predictChoices(originalChoices);
+	if (!status.ok)
+	{
+		CommunicationResult<T> result;
+		result.status = status;
+		return result;
+	}
+	
+	// one world, so every player knows the others' choices, and that's common knowledge
+	KripkeModel model = KripkeModel(numPlayers, 1);
+	model.setProfile(0, originalChoices);
+	map<vector<int>, OutcomeReport<T> > reports;
+	return communicate(originalChoices, model, 0, reports);
+}
+
+/// @brief outcomes when players learn what model says they know of the others' choices at world
+/// @param model worlds labelled with the choices played there; see KripkeModel.h
+/// @param world the actual world
+/// @return as computeCommunication(), P_x knowing P_y's choice only if model says so at world, a player who
+/// knows none of the others' choices keeping their own, and the last round only anticipating the responses of
+/// players whose choices are common knowledge there
+template <typename T>
+CommunicationResult<T> simGame<T>::computeCommunication(const KripkeModel &model, int world)
+{
+	CommunicationResult<T> result;
+	if (model.getNumPlayers() != numPlayers)
+		result.status = GameStatus("the model has " + to_string(model.getNumPlayers()) + " players, not " + to_string(numPlayers));
+	else if (world < 0 || world >= model.getNumWorlds())
+		result.status = GameStatus("world " + to_string(world) + " is not in the model");
+	else if (model.getProfile(world).size() != (unsigned)numPlayers)
+		result.status = GameStatus("world " + to_string(world) + " has no strategy profile");
+	if (!result.status.ok)
+		return result;
+	for (int x = 0; x < numPlayers; x++)
+	{
+		if (model.getProfile(world).at(x) < 0 || model.getProfile(world).at(x) >= players.at(x)->getNumStrats())
+		{
+			result.status = GameStatus("P_" + to_string(x + 1) + " has no strategy " + to_string(model.getProfile(world).at(x) + 1));
+			return result;
+		}
+	}
+	
+	vector<int> originalChoices;
+	result.status = predictChoices(originalChoices);
+	if (!result.status.ok)
+		return result;
+	map<vector<int>, OutcomeReport<T> > reports;
+	return communicate(originalChoices, model, world, reports);
+}
+
+/// @brief the k-level engine's strategies at the levels of reasoning the players' knowledge supports
+/// @param model see KripkeModel.h
+/// @param rational rational.at(x) is the worlds at which P_x is rational
+/// @param world the actual world
+/// @param maxLevel the highest level
+/// @return P_x is L_0 if irrational at world, and otherwise L_d+1, d being how many levels of mutual
+/// knowledge of everyone's rationality P_x has there, up to maxLevel
+template <typename T>
+EpistemicLevelResult<T> simGame<T>::computeEpistemicLevels(const KripkeModel &model, const vector<WorldSet> &rational, int world, int maxLevel)
+{
+	EpistemicLevelResult<T> result;
+	if (model.getNumPlayers() != numPlayers)
+		result.status = GameStatus("the model has " + to_string(model.getNumPlayers()) + " players, not " + to_string(numPlayers));
+	else if (rational.size() != (unsigned)numPlayers)
+		result.status = GameStatus("expected " + to_string(numPlayers) + " rationality events, not " + to_string(rational.size()));
+	else if (world < 0 || world >= model.getNumWorlds())
+		result.status = GameStatus("world " + to_string(world) + " is not in the model");
+	else if (maxLevel < 0)
+		result.status = GameStatus("the highest level is negative");
+	if (!result.status.ok)
+		return result;
+	
+	WorldSet everyoneRational = WorldSet(model.getNumWorlds(), true);
+	for (int x = 0; x < numPlayers; x++)
+	{
+		if (rational.at(x).getNumWorlds() != model.getNumWorlds())
+		{
+			result.status = GameStatus("P_" + to_string(x + 1) + "'s rationality event isn't over the model's worlds");
+			return result;
+		}
+		everyoneRational.intersect(rational.at(x));
+	}
+	
+	kLevels.reset(toPayoffTensor());
+	vector<int> profile = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+	{
+		int level = 0;
+		if (maxLevel > 0 && rational.at(x).contains(world))
+			level = 1 + model.knowledgeDepth(x, everyoneRational, world, maxLevel - 1);
+		result.levels.push_back(level);
+		profile.at(x) = kLevels.strategy(level, x);
+	}
+	result.outcome = outcomeReport(profile);
+	return result;
+}
+
 // compute BR's
 template <typename T>
 void simGame<T>::computeBestResponses()
@@ -1146,12 +1258,13 @@ void simGame<T>::computeBestResponses()
 		}
 		else // x > 1
 		{
-			int m = 0;
-			int product = 1;
 			vector<int> profile = vector<int>(numPlayers);
-			while ((unsigned)m < payoffMatrix.size())
+			for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
 			{
+				// each section (the matrices differing only in P_x's strategy) is handled from its first matrix
 				profile = unhash(m);
+				if (profile.at(x) != 0)
+					continue;
 				for (int i = 0; i < players.at(0)->getNumStrats(); i++)
 					for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 					{						
@@ -1183,16 +1296,6 @@ void simGame<T>::computeBestResponses()
 						}
 					}
 				
-				// m = hash(profile);
-				// profile.at(x)--; // will be exactly numStrats at end, so decrement
-				// m = hash(profile); // at last matrix in section
-				
-				if (x > 2 && x < numPlayers - 1 && product == 1)
-				{
-					for (int y = 2; y <= x - 1; y++)
-						product *= players.at(y)->getNumStrats();
-				}
-				m += product;
 			}
 		}
 	}
@@ -1256,7 +1359,7 @@ void simGame<T>::computeChoices()
 				players.at(x)->setChoice(choices.at(x));
 		}
 	}
-	else
+	else if (verbose)
 	{
 		if (zs)
 			cout << "ERROR: computing pure choice for a ZS game\n";
@@ -1304,161 +1407,48 @@ vector<vector<Polynomial*> > simGame<T>::computeExpectedUtilities()
 	}
 	else // numPlayers >= 3
 	{
-		int num = -std::numeric_limits<T>::max();
-		vector<int> coeffs;
-		vector<vector<int>> exponents;
-		vector<int> profile;
+		/* one variable per (player, strategy): x_{offset_y + s} is the probability P_y chooses s_s, so
+		EU_x(s) = sum over the others' strategies of u_x(s, s_-x) * prod_{y != x} x_{offset_y + s_y} */
+		int numVariables = 0;
+		vector<int> offsets = vector<int>(numPlayers);
+		for (int y = 0; y < numPlayers; y++)
+		{
+			offsets.at(y) = numVariables;
+			numVariables += players.at(y)->getNumStrats();
+		}
 		
-		for (int x = 0; x < numPlayers; x++) // EU_x
+		// each outcome contributes exactly one term to one EU per player, so one builder per EU suffices
+		vector<vector<PolynomialBuilder> > builders = vector<vector<PolynomialBuilder> >(numPlayers);
+		for (int x = 0; x < numPlayers; x++)
+			builders.at(x).assign(players.at(x)->getNumStrats(), PolynomialBuilder(numVariables, numOutcomes / players.at(x)->getNumStrats()));
+		
+		vector<int> profile, alpha = vector<int>(numVariables); // alpha holds a term's exponents
+		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
 		{
-			cout << "x: " << x << endl;			
-			if (x == 0)
-			{
-				for (int i = 0; i < players.at(0)->getNumStrats(); i++) // EU_x(i)
+			profile = unhash(m);
+			for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+				for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 				{
-					coeffs = vector<int>(players.at(1)->getNumStrats() * payoffMatrix.size()); // coefficients for P_x's expected utilities
-					for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+					profile.at(0) = i;
+					profile.at(1) = j;
+					for (int x = 0; x < numPlayers; x++)
 					{
-						// Get Coefficients
-						profile = unhash(m);
-						profile.at(x) = std::numeric_limits<T>::quiet_NaN();
-						for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-						{
-							profile.at(0) = j;
-							exponents.push_back(profile); // save exponents along the way
-							
-							num = 1;
-							for (int y = 1; y < numPlayers; y++)
-							{
-								num *= payoffMatrix.at(m).at(i).at(j)->getNodeValue(y);
-								if (num == 0)
-									break;
-							}
-							coeffs.at(players.at(1)->getNumStrats() * m + j) += num;
-						}
+						for (int y = 0; y < numPlayers; y++)
+							alpha.at(offsets.at(y) + profile.at(y)) = (y != x);
+						builders.at(x).at(profile.at(x)).addTerm(payoffMatrix.at(m).at(i).at(j)->getNodeValue(x), alpha);
+						for (int y = 0; y < numPlayers; y++)
+							alpha.at(offsets.at(y) + profile.at(y)) = 0;
 					}
-					poly = new Polynomial(players.at(x)->getNumStrats(), numPlayers, 0);
-					poly->setEUCoefficients(coeffs, numPlayers);
-					EU.at(x).at(i) = poly;
 				}
-			}
-			else if (x == 1)
-			{				
-				for (int j = 0; j < players.at(1)->getNumStrats(); j++) // EU_x(j)
-				{
-					coeffs.clear();
-					coeffs.resize(players.at(0)->getNumStrats() * payoffMatrix.size()); // coefficients for P_x's expected utilities
-					for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-					{
-						profile = unhash(m);
-						profile.at(x) = std::numeric_limits<T>::quiet_NaN();
-						for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-						{
-							profile.at(0) = i;
-							exponents.push_back(profile);
-							
-							num = 1;
-							for (int y = 0; y < numPlayers; y++)
-							{
-								if (y != x)
-								{
-									num *= payoffMatrix.at(m).at(i).at(j)->getNodeValue(y);
-									if (num == 0)
-										break;
-								}
-							}
-							coeffs.at(players.at(0)->getNumStrats() * m + i) += num;
-						}
-					}					
-					poly = new Polynomial(players.at(x)->getNumStrats(), numPlayers, 0);
-					poly->setEUCoefficients(coeffs, numPlayers);
-					EU.at(x).at(j) = poly;
-				}
-			}
-			else // x >= 2
+		}
+		
+		for (int x = 0; x < numPlayers; x++)
+			for (int s = 0; s < players.at(x)->getNumStrats(); s++)
 			{
-				int num = 1, numMatricesInSection = 1, product = 1, size = -1, strat = -1;
-				vector<int> alpha; // holds each terms exponents
-				
-				if (numPlayers != 3)
-				{
-					for (int y = 2; y < numPlayers; y++)
-					{
-						if (y != x)
-							numMatricesInSection *= players.at(y)->getNumStrats();
-					}
-				}
-				size = players.at(0)->getNumStrats() * players.at(1)->getNumStrats() * numMatricesInSection;
-				
-				/* Comparing others' strategies based on what P_x's strategy is, keeping 
-				P_x's strategies the same, so we vary over the others' strategies */
-				strat = 0;
-				int count = 0, m = 0;
-				while (strat < players.at(x)->getNumStrats())
-				{
-					coeffs.clear();
-					coeffs.resize(size); // coefficients for P_x's expected utilities
-					m = 0;
-					count = 0;
-					while (count < numMatricesInSection)
-					{
-						profile = unhash(m);
-						profile.at(x) = strat;
-						for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-							for (int j = 0; j < players.at(1)->getNumStrats(); j++) // terms
-							{
-								// saving exponents
-								profile.at(0) = i;
-								profile.at(1) = j;
-								
-								num = 1;
-								for (int y = 0; y < numPlayers; y++)
-								{
-									if (y != x)
-									{										
-										num *= payoffMatrix.at(hash(profile)).at(i).at(j)->getNodeValue(y);
-										if (num == 0)
-											break;
-									}
-								}
-								coeffs.at(players.at(0)->getNumStrats() * players.at(1)->getNumStrats() * count + players.at(1)->getNumStrats() * i + j) += num;
-							}
-						
-						// done with profile, use it to save this terms set of exponents
-						profile.at(x) = std::numeric_limits<T>::quiet_NaN();
-						exponents.push_back(profile);
-						
-						if (product == 1 && x != numPlayers - 1)
-						{
-							if (x == 2)
-							{
-								for (int y = 2; y <= x; y++)
-									product *= players.at(y)->getNumStrats();
-							}
-							else if (x > 2)
-							{
-								for (int y = 2; y < x; y++)
-									product *= players.at(y)->getNumStrats();
-							}
-						}
-						m += product;
-						count++;
-					}
-					for (int n = 0; (unsigned)n < coeffs.size(); n++)
-						cout << "coeffs.at(" << n << "): " << coeffs.at(n) << endl;
-					
-					poly = new Polynomial(players.at(x)->getNumStrats(), numPlayers, 0);
-					poly->setEUCoefficients(coeffs, numPlayers);
-					poly->setEUExponents(exponents);
-					EU.at(x).at(strat) = poly;
-					
-					strat++;
-					if (strat < players.at(x)->getNumStrats())
-						cout << endl;
-				}
+				poly = new Polynomial();
+				builders.at(x).at(s).build(*poly);
+				EU.at(x).at(s) = poly;
 			}
-			cout << endl;
-		}
 		return EU;
 	}
 }
@@ -1479,111 +1469,131 @@ void simGame<T>::computeImpartiality()
 	impartial = true;
 }
 
-// compute k-strategies
+// starts the k-level engine on the current payoffs and sets each player's choice at their own rationality
 template <typename T>
 void simGame<T>::computeKStrategies()
 {	
-	int maxStrat = -std::numeric_limits<int>::max();
-	int num = -1;
-	vector<int> others;
+	kLevels.reset(toPayoffTensor());
+	for (int x = 0; x < numPlayers; x++)
+		players.at(x)->setKChoice(kLevels.strategy(players.at(x)->getRationality(), x));
+}
+
+/// @brief the k-rationalizability model for the given distribution of rationality levels; levels are computed
+/// only as deep as levelProbabilities and the players' rationalities reach, and players' levels are independent
+/// @param levelProbabilities P(L_0), ..., P(L_K); if they sum to less than 1, the rest is P(L_K+1)
+/// @return the k-matrix outcomes, their probabilities, the players' choices, and expected utilities
+template <typename T>
+KMatrixResult<T> simGame<T>::computeKMatrix(vector<double> levelProbabilities)
+{
+	KMatrixResult<T> result;
+	double sum = 0.0;
 	
-	for (int r = 0; r < 4; r++)
-		for (int x = 0; x < numPlayers; x++)
+	if (levelProbabilities.empty())
+	{
+		result.status = GameStatus("expected at least 1 rationality probability");
+		return result;
+	}
+	for (int r = 0; (unsigned)r < levelProbabilities.size(); r++)
+	{
+		if (levelProbabilities.at(r) < 0 || levelProbabilities.at(r) > 1)
 		{
-			maxStrat = -std::numeric_limits<int>::max();
-			
-			if (r == 0)
-			{
-				num = this->maxStrat(x); // num is what player x will do at L_0
-				kStrategies.at(0).at(x) = num;
-			}
-			else
-			{
-				others = vector<int>(numPlayers);
-				for (int y = 0; y < numPlayers; y++)
-				{
-					if (y == x)
-						others.at(y) = -1;
-					else
-						others.at(y) = kStrategies.at(r - 1).at(y);
-				}
-				
-				// finding the maximum in each row/column/matrix that has already been chosen
-				if (x == 0)
-				{
-					for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-					{
-						if (payoffMatrix.at(hash(others)).at(i).at(others.at(1))->getNodeBestResponse(0))
-							maxStrat = i; // maxStrat for player x
-					}
-				}
-				else if (x == 1)
-				{
-					for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-					{
-						if (payoffMatrix.at(hash(others)).at(others.at(0)).at(j)->getNodeBestResponse(1))
-							maxStrat = j;
-					}
-				}
-				else // x >= 2
-				{					
-					for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-						for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-						{
-							for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-							{
-								if (payoffMatrix.at(m).at(others.at(0)).at(others.at(1))->getNodeBestResponse(1))
-									maxStrat = unhash(m).at(x);
-							}
-						}
-					
-				}
-				kStrategies.at(r).at(x) = maxStrat;
-			}
-			if (r == players.at(x)->getRationality())
-				players.at(x)->setKChoice(kStrategies.at(r).at(x));
+			result.status = GameStatus("P(L_" + to_string(r) + ") is not between 0 and 1");
+			return result;
 		}
+		sum += levelProbabilities.at(r);
+	}
+	if (sum > 1 + 1e-9)
+	{
+		result.status = GameStatus("the rationality probabilities sum to more than 1");
+		return result;
+	}
+	if (sum < 1 - 1e-9)
+		levelProbabilities.push_back(1 - sum);
+	
+	kOutcomes.clear();
+	outcomeProbabilities.clear();
+	
+	computePureEquilibria(); // calls computeBestResponses()
+	determineType();
+	isMixed(); // needs pureEquilibria() and determineType()
+	if (mixed)
+	{
+		result.status = GameStatus("mixed k-rationalizability has not been implemented");
+		return result;
+	}
+	computeKStrategies(); // what players do at their rationality levels
+	
+	rationalityProbabilities = levelProbabilities;
+	kLevels.outcomeDistribution(levelProbabilities, kOutcomes, outcomeProbabilities);
 	
-	return;
+	vector<int> choices = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+		choices.at(x) = kLevels.strategy(players.at(x)->getRationality(), x);
+	
+	// no equilibria ==> can't compute a choice among equilibria
+	if (pureEquilibria.size() == 0)
+		result.undecided = "games with no pure equilibria";
+	else if (zs)
+		result.undecided = "zero-sum games";
+	else if (null) // similarly if all outcomes are equilibria
+		result.undecided = "null games";
+	else
+		result.outcome = outcomeReport(choices);
+	
+	result.expectedUtilities = kLevels.expectedUtilities(levelProbabilities);
+	result.levelProbabilities = levelProbabilities;
+	for (int r = 0; (unsigned)r < levelProbabilities.size(); r++)
+		result.kStrategies.push_back(kLevels.level(r));
+	result.outcomes = kOutcomes;
+	result.outcomeProbabilities = outcomeProbabilities;
+	result.choices = choices;
+	return result;
+}
+
+/// @brief the equilibrium the principal branch of logit QREs approaches (see QuantalResponse.h), for any number of
+/// players and whether or not best responses cycle
+/// @param maxLambda how far to trace the branch, e.g., 1e6
+/// @return the branch, the equilibrium, and the most a player gains by deviating from it
+template <typename T>
+QREPathResult simGame<T>::computeLogitEquilibrium(double maxLambda)
+{
+	return traceLogitQRE(toPayoffTensor(), maxLambda);
 }
 
 // compute mixed equilibria
 template <typename T>
 void simGame<T>::computeMixedEquilibria()
 {
+	char exact = '\n';
+	
 	computePureEquilibria();
 	cout << endl;
 	
-	// Generate combinations
-	int n = pureEquilibria.size();
-	for (int k = 2; k <= n; k++)
+	if (numPlayers != 2)
 	{
-		vector<int> combo = vector<int>(k);
-		for (int x = 0; x < k; x++)
-			combo.at(x) = x;
-		int maxUnsaturated = k - 1;
-		while (combo.at(0) < n - k + 1)
+		// support enumeration is only implemented for 2-player games
+		QREPathResult result = computeLogitEquilibrium(1e6);
+		if (!result.status.ok)
 		{
-			while (maxUnsaturated > 0 && combo.at(maxUnsaturated) == n - k + maxUnsaturated)
-				maxUnsaturated--;
-			
-			cout << "randomizing over (";
-			for (int a = 0; (unsigned)a < combo.size(); a++)
-			{
-				cout << "e_" << combo.at(a);
-				if ((unsigned)a < combo.size() - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-			
-			combo.at(maxUnsaturated)++;
-			while (maxUnsaturated < k - 1)
-			{
-				combo.at(maxUnsaturated + 1) = combo.at(maxUnsaturated) + 1;
-				maxUnsaturated++;
-			}
+			cout << "ERROR: " << result.status.error << endl;
+			return;
 		}
+		cout << "The limit of the logit quantal response equilibria (lambda = " << result.lambdas.back() << "):\n";
+		printMixedEquilibria(vector<vector<vector<double> > >(1, result.equilibrium));
+		cout << "Largest gain from deviating: " << result.regret << endl;
+		return;
 	}
+	
+	cout << "Use exact rational arithmetic? Enter y or n:  ";
+	cin >> exact;
+	validateChar(exact);
+	cout << endl;
+	
+	mixedEquilibria.clear();
+	if (exact == 'y' || exact == 'Y')
+		printMixedEquilibria(supportEnumeration<Rational>());
+	else
+		printMixedEquilibria(supportEnumeration<double>());
 }
 
 // compute mixed strategies
@@ -1597,6 +1607,13 @@ void simGame<T>::computeMixedStrategies()
 	
 	EU = computeExpectedUtilities();
 	cout << endl;
+	if (numPlayers >= 3)
+	{
+		cout << "where ";
+		for (int x = 0, v = 1; x < numPlayers; x++)
+			for (int s = 0; s < players.at(x)->getNumStrats(); s++, v++)
+				cout << "x_" << v << " = P(P_" << x + 1 << " chooses s_" << s + 1 << ")" << (x < numPlayers - 1 || s < players.at(x)->getNumStrats() - 1 ? ", " : "\n\n");
+	}
 	for (int x = 0; x < numPlayers; x++)
 	{
 		for (int n = 0; (unsigned)n < EU.at(x).size(); n++)
@@ -1607,6 +1624,10 @@ void simGame<T>::computeMixedStrategies()
 		if (x < numPlayers - 1)
 			cout << "--------------------------\n";
 	}
+	
+	for (int x = 0; x < numPlayers; x++)
+		for (int n = 0; (unsigned)n < EU.at(x).size(); n++)
+			delete EU.at(x).at(n);
 	/*cout << endl;
 	
 	if (EU.at(0).size() == 2)
@@ -1695,6 +1716,78 @@ bool simGame<T>::coordination()
 	return true;
 }
 
+/// @brief outcomes when each set of players, from nobody to everybody, reveals their choices to everyone
+/// @return for each set, the outcome when every player who learns a choice responds to it, and the outcome
+/// when they also anticipate the revealers' responses, which they can since the revelation is public;
+/// the equilibria and choices are computed once, and each outcome's report once, for all the sets
+template <typename T>
+RevelationResult<T> simGame<T>::computeRevelations()
+{
+	RevelationResult<T> result;
+	if (numPlayers > MAX_REVEALING_PLAYERS)
+	{
+		result.status = GameStatus("revelations are only tried for games of up to " + to_string(MAX_REVEALING_PLAYERS) + " players");
+		return result;
+	}
+	vector<int> originalChoices;
+	result.status = predictChoices(originalChoices);
+	if (!result.status.ok)
+		return result;
+	
+	map<vector<int>, OutcomeReport<T> > reports;
+	result.undecided = zs;
+	result.original = cachedOutcomeReport(originalChoices, reports);
+	for (int set = 0; set < (1 << numPlayers); set++)
+	{
+		// world 0 is the actual one; in each other world one player who doesn't reveal chooses differently,
+		// and nobody can tell the worlds apart, so only the revealers' choices are known, and commonly so
+		vector<int> revealing, hidden;
+		for (int y = 0; y < numPlayers; y++)
+		{
+			if (set & (1 << y))
+				revealing.push_back(y);
+			else if (players.at(y)->getNumStrats() > 1)
+				hidden.push_back(y);
+		}
+		KripkeModel model = KripkeModel(numPlayers, hidden.size() + 1);
+		model.setProfile(0, originalChoices);
+		for (int w = 1; w < model.getNumWorlds(); w++)
+		{
+			int y = hidden.at(w - 1);
+			vector<int> profile = originalChoices;
+			profile.at(y) = (profile.at(y) + 1) % players.at(y)->getNumStrats();
+			model.setProfile(w, profile);
+		}
+		for (int x = 0; x < numPlayers; x++)
+			model.setPartition(x, vector<int>(model.getNumWorlds(), 0));
+		
+		CommunicationResult<T> outcomes = communicate(originalChoices, model, 0, reports);
+		result.revealing.push_back(revealing);
+		result.responses.push_back(outcomes.allKnow);
+		result.anticipated.push_back(outcomes.commonKnowledge);
+	}
+	return result;
+}
+
+/// @brief simulates populations of players with random levels playing the game (see MonteCarlo.h)
+/// @param options how many populations, how large, and how their players choose
+/// @return outcome frequencies and the distributions of each role's average payoff
+template <typename T>
+SimulationResult simGame<T>::computeSimulation(const SimulationOptions &options)
+{
+	return simulatePopulations(toPayoffTensor(), options);
+}
+
+// determines the game's type, returning ZS, IH, PD, PC, BOS, Chicken, SH, NULL, or Undetermined
+template <typename T>
+string simGame<T>::computeType()
+{
+	computePureEquilibria(); // calls computeBestResponses()
+	determineType();
+	isMixed(); // needs pureEquilibria() and determineType()
+	return typeName();
+}
+
 // determine a game's type
 template <typename T>
 void simGame<T>::determineType()
@@ -1771,9 +1864,9 @@ void simGame<T>::editPlayer()
 	{
 		case 1:	cout << "Enter P_" << index << "'s rationality:  ";
 				cin >> r;
-				validate(r, 0, 3);
+				validate(r, 0, MAX_RATIONALITY);
 				cout << endl;
-				players.at(index - 1)->setRationality(r);
+				setRationality(index - 1, r);
 				break;
 		case 2:	addStrategy(index - 1);
 				break;
@@ -1955,6 +2048,36 @@ vector<vector<vector<bool> > > simGame<T>::extraSpacesInColumns()
 	return playersInColumns;
 }
 
+// mixed equilibria of a 2-player game by support enumeration
+template <typename T>
+SupportEnumerationResult<double> simGame<T>::findMixedEquilibria()
+{
+	mixedEquilibria.clear();
+	if (numPlayers != 2)
+	{
+		SupportEnumerationResult<double> result;
+		result.status = GameStatus("support enumeration is only implemented for 2-player games");
+		return result;
+	}
+	
+	computePureEquilibria();
+	return supportEnumeration<double>();
+}
+
+// whether P_x's strategy in profile is a best response to the others'; needs computeBestResponses()
+template <typename T>
+bool simGame<T>::getBestResponse(vector<int> profile, int x)
+{
+	return payoffMatrix.at(hash(profile)).at(profile.at(0)).at(profile.at(1))->getNodeBestResponse(x);
+}
+
+// P_x's payoff in the outcome profile
+template <typename T>
+T simGame<T>::getPayoff(vector<int> profile, int x)
+{
+	return payoffMatrix.at(hash(profile)).at(profile.at(0)).at(profile.at(1))->getNodeValue(x);
+}
+
 // converts a sequence of strategies into the index in a stack of payoff arrays that correspond to that sequence
 template <typename T>
 int simGame<T>::hash(vector<int> profile)
@@ -2083,7 +2206,7 @@ bool simGame<T>::isStrictlyDominant(int x, int s)
 					if (j != s)
 					{					
 						curList = payoffMatrix.at(m).at(i).at(j);
-						if (!curList->getNodeBestResponse(x))
+						if (curList->getNodeBestResponse(x)) // checks if any others are >=
 							return false;
 					}
 				}
@@ -2122,128 +2245,41 @@ bool simGame<T>::isStrictlyDominant(int x, int s)
 	return true;
 }
 
-// checks if s is strictly dominated
+// checks if s is strictly dominated: some other strategy t gives P_x more than s against every choice of the other players
 template <typename T>
 bool simGame<T>::isStrictlyDominated(int x, int s)
 {
-	// cout << "ISTRICTLYDOMINATED: (" << x << ", " << s << ")\n";
-	
-	bool domStrat = true;
-	LinkedList<T>* curList;
-	LinkedList<T>* sList;
-	
-	if (x == 0)
+	vector<int> sProfile, tProfile;
+	for (int t = 0; t < players.at(x)->getNumStrats(); t++)
 	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-			for (int i = 0; i < players.at(x)->getNumStrats(); i++)
-			{
-				if (i != s)
-				{
-					domStrat = true;
-					for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-					{
-						curList = payoffMatrix.at(m).at(i).at(j);
-						sList = payoffMatrix.at(m).at(s).at(j);
-						if (curList->getNodeValue(x) <= sList->getNodeValue(x)) // checks if > than s
-							domStrat = false;
-					}
-					if (domStrat)
-						return true;
-				}
-			}
+		if (t == s)
+			continue;
 		
-		return false;
-	}
-	else if (x == 1)
-	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++) // fix a matrix
-		{
-			// compare strat s in that row with all other values in that row
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++) // fix a row
-			{
-				for (int j = 0; j < players.at(x)->getNumStrats(); j++)
-				{
-					if (j != s)
-					{
-						domStrat = true;
-						curList = payoffMatrix.at(m).at(i).at(j);
-						sList = payoffMatrix.at(m).at(i).at(s);
-						if (curList->getNodeValue(x) <= sList->getNodeValue(x)) // checks if > than s
-							domStrat = false;
-					}
-				}
-				if (domStrat)
-					return true;
-			}
-		}
-		return false;
-	}
-	else // x >= 2
-	{
-		int curM = 0, m = 0, product = 1;
-		vector<int> curProfile = vector<int>(numPlayers);
-		vector<int> sProfile = vector<int>(numPlayers);
-		sProfile = unhash(0);
-		sProfile.at(x) = s;
-		m = hash(sProfile);
-		// cout << "start: " << m << endl;
-		while ((unsigned)m < payoffMatrix.size() - players.at(x)->getNumStrats() + s + 1) // selects s in each section
+		bool domStrat = true; // t dominates s in every outcome checked so far
+		for (int m = 0; (unsigned)m < payoffMatrix.size() && domStrat; m++)
 		{
-			// cout << "m: " << m << endl;
 			sProfile = unhash(m);
-			sProfile.at(x) = s;
-			while ((unsigned)curM < payoffMatrix.size()) // checks other sections for dominant strategies
+			if (x >= 2 && sProfile.at(x) != s) // only the matrices where P_x chooses s
+				continue;
+			for (int i = 0; i < players.at(0)->getNumStrats() && domStrat; i++)
 			{
-				// cout << "\tcurM: " << curM << endl;
-				curProfile = unhash(curM);
-				if (curProfile != sProfile)
-				{
-					for (int i = 0; i < players.at(0)->getNumStrats(); i++) // row in s
-					{
-						int j = 0;
-						while (j < players.at(1)->getNumStrats() && domStrat) // column in s
-						{		
-							// cout << "\t\ti: " << i << endl;
-							// cout << "\t\tj: " << j << endl;
-							
-							curList = payoffMatrix.at(curM).at(i).at(j);
-							sList = payoffMatrix.at(hash(sProfile)).at(i).at(j);
-							
-							// cout << "\t\t\t" << curList->getNodeValue(x) << ", " << sList->getNodeValue(x) << endl;
-							
-							if (curList->getNodeValue(x) <= sList->getNodeValue(x)) // checks if > than s
-							// {
-								// cout << "\t\t\tWEEWOO\n";
-								domStrat = false;
-							// }
-							j++;
-						}
-					}
-					if (domStrat)
-					// {
-						// cout << "\tleaving\n";
-						return true;
-					// }
-				}
-				
-				if (x > 2 && x < numPlayers - 1 && product == 1)
+				for (int j = 0; j < players.at(1)->getNumStrats() && domStrat; j++)
 				{
-					for (int y = 2; y <= x - 1; y++)
-						product *= players.at(y)->getNumStrats();
+					sProfile.at(0) = i;
+					sProfile.at(1) = j;
+					if (sProfile.at(x) != s)
+						continue;
+					tProfile = sProfile;
+					tProfile.at(x) = t;
+					if (getPayoff(tProfile, x) <= getPayoff(sProfile, x))
+						domStrat = false;
 				}
-				curM += product; // move to the next one, which is the first in the next section
-				// cout << "\tnext1: " << curM << endl;
-			}
-			if (x > 2 && x < numPlayers - 1 && product == 1)
-			{
-				for (int y = 2; y <= x - 1; y++)
-					product *= players.at(y)->getNumStrats();
 			}
-			m += product; // move to next matrix in section of the s strategy, which is the first in the next section
-			// cout << "next2\n";
 		}
-		return false;
+		if (domStrat)
+			return true;
 	}
+	return false;
 }
 
 // checks if s is weakly dominant
@@ -2491,40 +2527,143 @@ bool simGame<T>::isWeaklyDominated(int x, int s)
 	return true;
 }
 
-// returns vector w/ maximum number of characters added by brackets in BR's in each column
+/// @brief copies game k of corpus into this game; the game is unchanged if it's damaged
+/// @param corpus 
+/// @param k from 0 to corpus.getNumGames() - 1
+/// @return 
 template <typename T>
-vector<vector<int> > simGame<T>::maxBestResponseLengths()
-{	
-	int temp = 0; // holds values while finding the max
-	LinkedList<T>* curList;
-	string str;
-	vector<vector<int> > lengths = vector<vector<int> >(payoffMatrix.size()); // stores the maximum values once they're found
-	
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		lengths.at(m).resize(players.at(1)->getNumStrats());
-		for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-		{
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++) // check each row for max
-			{
-				temp = 0;
-				curList = payoffMatrix.at(m).at(i).at(j);
-				for (int x = 0; x < numPlayers; x++)
-				{					
-					if (curList->getNodeBestResponse(x));
-						temp +=2;
-				}
-				if (temp > lengths.at(m).at(j))
-					lengths.at(m).at(j) = temp;
-			}
-		}
-	}
-	return lengths;
+GameStatus simGame<T>::loadFromCorpus(const GameCorpus &corpus, size_t k)
+{
+	BinaryGame binary;
+	PayoffTensor<T> payoffs;
+	GameStatus status = corpus.game(k, binary);
+	if (status.ok && binary.getNumPayoffs() > (uint64_t)INT_MAX)
+		status = GameStatus(corpus.getName() + "#" + to_string(k) + " is too large to load; see StreamingAnalysis.h");
+	if (status.ok)
+		status = binary.verify();
+	if (status.ok)
+		status = binary.payoffs(payoffs);
+	if (!status.ok)
+		return status;
+	
+	loadPayoffs(payoffs);
+	for (int x = 0; x < numPlayers; x++)
+		players.at(x)->setRationality(binary.getRationalities().at(x));
+	return GameStatus();
 }
 
-/* UNNECESSARY: NOTHING CHANGES *BUT* THE PAYOFFS
+/// @brief reads a game saved by writeToFile(), writeBinaryFile(), or writeNfgFile() (or any Gambit .nfg file); the game is unchanged if the file is invalid
+/// @param filename 
+/// @return 
 template <typename T>
-vector<vector<int> > simGame<T>::maxEntryLengths(vector<vector<vector<bool> > > extraSpaces)
+GameStatus simGame<T>::loadFromFile(string filename)
+{
+	// everything is read and checked before the game is changed
+	PayoffTensor<T> payoffs;
+	vector<int> rationalities;
+	BinaryGame binary;
+	GameStatus status;
+	if (isBinaryGame(filename))
+	{
+		status = binary.open(filename);
+		if (status.ok && binary.getNumPayoffs() > (uint64_t)INT_MAX)
+			status = GameStatus(filename + " is too large to load; see StreamingAnalysis.h");
+		if (status.ok)
+			status = binary.verify();
+		if (status.ok)
+			status = binary.payoffs(payoffs);
+		rationalities = binary.getRationalities();
+	}
+	else if (isNfgFile(filename))
+	{
+		// .nfg files don't have rationalities
+		status = readNfg(filename, payoffs);
+		rationalities = vector<int>(payoffs.getNumPlayers(), 0);
+	}
+	else
+		status = readGame(filename, payoffs, rationalities);
+	if (!status.ok)
+		return status;
+	
+	loadPayoffs(payoffs);
+	for (int x = 0; x < numPlayers; x++)
+		players.at(x)->setRationality(rationalities.at(x));
+	return GameStatus();
+}
+
+// sets the dimensions and every payoff from payoffs; rationalities are kept and new players are L_0
+template <typename T>
+void simGame<T>::loadPayoffs(const PayoffTensor<T> &payoffs)
+{
+	setDimensions(payoffs.getNumStrats());
+	
+	const T* p = payoffs.data();
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++, p += numPlayers)
+				payoffMatrix.at(m).at(i).at(j)->setNodeValues(p);
+}
+
+// index of the matrix containing profile for the given numbers of strategies; hash() without computeImpartiality()
+template <typename T>
+int simGame<T>::matrixIndex(const vector<int> &profile, const vector<int> &numStrats) const
+{
+	int m = 0, stride = 1;
+	for (int x = 2; x < numPlayers; x++)
+	{
+		m += stride * profile.at(x);
+		stride *= numStrats.at(x);
+	}
+	return m;
+}
+
+// inverse of matrixIndex(); profile.at(0) and profile.at(1) are -1
+template <typename T>
+vector<int> simGame<T>::matrixProfile(int m, const vector<int> &numStrats) const
+{
+	vector<int> profile = vector<int>(numPlayers, -1);
+	for (int x = 2; x < numPlayers; x++)
+	{
+		profile.at(x) = m % numStrats.at(x);
+		m /= numStrats.at(x);
+	}
+	return profile;
+}
+
+// returns vector w/ maximum number of characters added by brackets in BR's in each column
+template <typename T>
+vector<vector<int> > simGame<T>::maxBestResponseLengths()
+{	
+	int temp = 0; // holds values while finding the max
+	LinkedList<T>* curList;
+	string str;
+	vector<vector<int> > lengths = vector<vector<int> >(payoffMatrix.size()); // stores the maximum values once they're found
+	
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+	{
+		lengths.at(m).resize(players.at(1)->getNumStrats());
+		for (int j = 0; j < players.at(1)->getNumStrats(); j++)
+		{
+			for (int i = 0; i < players.at(0)->getNumStrats(); i++) // check each row for max
+			{
+				temp = 0;
+				curList = payoffMatrix.at(m).at(i).at(j);
+				for (int x = 0; x < numPlayers; x++)
+				{					
+					if (curList->getNodeBestResponse(x));
+						temp +=2;
+				}
+				if (temp > lengths.at(m).at(j))
+					lengths.at(m).at(j) = temp;
+			}
+		}
+	}
+	return lengths;
+}
+
+/* UNNECESSARY: NOTHING CHANGES *BUT* THE PAYOFFS
+template <typename T>
+vector<vector<int> > simGame<T>::maxEntryLengths(vector<vector<vector<bool> > > extraSpaces)
 {	
 	cout << "MAXENTRYLENGTHS\n";
 	// returns vector w/ maximum number of characters 
@@ -2638,24 +2777,20 @@ template <typename T>
 vector<vector<int> > simGame<T>::maxPayoffLengths()
 {		
 	int temp = 0; // holds values while finding the max
-	LinkedList<T>* curList;
-	string str;
+	vector<T> values = vector<T>(numPlayers);
 	vector<vector<int> > lengths = vector<vector<int> >(payoffMatrix.size()); // stores the maximum values once they're found
 	
 	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
 	{
 		lengths.at(m).resize(players.at(1)->getNumStrats());
-		for (int j = 0; j < players.at(1)->getNumStrats(); j++)
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++) // row by row, as the lists are stored
 		{
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++) // check each row for max
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 			{
 				temp = 0;
-				curList = payoffMatrix.at(m).at(i).at(j);
+				payoffMatrix.at(m).at(i).at(j)->getNodeValues(&values[0]);
 				for (int x = 0; x < numPlayers; x++)
-				{					
-					str = to_string(curList->getNodeValue(x));
-					temp += str.length();
-				}
+					temp += formattedLength(values.at(x));
 				if (temp > lengths.at(m).at(j))
 					lengths.at(m).at(j) = temp;
 			}
@@ -2774,6 +2909,80 @@ int simGame<T>::maxStrat(int x)
 	return maxStrat;
 }
 
+// offers to print another part of a game that didn't fit in the print window; true if the window was moved
+template <typename T>
+bool simGame<T>::movePrintWindow()
+{
+	char move = '\n';
+	int first;
+	
+	cout << "Print another part of the game? Enter y or n:  ";
+	cin >> move;
+	validateChar(move);
+	if (move != 'y')
+		return false;
+	
+	if (payoffMatrix.size() > 1)
+	{
+		cout << "Enter the first matrix to print, from 1 to " << payoffMatrix.size() << ":  ";
+		cin >> first;
+		validate(first, 1, payoffMatrix.size());
+		window.firstMatrix = first - 1;
+	}
+	cout << "Enter the first row to print, from 1 to " << players.at(0)->getNumStrats() << ":  ";
+	cin >> first;
+	validate(first, 1, players.at(0)->getNumStrats());
+	window.firstRow = first - 1;
+	
+	cout << "Enter the first column to print, from 1 to " << players.at(1)->getNumStrats() << ":  ";
+	cin >> first;
+	validate(first, 1, players.at(1)->getNumStrats());
+	window.firstColumn = first - 1;
+	return true;
+}
+
+// prints the matrices in layout, a window at a time if they're too large to print whole;
+// the window is put back afterward, so paging doesn't change where the next print starts
+template <typename T>
+void simGame<T>::printMatrices(MatrixLayout layout)
+{
+	PrintWindow start = window;
+	bool truncated = writeMatrices(layout);
+	while (truncated && movePrintWindow())
+		truncated = writeMatrices(layout);
+	window = start;
+}
+
+/// @brief the next levels of the players past P_2, P_3's changing fastest; P_1's and P_2's are left alone
+/// @param levels one per player
+/// @param numLevels
+/// @return false after the last, with those levels back at 0
+template <typename T>
+bool simGame<T>::nextLevelProfile(vector<int> &levels, int numLevels)
+{
+	for (int x = 2; x < numPlayers; x++)
+	{
+		if (++levels.at(x) < numLevels)
+			return true;
+		levels.at(x) = 0;
+	}
+	return false;
+}
+
+// the payoffs of profile and whether it's Pareto-optimal
+template <typename T>
+OutcomeReport<T> simGame<T>::outcomeReport(vector<int> profile)
+{
+	OutcomeReport<T> report;
+	LinkedList<T>* curList = payoffMatrix.at(hash(profile)).at(profile.at(0)).at(profile.at(1));
+	
+	report.profile = profile;
+	for (int x = 0; x < numPlayers; x++)
+		report.payoffs.push_back(curList->getNodeValue(x));
+	report.paretoOptimal = PO(profile);
+	return report;
+}
+
 // checks if strategy is Pareto-optimal
 template <typename T>
 bool simGame<T>::PO(vector<int> stratProfile)
@@ -2963,6 +3172,32 @@ bool simGame<T>::PO(vector<int> stratProfile)
 	}
 }
 
+// computes what each player chooses knowing nothing of the others' choices, failing if some player has no choice
+template <typename T>
+GameStatus simGame<T>::predictChoices(vector<int> &choices)
+{
+	computePureEquilibria(); // calls computeBestResponses()
+	determineType();
+	isMixed(); // needs pureEquilibria() and determineType()
+	computeChoices();
+	
+	choices = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+	{
+		choices.at(x) = players.at(x)->getChoice();
+		if (choices.at(x) < 0 || choices.at(x) >= players.at(x)->getNumStrats())
+		{
+			if (null)
+				return GameStatus("no choices can be computed for a null game");
+			else if (pureEquilibria.size() == 0)
+				return GameStatus("no choices can be computed for a game with no pure equilibria");
+			else
+				return GameStatus("no choices can be computed for a zero-sum game");
+		}
+	}
+	return GameStatus();
+}
+
 // print BR's
 template <typename T>
 void simGame<T>::printBestResponses()
@@ -2975,55 +3210,7 @@ void simGame<T>::printBestResponses()
 	isMixed(); // needs pureEquilibria() and determineType()
 	computeChoices(); // needs isMixed()
 
-	vector<int> stratProfile = vector<int>(numPlayers);
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		cout << endl;
-		if (numPlayers > 2)
-		{			
-			stratProfile = unhash(m);
-		
-			if (numPlayers == 3)
-				cout << "(c_3) = (";
-			else if (numPlayers == 4)
-				cout << "(c_3, c_4) = (";
-			else if (numPlayers == 5)
-				cout << "(c_3, c_4, c_5) = (";
-			else if (numPlayers == 6)
-				cout << "(c_3, c_4, c_5, c_6) = (";
-			else
-				cout << "(c_3, ..., c_" << numPlayers << ") = (";
-			for (int x = 2; x < numPlayers; x++)
-			{
-				cout << stratProfile.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-		}
-		
-		if (m == 0)
-			cout << "BR   s_1";
-		else
-			cout << "    s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			cout << setw(numPlayers + 2 * (numPlayers - 1) + 2) << "s_" << j + 1; // nP + (comma + space) * (nP - 1) + 2 parentheses
-		cout << endl;
-		
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++) // i-th row
-		{
-			cout << "s_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++) // j-th column
-			{
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayBRs();
-				if (j != players.at(1)->getNumStrats() - 1)
-					cout << " ";
-			}
-			cout << endl;
-		}
-		cout << endl;
-	}
+	printMatrices(BRS_ONLY);
 	
 	for (int x = 0; x < numPlayers; x++)
 		choices.at(x) = players.at(x)->getChoice();
@@ -3101,75 +3288,7 @@ void simGame<T>::printBothSeparately()
 	isMixed(); // needs pureEquilibria() and determineType()
 	computeChoices(); // needs isMixed()
 	
-	vector<int> stratProfile = vector<int>(numPlayers);
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		cout << endl;
-		if (numPlayers > 2)
-		{			
-			stratProfile = unhash(m);
-		
-			if (numPlayers == 3)
-				cout << "(c_3) = (";
-			else if (numPlayers == 4)
-				cout << "(c_3, c_4) = (";
-			else if (numPlayers == 5)
-				cout << "(c_3, c_4, c_5) = (";
-			else if (numPlayers == 6)
-				cout << "(c_3, c_4, c_5, c_6) = (";
-			else
-				cout << "(c_3, ..., c_" << numPlayers << ") = (";
-			for (int x = 2; x < numPlayers; x++)
-			{
-				cout << stratProfile.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-		}
-		
-		vector<vector<int> > lengths = maxPayoffLengths();
-		
-		cout << "     s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			cout << setw(lengths.at(m).at(j) + 2 * numPlayers) << "s_" << j + 1; // length + comma + spaces + parentheses
-		
-		cout << "\tBR   s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			cout << setw(2 + 2 * numPlayers) << "s_" << j + 1; // 2 + comma + spaces + parentheses
-		cout << endl;
-		
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++) // i-th row
-		{
-			cout << "s_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++) // j-th column
-			{
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayPayoffs();
-				if (j < players.at(1)->getNumStrats() - 1)
-				{
-					if (lengths.at(m).at(j) - entryPayoffLengths(m, i, j) != 0)
-					{
-						// cout << right << setw(maxLengths.at(m).at(j) - entryLength(extraSpaces, m, i, j));
-						for (int n = 0; n < lengths.at(m).at(j) - entryPayoffLengths(m, i, j); n++)
-							cout << " ";
-					}
-					cout << " ";
-				}
-			}
-			
-			cout << "\ts_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++) // j-th column
-			{
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayBRs();				
-				if (j < players.at(1)->getNumStrats() - 1)
-					cout << " ";
-			}
-			cout << endl;
-		}
-		cout << endl;
-	}
+	printMatrices(PAYOFFS_THEN_BRS);
 
 	for (int x = 0; x < numPlayers; x++)
 		choices.at(x) = players.at(x)->getChoice();
@@ -3235,78 +3354,126 @@ void simGame<T>::printBothSeparately()
 	}
 }
 
+// print the cognitive hierarchy model with Poisson or entered level probabilities
+template <typename T>
+void simGame<T>::printCognitiveHierarchy()
+{
+	double tau = -1, num = -1;
+	int maxLevel = -1;
+	vector<double> levelProbabilities;
+	
+	cout << "Enter the mean level for Poisson levels (1.5 is typical), or 0 to enter each level's probability:  ";
+	cin >> tau;
+	validateDouble(tau, 0, 100);
+	if (tau > 0)
+		levelProbabilities = poissonLevels(tau, poissonMaxLevel(tau));
+	else
+	{
+		cout << "Enter the highest level:  ";
+		cin >> maxLevel;
+		validate(maxLevel, 0, 100);
+		for (int r = 0; r <= maxLevel; r++)
+		{
+			cout << "P(L_" << r << "): ";
+			cin >> num;
+			validateDouble(num, 0, 1);
+			levelProbabilities.push_back(num);
+		}
+	}
+	
+	CognitiveHierarchyResult result = computeCognitiveHierarchy(levelProbabilities);
+	if (!result.status.ok)
+	{
+		cout << "\nERROR: " << result.status.error << endl;
+		return;
+	}
+	
+	printPayoffMatrixSansInfo();
+	
+	vector<vector<double> > strategies;
+	for (int k = 0; (unsigned)k <= result.levelStrategies.size(); k++)
+	{
+		if ((unsigned)k < result.levelStrategies.size())
+		{
+			strategies = result.levelStrategies.at(k);
+			cout << "L_" << k << " (P = " << result.levelProbabilities.at(k) << "):  ";
+		}
+		else
+		{
+			strategies = result.prediction;
+			cout << "Prediction:  ";
+		}
+		for (int x = 0; x < numPlayers; x++)
+		{
+			cout << "(";
+			for (int s = 0; (unsigned)s < strategies.at(x).size(); s++)
+			{
+				cout << strategies.at(x).at(s);
+				if ((unsigned)s < strategies.at(x).size() - 1)
+					cout << ", ";
+			}
+			cout << ")";
+			if (x < numPlayers - 1)
+				cout << ", ";
+		}
+		cout << endl;
+	}
+	cout << endl;
+	
+	for (int x = 0; x < numPlayers; x++)
+		cout << "EU_" << x + 1 << " = " << result.expectedUtilities.at(x) << endl;
+}
+
 // print k-matrix
 template <typename T>
 void simGame<T>::printKMatrix()
 {
 	char save = '\n';
-	LinkedList<T>* curList;
-	vector<int> curEntry;
-	vector<int> temp; // used to fill kOutcomes
-	bool inOutcomes = false;
-	int index = 0;
-	double num = -1, probability = -1.0, sum = 0.0;
-	vector<double> EU(numPlayers, 0.0);
-	
-	computePureEquilibria();
-	kOutcomes.clear();
-	outcomeProbabilities.clear();
+	double num = -1, sum = 0.0;
+	int maxLevel = -1;
+	vector<double> levelProbabilities;
 	
 	computePureEquilibria(); // calls computeBestResponses()
 	determineType();
 	isMixed(); // needs pureEquilibria() and determineType()
 	if (mixed)
 	{
-		cout << "\nERROR: mixed k-rationalizability has not been implemented\n";
+		cout << "\nMixed k-rationalizability has not been implemented; using the cognitive hierarchy model instead.\n";
+		printCognitiveHierarchy();
 		return;
 	}
-	computeKStrategies(); // what players do at each rationality level
 	
+	cout << "Enter the highest level of rationality:  ";
+	cin >> maxLevel;
+	validate(maxLevel, 1, MAX_RATIONALITY);
 	cout << "Enter the probability that a player will be a given level of rationality.\n";
-	for (int r = 0; r < 3; r++)
+	for (int r = 0; r < maxLevel; r++)
 	{
 		cout << "P(L_" << r << "): ";
 		cin >> num;
 		validateDouble(num, 0, 1);
 		sum += num;
-		setRationalityProbability(r, num);
+		levelProbabilities.push_back(num);
 	}
-	cout << "P(L_3) = 1 - " << sum << " = " << 1 - sum;
+	cout << "P(L_" << maxLevel << ") = 1 - " << sum << " = " << 1 - sum;
+	levelProbabilities.push_back(1 - sum); // so that the highest level is shown even if it has probability 0
 	
-	setRationalityProbability(3, 1 - sum);
+	KMatrixResult<T> result = computeKMatrix(levelProbabilities);
+	if (!result.status.ok)
+	{
+		cout << "\nERROR: " << result.status.error << endl;
+		return;
+	}
 	
 	printPayoffMatrixSansInfo();
 	
-	// printing k-matrix
-	vector<int> rationalityProfile = vector<int>(numPlayers); // for labelling each matrix
-	for (int m = 0; (unsigned)m < kMatrix.size(); m++)
-	{		
-		for (int r1 = 0; r1 < 4; r1++) // L_r1 row
-			for (int r2 = 0; r2 < 4; r2++) // L_r2 column
-			{
-				temp.push_back(kStrategies.at(r1).at(0));
-				temp.push_back(kStrategies.at(r2).at(1));
-				for (int x = 2; x < numPlayers; x++)
-					temp.push_back(kStrategies.at(rUnhash(m).at(x)).at(x));
-				
-				kMatrix.at(m).at(r1).at(r2) = temp;
-				
-				inOutcomes = false;
-				for (int n = 0; n < getSizeKOutcomes(); n++)
-				{
-					if (getKOutcome(n) == temp)
-						inOutcomes = true;
-				}
-				if (!inOutcomes)
-					pushKOutcome(temp);
-				temp.clear();
-			}
-		
-		
+	// printing k-matrix, a matrix per level of each player past P_2
+	int numLevels = result.levelProbabilities.size();
+	vector<int> rationalityProfile = vector<int>(numPlayers, 0); // for labelling each matrix
+	do
+	{
 		if (numPlayers > 2)
-		{			
-			rationalityProfile = rUnhash(m);
-		
+		{
 			if (numPlayers == 3)
 				cout << "(l_3) = (";
 			else if (numPlayers == 4)
@@ -3319,7 +3486,7 @@ void simGame<T>::printKMatrix()
 				cout << "(l_3, ..., l_" << numPlayers << ") = (";
 			for (int x = 2; x < numPlayers; x++)
 			{
-				cout << rationalityProfile.at(x) + 1;
+				cout << rationalityProfile.at(x);
 				if (x < numPlayers - 1)
 					cout << ", ";
 			}
@@ -3327,134 +3494,78 @@ void simGame<T>::printKMatrix()
 		}
 		
 		cout << "     L_0";
-		for (int r2 = 1; r2 < 4; r2++)
+		for (int r2 = 1; r2 < numLevels; r2++)
 			cout << setw(5 * numPlayers) << "L_" << r2;
 		cout << endl;
 		
-		for (int r1 = 0; r1 < 4; r1++) // L_r1 row
+		for (int r1 = 0; r1 < numLevels; r1++) // L_r1 row
 		{
+			rationalityProfile.at(0) = r1;
 			cout << "L_" << r1 << " ";
-			for (int r2 = 0; r2 < 4; r2++) // L_r2 column
+			for (int r2 = 0; r2 < numLevels; r2++) // L_r2 column
 			{
-				curEntry = kMatrix.at(m).at(r1).at(r2);
+				rationalityProfile.at(1) = r2;
 				cout << "(";
 				for (int x = 0; x < numPlayers; x++) // gets the whole n-tuple entry
 				{
-					cout << "s_" << curEntry.at(x) + 1; // getKStrategy(r1).at(x) + 1 || getKStrategy(r2).at(x) + 1???
+					cout << "s_" << kLevels.strategy(rationalityProfile.at(x), x) + 1;
 					if (x < numPlayers - 1)
 						cout << ", ";
 				}
 				cout << ")";
-				if (r2 < 3)
+				if (r2 < numLevels - 1)
 					cout << " ";
 			}
 			cout << endl;
 		}
 		cout << endl;
-	}
-
-	// fill with 0.0
-	for (int n = 0; n < getSizeKOutcomes(); n++)
-		outcomeProbabilities.push_back(0.0);
+	} while (nextLevelProfile(rationalityProfile, numLevels));
 	
-	for (int r1 = 0; r1 < 4; r1++) // L_r1
-		for (int r2 = 0; r2 < 4; r2++) // L_r2
+	if (result.undecided.empty())
+	{
+		cout << "Current Outcome: (";
+		for (int x = 0; x < numPlayers; x++)
 		{
-			probability = 0.0;
-			
-			// find to which outcome the kMatrix entry corresponds
-			index = 0;
-			while (getKOutcome(index).at(0) != getKStrategy(r1).at(0) || getKOutcome(index).at(1) != getKStrategy(r2).at(1))
-				index++;
-			
-			probability += getRationalityProbability(r1) * getRationalityProbability(r2); // adding P(L_r1, L_r2)
-			
-			setOutcomeProbability(index, getOutcomeProbability(index) + probability);
+			cout << "L_" << players.at(x)->getRationality();
+			if (x < numPlayers - 1)
+				cout << ", ";
 		}
-	
-	vector<int> choices = vector<int>(numPlayers);
-	for (int x = 0; x < numPlayers; x++)
-	{
-		choices.at(x) = kStrategies.at(players.at(x)->getRationality()).at(x);
-		players.at(x)->setKChoice(choices.at(x));
-	}
-	
-	if (pureEquilibria.size() != 0) // no equilibria ==> can't compute a choice among equilibria
-	{
-		cout << "Current Outcome: ";
-		if (zs)
-			cout << "undecided for zero-sum games\n";
-		else if (null) // similarly if all outcomes are equilibria
-			cout << "undecided for null games\n";
+		cout << ") -> ";
+		printOutcome(result.outcome);
+		
+		cout << "\nPareto-optimal:  ";
+		if (result.outcome.paretoOptimal)
+			cout << "yes\n\n";
 		else
-		{
-			cout << "(";
-			for (int x = 0; x < numPlayers; x++)
-			{
-				cout << "L_" << players.at(x)->getRationality();
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			
-			cout << ") -> (";
-			for (int x = 0; x < numPlayers; x++)
-			{
-				cout << "s_" << choices.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			
-			cout << ") -> ";
-			curList = payoffMatrix.at(hash(choices)).at(choices.at(0)).at(choices.at(1));
-			curList->displayPayoffs();
-			
-			cout << "\nPareto-optimal:  ";
-			if (PO(choices))
-				cout << "yes\n\n";
-			else
-				cout << "no\n\n";
-		}
+			cout << "no\n\n";
 	}
+	else if (pureEquilibria.size() == 0)
+		cout << "currently undecided for " << result.undecided << endl;
 	else
-		cout << "currently undecided for games with no pure equilibria\n";
+		cout << "Current Outcome: undecided for " << result.undecided << endl;
 	
 	// printing probabilities
-	for (int n = 0; (unsigned)n < kOutcomes.size(); n++)
+	for (int n = 0; (unsigned)n < result.outcomes.size(); n++)
 	{
 		cout << "P(";
 		for (int x = 0; x < numPlayers; x++)
 		{
-			cout << "s_" << kOutcomes.at(n).at(x) + 1;
+			cout << "s_" << result.outcomes.at(n).at(x) + 1;
 			if (x < numPlayers - 1)
 				cout << ", ";
 		}
-		cout << ") = " << getOutcomeProbability(n) << endl;
-	}
-	
-	// computing expected utilities
-	for (int x = 0; x < numPlayers; x++)
-	{
-		EU.at(x) = 0.0;
-		for (int num = 0; (unsigned)num < kOutcomes.size(); num++) // runs through kOutcomes
-		{
-			if (numPlayers < 3)
-				curList = payoffMatrix.at(0).at(getKOutcome(num).at(0)).at(getKOutcome(num).at(1));
-			else				
-				curList = payoffMatrix.at(hash(getKOutcome(num))).at(getKOutcome(num).at(0)).at(getKOutcome(num).at(1));
-			
-			EU.at(x) += curList->getNodeValue(x) * getOutcomeProbability(num);
-		}
+		cout << ") = " << result.outcomeProbabilities.at(n) << endl;
 	}
 	cout << endl;
 	
 	for (int x = 0; x < numPlayers; x++)
-		cout << "EU_" << x + 1 << " = " << EU.at(x) << endl;
+		cout << "EU_" << x + 1 << " = " << result.expectedUtilities.at(x) << endl;
 	
 	cout << "Save k-rationalizability model as LaTeX? Enter y or n:  ";
 	cin >> save;
 	validateChar(save);
 	if (save == 'y')
-		saveKMatrixAsLatex(choices, EU);
+		saveKMatrixAsLatex(result.choices, result.expectedUtilities);
 }
 
 template <typename T>
@@ -3491,7 +3602,7 @@ template <typename T>
 void simGame<T>::printKProbabilities()
 {
 	cout << endl;
-	for (int i = 0; i < 4; i++)
+	for (int i = 0; (unsigned)i < rationalityProbabilities.size(); i++)
 		cout << "L_" << i << ": " << getRationalityProbability(i) << endl;
 	cout << endl;
 }
@@ -3504,16 +3615,87 @@ void simGame<T>::printKStrategies()
 	for (int x = 0; x < numPlayers; x++)
 		cout << x << " ";
 	cout << "\n----------\n";
-	for (int r = 0; r < 4; r++)
+	for (int r = 0; r < kLevels.getNumLevels(); r++)
 	{
 		cout <<"r " << r << "|";
-		for (unsigned int x = 0; x < kStrategies.at(r).size(); x++)
-			cout << kStrategies.at(r).at(x) << " ";
+		for (unsigned int x = 0; x < kLevels.level(r).size(); x++)
+			cout << kLevels.level(r).at(x) << " ";
 		cout << endl;
 	}
 	cout << endl;
 }
 
+// print support enumeration's equilibria, or why there are none, and a warning if some may be missing
+template <typename T>
+template <typename S>
+void simGame<T>::printMixedEquilibria(const SupportEnumerationResult<S> &result)
+{
+	if (!result.status.ok)
+	{
+		cout << "ERROR: " << result.status.error << endl;
+		return;
+	}
+	printMixedEquilibria(result.equilibria);
+	if (result.degenerate)
+		cout << "The game is degenerate, so it may have equilibria whose supports differ in size, which aren't found.\n";
+}
+
+// print mixed equilibria as probability vectors
+template <typename T>
+template <typename S>
+void simGame<T>::printMixedEquilibria(vector<vector<vector<S> > > equilibria)
+{
+	if (equilibria.size() == 0)
+	{
+		cout << "No equilibria found by support enumeration.\n";
+		return;
+	}
+	
+	cout << "EQ_m = {";
+	for (int e = 0; (unsigned)e < equilibria.size(); e++)
+	{
+		cout << "(";
+		for (int x = 0; x < numPlayers; x++)
+		{
+			cout << "(";
+			for (int s = 0; (unsigned)s < equilibria.at(e).at(x).size(); s++)
+			{
+				cout << equilibria.at(e).at(x).at(s);
+				if ((unsigned)s < equilibria.at(e).at(x).size() - 1)
+					cout << ", ";
+			}
+			cout << ")";
+			if (x < numPlayers - 1)
+				cout << ", ";
+		}
+		cout << ")";
+		if ((unsigned)e < equilibria.size() - 1)
+			cout << ",\n        ";
+	}
+	cout << "}\n";
+}
+
+// prints an outcome as (s_i, s_j, ...) -> (payoffs)
+template <typename T>
+void simGame<T>::printOutcome(const OutcomeReport<T> &outcome)
+{
+	cout << "(";
+	for (int x = 0; (unsigned)x < outcome.profile.size(); x++)
+	{
+		cout << "s_" << outcome.profile.at(x) + 1;
+		if ((unsigned)x < outcome.profile.size() - 1)
+			cout << ", ";
+	}
+	cout << ") -> (";
+	for (int x = 0; (unsigned)x < outcome.payoffs.size(); x++)
+	{
+		cout << outcome.payoffs.at(x);
+		if ((unsigned)x < outcome.payoffs.size() - 1)
+			cout << ", ";
+	}
+	cout << ")";
+}
+
 // print payoff matrix
 template <typename T>
 void simGame<T>::printPayoffMatrix()
@@ -3531,103 +3713,7 @@ void simGame<T>::printPayoffMatrix()
 	if (!zs && !null && pureEquilibria.size() != 0) // no equilibria ==> can't compute a choice among equilibria
 		computeChoices(); // needs isMixed()
 	
-	vector<int> profile = vector<int>(numPlayers);
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		cout << endl;
-		if (numPlayers > 2)
-		{			
-			profile = unhash(m);
-			if (numPlayers == 3)
-				cout << "(c_3) = (";
-			else if (numPlayers == 4)
-				cout << "(c_3, c_4) = (";
-			else if (numPlayers == 5)
-				cout << "(c_3, c_4, c_5) = (";
-			else if (numPlayers == 6)
-				cout << "(c_3, c_4, c_5, c_6) = (";
-			else
-				cout << "(c_3, ..., c_" << numPlayers << ") = (";
-			for (int x = 2; x < numPlayers; x++)
-			{
-				cout << profile.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-		}
-		
-		/* if an entry is shorter than the max in the column, there will 
-		have to be extra space at the end to line up the next entry in the row */
-		vector<vector<vector<bool> > > extraSpaces = extraSpacesInColumns();
-		vector<vector<int> > payoffLengths = maxPayoffLengths();
-		
-		// cout << "LENGTHS: ";
-		// for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-		// {
-			// cout << payoffLengths.at(m).at(j);
-			// if (j < players.at(1)->getNumStrats() - 1)
-				// cout << ", ";
-		// }
-		// cout << endl;
-		
-		// cout << endl;
-		// cout << "    " << payoffLengths.at(m).at(0) << "+" << 6 * numPlayers + 2;
-		// for (int j = 1; j < players.at(1)->getNumStrats() - 1; j++)
-								 	// length 		     + (BR,comma,space,brackets,dash) * nP + parentheses,space at end
-			// cout << right << setw(payoffLengths.at(m).at(j) + 6 * numPlayers + 2)
-					// << payoffLengths.at(m).at(j) << "+" << 6 * numPlayers + 2;
-		// cout << endl;
-		
-		/*
-		(1 + 1 + 1 + 2 + 1) * numPlayers + 2 + 1
-		
-		BR 				*nP
-		comma			*nP
-		space			*nP + 1
-		brackets		*2nP
-		dash			*nP - 1
-		parentheses		*2
-		
-		nP + nP + nP + 1 + 2 * nP + nP - 1 + 2
-		6nP + 1 - 1 + 2
-		6nP + 2
-		6 * numPlayers + 2
-		*/
-		
-		// cout << endl;
-		cout << "    s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			// 					 	length 		     + (BR,comma,space,brackets,dash) * nP + parentheses,space at end
-			cout << setw(payoffLengths.at(m).at(j - 1) + 6 * numPlayers) << right << "s_" << j + 1;
-		cout << endl;
-		
-		// printing entries
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-		{
-			cout << "s_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-			{				
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayList(extraSpaces, m, j);
-				
-				// extra space between entries
-				if (j < players.at(1)->getNumStrats() - 1)
-				{
-					// total max length - this particular total length
-					if (payoffLengths.at(m).at(j) - entryPayoffLengths(m, i, j) != 0)
-					{
-						// cout << right << setw(maxLengths.at(m).at(j) - entryLength(extraSpaces, m, i, j));
-						for (int n = 0; n < payoffLengths.at(m).at(j) - entryPayoffLengths(m, i, j); n++)
-							cout << " ";
-					}
-					cout << " ";
-				}
-			}
-			cout << endl;
-		}
-		cout << endl;
-	}
+	printMatrices(PAYOFFS_AND_BRS);
 	
 	for (int x = 0; x < numPlayers; x++)
 		choices.at(x) = players.at(x)->getChoice();
@@ -3697,79 +3783,13 @@ void simGame<T>::printPayoffMatrix()
 template <typename T>
 void simGame<T>::printPayoffMatrixSansInfo()
 {	
-	LinkedList<T>* curList;
-	vector<int> choices = vector<int>(numPlayers);
-	
 	computePureEquilibria(); // calls computeBestResponses()
 	determineType();
 	isMixed(); // needs pureEquilibria() and determineType()
 	if (!zs && !null && pureEquilibria.size() != 0) // no equilibria ==> can't compute a choice among equilibria
 		computeChoices(); // needs isMixed()
 	
-	vector<int> profile = vector<int>(numPlayers);
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		cout << endl;
-		if (numPlayers > 2)
-		{			
-			profile = unhash(m);
-			if (numPlayers == 3)
-				cout << "(c_3) = (";
-			else if (numPlayers == 4)
-				cout << "(c_3, c_4) = (";
-			else if (numPlayers == 5)
-				cout << "(c_3, c_4, c_5) = (";
-			else if (numPlayers == 6)
-				cout << "(c_3, c_4, c_5, c_6) = (";
-			else
-				cout << "(c_3, ..., c_" << numPlayers << ") = (";
-			for (int x = 2; x < numPlayers; x++)
-			{
-				cout << profile.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-		}
-		
-		/* if an entry is shorter than the max in the column, there will 
-		have to be extra space at the end to line up the next entry in the row */
-		vector<vector<vector<bool> > > extraSpaces = extraSpacesInColumns();
-		vector<vector<int> > payoffLengths = maxPayoffLengths();
-		
-		cout << endl;
-		cout << "     s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			// length + (BR,comma,space,brackets,dash) * nP + parentheses,space at end, 1
-			cout << right << setw(payoffLengths.at(m).at(j) + (1 + 1 + 1 + 2 + 1) * numPlayers + 1) << "s_" << j + 1;
-		cout << endl;
-		
-		// printing entries
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-		{
-			cout << "s_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-			{				
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayList(extraSpaces, m, j);
-				
-				// extra space between entries
-				if (j < players.at(1)->getNumStrats() - 1)
-				{
-					// total max length - this particular total length
-					if (payoffLengths.at(m).at(j) - entryPayoffLengths(m, i, j) != 0)
-					{
-						// cout << right << setw(maxLengths.at(m).at(j) - entryLength(extraSpaces, m, i, j));
-						for (int n = 0; n < payoffLengths.at(m).at(j) - entryPayoffLengths(m, i, j); n++)
-							cout << " ";
-					}
-					cout << " ";
-				}
-			}
-			cout << endl;
-		}
-		cout << endl;
-	}
+	printMatrices(PAYOFFS_AND_BRS_SANS_INFO);
 }
 
 // print payoffs
@@ -3784,59 +3804,7 @@ void simGame<T>::printPayoffs()
 	determineType();
 	isMixed();
 		
-	vector<int> stratProfile = vector<int>(numPlayers);
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		cout << endl;
-		if (numPlayers > 2)
-		{			
-			stratProfile = unhash(m);
-			if (numPlayers == 3)
-				cout << "(c_3) = (";
-			else if (numPlayers == 4)
-				cout << "(c_3, c_4) = (";
-			else if (numPlayers == 5)
-				cout << "(c_3, c_4, c_5) = (";
-			else if (numPlayers == 6)
-				cout << "(c_3, c_4, c_5, c_6) = (";
-			else
-				cout << "(c_3, ..., c_" << numPlayers << ") = (";
-			for (int x = 2; x < numPlayers; x++)
-			{
-				cout << stratProfile.at(x) + 1;
-				if (x < numPlayers - 1)
-					cout << ", ";
-			}
-			cout << ")\n";
-		}
-		
-		vector<vector<int> > maxLengths = maxPayoffLengths();
-		
-		cout << "     s_1";
-		for (int j = 1; j < players.at(1)->getNumStrats(); j++)
-			cout << setw(maxLengths.at(m).at(j - 1) + 2 * numPlayers) << "s_" << j + 1; // length + comma + spaces + parentheses
-		cout << endl;
-		
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++) // i-th row
-		{
-			cout << "s_" << i + 1 << " ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++) // j-th column
-			{
-				curList = payoffMatrix.at(m).at(i).at(j);
-				curList->displayPayoffs();
-				if (j != players.at(1)->getNumStrats() - 1)
-					cout << " ";
-				
-				if (maxLengths.at(m).at(j) - entryPayoffLengths(m, i, j) != 0)
-				{
-					for (int n = 0; n < maxLengths.at(m).at(j) - entryPayoffLengths(m, i, j); n++)
-						cout << " ";
-				}
-			}
-			cout << endl;
-		}
-		cout << endl;
-	}
+	printMatrices(PAYOFFS_ONLY);
 	
 	for (int x = 0; x < numPlayers; x++)
 		choices.at(x) = players.at(x)->getChoice();
@@ -3882,25 +3850,7 @@ void simGame<T>::printPayoffs()
 	else
 		cout << "no\n";
 	
-	cout << "Type: ";
-	if (zs)
-		cout << "ZS\n";
-	else if (ih)
-		cout << "IH\n";
-	else if (pd)
-		cout << "PD\n";
-	else if (pc)
-		cout << "PC\n";
-	else if (bos)
-		cout << "BOS\n";
-	else if (chicken)
-		cout << "Chicken\n";
-	else if (sh)
-		cout << "SH\n";
-	else if (null)
-		cout << "NULL\n";
-	else
-		cout << "Undetermined\n";
+	cout << "Type: " << typeName() << endl;
 }
 
 // print a single player's info
@@ -3986,126 +3936,58 @@ void simGame<T>::printPureEquilibria()
 template <typename T>
 void simGame<T>::randGame()
 {
-	bool addMoreOutcomesPast2 = false; // kMatrix
-	int nP = -1, nS = -1, oldNumPlayers = -1, oldNumStrats[numPlayers], oldSize = -1;
-	LinkedList<T>* curList;
-	srand(time(NULL));
-	
-	oldNumPlayers = numPlayers;
-	
-	for (int x = 0; x < numPlayers; x++)
-		oldNumStrats[x] = players.at(x)->getNumStrats();
-	
-	oldSize = payoffMatrix.size();
+	int nP = -1, nS = -1;
+	RandGameOptions options;
 	
 	cout << "Enter the number of players from 2 to 4:  ";
 	cin >> nP;
 	validateNumPlayers(nP);
-	numPlayers = nP;
-	
-	// add new players if there are more and increase the size of kStrategy vectors
-	if (oldNumPlayers != numPlayers)
-	{
-		if (oldNumPlayers < numPlayers)
-			addMoreOutcomesPast2 = true;
-		
-		for (int i = oldNumPlayers; i < numPlayers; i++)
-		{
-			Player* p = new Player(numPlayers, i);
-			players.push_back(p);
-		}
-	}
 	
-	for (int x = 0; x < numPlayers; x++)
+	for (int x = 0; x < nP; x++)
 	{
 		if (x < 2)
 		{
 			cout << "Enter the number of strategies from 2 to 5 for P_" << x + 1  << ":  ";
 			cin >> nS;
 			validateNumStrats(nS, 5);
-			players.at(x)->setNumStrats(nS);
 		}
 		else
 		{	
 			cout << "Enter the number of strategies from 2 to 3 for P_" << x + 1  << ":  ";
 			cin >> nS;
 			validateNumStrats(nS, 3);
-			players.at(x)->setNumStrats(nS);
-		}		
-		players.at(x)->setRationality(rand() % 4);
+		}
+		options.numStrats.push_back(nS);
 	}
 	cout << endl;
 	
-	// resizing payoffMatrix and kMatrix
-	if (oldNumPlayers != numPlayers)
-	{		
-		for (int r = 0; r < 4; r++)
-			kStrategies.at(r).resize(numPlayers);
-		
-		// new matrices need to be inserted in the correct positions, not added at the end
-		int size = 1;
-		if (numPlayers > 2)
-		{
-			for (int x = 2; x < numPlayers; x++)
-				size *= players.at(x)->getNumStrats();
-		}
-		payoffMatrix.resize(size);
-		
-		size = 1;
-		if (numPlayers > 2)
-			size = pow(4, numPlayers - 2);
-		
-		kMatrix.resize(size);
-	}
+	randomize(options);
+	printPayoffMatrix();
+}
+
+/// @brief replaces the game with a random one; the same options and seed always give the same game
+/// @param options each player's number of strategies, the payoffs' distribution, and the seed
+/// @return 
+template <typename T>
+GameStatus simGame<T>::randomize(const RandGameOptions &options)
+{
+	RandGameOptions drawn = options;
+	drawn.seed = randomSeed(options); // the payoffs and rationalities come from the same seed
 	
-	// creating/deleting entries and entering random values
-	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-	{
-		payoffMatrix.at(m).resize(players.at(0)->getNumStrats());
-		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-		{
-			payoffMatrix.at(m).at(i).resize(players.at(1)->getNumStrats());
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-			{						
-				// create new list if needed
-				if (!payoffMatrix.at(m).at(i).at(j))
-				{
-					LinkedList<T>* newList = new LinkedList<T>;
-					payoffMatrix.at(m).at(i).at(j) = newList;
-				}
-				curList = payoffMatrix.at(m).at(i).at(j);
-				while (curList->getSize() > numPlayers)
-					curList->deleteNode(curList->getSize() - 1); // DELETING
-				
-				for (int x = 0; x < numPlayers; x++)
-				{
-					if (m < oldSize && x < oldNumPlayers && i < oldNumStrats[0] && j < oldNumStrats[1]) // old matrix, old payoff, old outcome
-						curList->setNodeValue(x, rand() % 100);
-					else // everything else is new
-						curList->appendNode(rand() % 100, false); // ADDING
-				}
-			}
-		}
-	}
+	PayoffTensor<T> payoffs;
+	GameStatus status = randomPayoffs(payoffs, drawn);
+	if (!status.ok)
+		return status;
+	loadPayoffs(payoffs);
 	
-	// resizing kMatrix
-	if (addMoreOutcomesPast2)
+	if (options.randomRationalities)
 	{
-		for (int m = 0; (unsigned)m < kMatrix.size(); m++)
-		{
-			kMatrix.at(m).resize(4);
-			for(int i = 0; i < 4; i++)
-			{
-				kMatrix.at(m).at(i).resize(4);
-				for(int j = 0; j < 4; j++)
-				{
-					vector<int> vect(numPlayers, -1);
-					kMatrix.at(m).at(i).at(j) = vect;
-				}
-			}
-		}
+		// drawn with the index after the last outcome's
+		RandomStream draws(drawn.seed, drawn.stream, payoffs.getNumOutcomes());
+		for (int x = 0; x < numPlayers; x++)
+			players.at(x)->setRationality(draws.uniformInteger(0, options.maxRationality));
 	}
-	printPayoffMatrix();
+	return GameStatus();
 }
 
 // chooses a random game type
@@ -4113,10 +3995,10 @@ template <typename T>
 void simGame<T>::randType()
 {
 	bool changeNumStratsP1 = false, changeNumStratsP2 = false, changeNumStratsPastP2 = false;
-	bool addMoreOutcomesPast2 = false; // kMatrix
 	int nP = -1, nS = -1, oldNumPlayers = -1, oldNumStrats[numPlayers], type = -1;
 	LinkedList<T>* curList;
 	srand(time(NULL));
+	invalidatePayoffLengths();
 	
 	oldNumPlayers = numPlayers;
 	
@@ -4130,9 +4012,6 @@ void simGame<T>::randType()
 	{
 		changeNumStratsPastP2 = true;
 		
-		if (oldNumPlayers < numPlayers)
-			addMoreOutcomesPast2 = true;
-		
 		for (int i = oldNumPlayers; i < numPlayers; i++)
 		{
 			Player* p = new Player(numPlayers, i);
@@ -4153,12 +4032,9 @@ void simGame<T>::randType()
 	if (oldNumStrats[1] != players.at(1)->getNumStrats())
 		changeNumStratsP2 = true;
 	
-	// resizing payoffMatrix and kMatrix
+	// resizing payoffMatrix
 	if (oldNumPlayers != numPlayers)
 	{		
-		for (int r = 0; r < 4; r++)
-			kStrategies.at(r).resize(numPlayers);
-		
 		// new matrices need to be inserted in the correct positions, not added at the end
 		int size = 1;
 		if (numPlayers > 2)
@@ -4167,12 +4043,6 @@ void simGame<T>::randType()
 				size *= players.at(x)->getNumStrats();
 		}
 		payoffMatrix.resize(size);
-		
-		size = 1;
-		if (numPlayers > 2)
-			size = pow(4, numPlayers - 2);
-		
-		kMatrix.resize(size);
 	}
 	
 	// resizing 2D matrices in payoffMatrix
@@ -4251,24 +4121,6 @@ void simGame<T>::randType()
 		}
 	}
 	
-	// resizing kMatrix
-	if (addMoreOutcomesPast2)
-	{
-		for (int m = 0; (unsigned)m < kMatrix.size(); m++)
-		{
-			kMatrix.at(m).resize(4);
-			for(int i = 0; i < 4; i++)
-			{
-				kMatrix.at(m).at(i).resize(4);
-				for(int j = 0; j < 4; j++)
-				{
-					vector<int> vect(numPlayers, -1);
-					kMatrix.at(m).at(i).at(j) = vect;
-				}
-			}
-		}
-	}
-	
 	type = rand() % 7 + 1;
 	
 	if (type == 1) // zs
@@ -4356,300 +4208,166 @@ void simGame<T>::randType()
 template <typename T>
 void simGame<T>::readFromFile()
 {
-	bool addMoreOutcomesPast2 = false; // kMatrix
-	ifstream infile;
-	int nP = -1, nS = -1, r = -1;
-	int oldNumPlayers = -1, oldNumStrats[numPlayers], oldSize = -1;
-	LinkedList<T>* curList;
 	string filename;
 	
 	cout << "Enter the name of the file:  ";
 	cin >> filename;
 	
-	infile.open(filename.c_str());
-	if (!infile)
-		cout << "\nERROR: could not open file\n";
+	GameStatus status = loadFromFile(filename);
+	if (!status.ok)
+		cout << "\nERROR: " << status.error << endl;
 	else
-	{
-		while (!infile.eof())
-		{
-			oldNumPlayers = numPlayers;
-			
-			for (int x = 0; x < numPlayers; x++)
-				oldNumStrats[x] = players.at(x)->getNumStrats();
-			
-			oldSize = payoffMatrix.size();
-			
-			// reading numPlayers
-			infile >> nP;
-			setNumPlayers(nP);
-			
-			// reading numStrats for old players
-			if (oldNumPlayers <= numPlayers)
-			{
-				for (int x = 0; x < oldNumPlayers; x++)
-				{
-					infile >> nS;
-					players.at(x)->setNumStrats(nS);
-				}
-			}
-			else
-			{
-				for (int x = 0; x < numPlayers; x++)
-				{
-					infile >> nS;
-					players.at(x)->setNumStrats(nS);
-				}
-			}
-			
-			/**************************************
-			add new players if there are more
-			resizing payoffMatrix and kMatrix
-			increase the size of kStrategy vectors 
-			***************************************/
-			if (oldNumPlayers != numPlayers)
-			{
-				if (oldNumPlayers < numPlayers)
-					addMoreOutcomesPast2 = true;
-				
-				// create new players and read rest of numStrats
-				for (int x = oldNumPlayers; x < numPlayers; x++)
-				{
-					Player* p = new Player(numPlayers, x);
-					players.push_back(p);
-					
-					infile >> nS;
-					players.at(x)->setNumStrats(nS);
-				}
-				
-				for (int rat = 0; rat < 4; rat++)
-					kStrategies.at(rat).resize(numPlayers);
-			}
-			// new matrices added at the end
-			int size = 1;
-			if (numPlayers > 2)
-			{
-				for (int x = 2; x < numPlayers; x++)
-					size *= players.at(x)->getNumStrats();
-			}
-			payoffMatrix.resize(size);
-			
-			size = 1;
-			if (numPlayers > 2)
-				size = pow(4, numPlayers - 2);
-			kMatrix.resize(size);	
-		
-			for (int x = 0; x < numPlayers; x++)
-			{
-				infile >> r;
-				players.at(x)->setRationality(r);
-			}
-			kOutcomes.clear();
-			outcomeProbabilities.clear();
-			
-			// creating/deleting entries and reading values	
-			int val;
-			for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-			{
-				payoffMatrix.at(m).resize(players.at(0)->getNumStrats());
-				for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-				{
-					payoffMatrix.at(m).at(i).resize(players.at(1)->getNumStrats());
-					for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-					{
-						// create new list if needed
-						if (!payoffMatrix.at(m).at(i).at(j))
-						{
-							LinkedList<T>* newList = new LinkedList<T>;
-							payoffMatrix.at(m).at(i).at(j) = newList;
-						}
-						curList = payoffMatrix.at(m).at(i).at(j);
-						while (curList->getSize() > numPlayers)
-							curList->deleteNode(curList->getSize() - 1); // DELETING
-						
-						// infile.ignore(1,'(');
-						// infile >> val;
-						// cout << "first: " << val << endl;
-						// curList->setNodeValue(0, val);
-						for (int x = 0; x < numPlayers; x++)
-						{
-							// cout << "x: "<< x << endl;
-							// infile.ignore(256, ',');
-							infile >> val;
-							// cout << "\tval: "<< val << endl;
-							if (m < oldSize && x < oldNumPlayers 
-								&& i < oldNumStrats[0] && j < oldNumStrats[1]) // old matrix, old payoff, old outcome
-								curList->setNodeValue(x, val);
-							else // everything else is new
-								curList->appendNode(val, false); // ADDING
-						}
-						// infile.ignore(5,'(');
-					}
-				}
-			}
-
-			// resizing kMatrix
-			if (addMoreOutcomesPast2)
-			{
-				for (int m = 0; (unsigned)m < kMatrix.size(); m++)
-				{
-					kMatrix.at(m).resize(4);
-					for(int i = 0; i < 4; i++)
-					{
-						kMatrix.at(m).at(i).resize(4);
-						for(int j = 0; j < 4; j++)
-						{
-							vector<int> vect(numPlayers, -1);
-							kMatrix.at(m).at(i).at(j) = vect;
-						}
-					}
-				}
-			}
-		}
 		cout << "Done reading from " << filename << endl;
-		infile.close();
-	}
 	
 	printPayoffMatrix();
 }
 
+// reads one preference polynomial per player, in x_1, ..., x_numPlayers
+template <typename T>
+bool simGame<T>::readPreferences(string filename)
+{
+	vector<Polynomial*> preferences;
+	if (!Polynomial::readPolynomials(filename, preferences, numPlayers))
+	{
+		for (int x = 0; (unsigned)x < preferences.size(); x++)
+			delete preferences.at(x);
+		return false;
+	}
+	if (preferences.size() != (unsigned)numPlayers)
+	{
+		cout << "ERROR: " << filename << " has " << preferences.size() << " preferences for " << numPlayers << " players\n";
+		for (int x = 0; (unsigned)x < preferences.size(); x++)
+			delete preferences.at(x);
+		return false;
+	}
+	
+	for (int x = 0; x < numPlayers; x++)
+	{
+		delete players.at(x)->getPreference();
+		players.at(x)->setPreference(preferences.at(x));
+	}
+	return true;
+}
+
 // removes strictly dominated strategies that will never be played (?)
 template <typename T>
 void simGame<T>::reduce()
+{
+	if (removeDominatedStrategies() == 0)
+		cout << "\nERROR: no strictly dominated strategies\n";
+	printPayoffMatrix();
+}
+
+// removes strictly dominated strategies, leaving each player at least 2, and returns how many were removed
+template <typename T>
+int simGame<T>::removeDominatedStrategies()
 {
 	int numRemoved = 0;
 	for (int x = numPlayers - 1; x > -1; x--)
 	{
 		for (int s = 0; s < players.at(x)->getNumStrats(); s++)
 		{
-			if (players.at(x)->getNumStrats() > 2) // && isStrictlyDominated(x, s))
+			if (players.at(x)->getNumStrats() > 2 && isStrictlyDominated(x, s))
 			{
-				if (isStrictlyDominated(x, s))
-				{
-					removeStrategy(x, s);
-					numRemoved++;
-				}
+				removeStrategy(x, s);
+				numRemoved++;
+				s--; // the next strategy has moved into position s
 			}
 		}
 	}
-	if (numRemoved == 0)
-		cout << "\nERROR: no strictly dominated strategies\n";
-	printPayoffMatrix();
+	return numRemoved;
 }
 
-// remove strategy s from player P_x
+/***************************************************************************
+rebuilds payoffMatrix after P_x's strategies change: P_x's new strategy s was
+oldStrats.at(s) before, or is new if that is -1, in which case its payoffs
+are 0; lists for strategies that are not kept are deleted
+***************************************************************************/
 template <typename T>
-void simGame<T>::removeStrategy(int x, int s)
+void simGame<T>::remapStrategies(int x, int newNumStrats, const vector<int> &oldStrats)
 {
-	if (x == 0)
-	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-			payoffMatrix.at(m).erase(payoffMatrix.at(m).begin() + s);
-	}
-	else if (x == 1)
-	{
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			for(int i = 0; i < players.at(0)->getNumStrats(); i++)
-				payoffMatrix.at(m).at(i).erase(payoffMatrix.at(m).at(i).begin() + s);
-		}
-	}
-	else // x > 1
+	vector<int> oldNumStrats = vector<int>(numPlayers), newNumStratsAll;
+	invalidatePayoffLengths();
+	for (int y = 0; y < numPlayers; y++)
+		oldNumStrats.at(y) = players.at(y)->getNumStrats();
+	newNumStratsAll = oldNumStrats;
+	newNumStratsAll.at(x) = newNumStrats;
+	
+	int size = 1;
+	for (int y = 2; y < numPlayers; y++)
+		size *= newNumStratsAll.at(y);
+	
+	vector<vector<vector<LinkedList<T>*> > > newMatrix = vector<vector<vector<LinkedList<T>*> > >(size);
+	vector<int> profile, oldProfile;
+	for (int m = 0; m < size; m++)
 	{
-		int numErased = 0;
-		int product = 1;
-		int m = 0;
-		vector<int> end = vector<int>(numPlayers);
-		for (int y = 0; y < numPlayers; y++)
-		{
-			if (y != x)
-				end.at(y) = players.at(y)->getNumStrats();
-			else
-				end.at(y) = s;
-		}
-		
-		vector<int> profile = vector<int>(numPlayers);
-		while (m < hash(end))
+		profile = matrixProfile(m, newNumStratsAll);
+		newMatrix.at(m).resize(newNumStratsAll.at(0));
+		for (int i = 0; i < newNumStratsAll.at(0); i++)
 		{
-			profile = unhash(m);
-			profile.at(x) = s; // at start of section
-			int num = 1;
-			if (x < numPlayers - 1)
+			newMatrix.at(m).at(i).resize(newNumStratsAll.at(1));
+			for (int j = 0; j < newNumStratsAll.at(1); j++)
 			{
-				for (int y = 2; y < numPlayers; y++)
+				profile.at(0) = i;
+				profile.at(1) = j;
+				oldProfile = profile;
+				oldProfile.at(x) = oldStrats.at(profile.at(x));
+				
+				if (oldProfile.at(x) == -1)
 				{
-					if (y != x)
-						num *= players.at(y)->getNumStrats();
+					LinkedList<T>* newList = new LinkedList<T>;
+					for (int y = 0; y < numPlayers; y++)
+						newList->appendNode(0, false);
+					newMatrix.at(m).at(i).at(j) = newList;
 				}
-			}
-			else if (x == numPlayers - 1 && numPlayers > 3)
-				num = players.at(x)->getNumStrats();
-			while (numErased < num)
-			{
-				payoffMatrix.erase(payoffMatrix.begin() + hash(profile));
-				numErased++;
-				
-				// last player's matrices are all lined up; others' must be found
-				if (x < numPlayers - 1)
+				else // moved, so it isn't deleted below
 				{
-					cout << endl;
-					if (profile.at(2) > 0) // simply decrement first number
-						profile.at(2)--;
-					else // go through each succeeding number
-					{
-						int y = 2;
-						bool foundNonzero = false;
-						do 
-						{							
-							profile.at(y) = players.at(y)->getNumStrats() - 1;
-							// not last number and next number is nonzero
-							if (y != numPlayers - 1 && profile.at(y + 1) != 0)
-							{
-								profile.at(y + 1)--;
-								foundNonzero = true;
-							}
-							// not last number and next number is 0
-							else if (y != numPlayers - 1 && profile.at(y + 1) == 0)
-								profile.at(y) = players.at(y)->getNumStrats() - 1;
-							else if (y == numPlayers - 1) // at last number
-								profile.at(y)--;
-							y++; // move to next number
-							
-							/* stop when arrive at a number > 0 
-							or when we get to the last number */
-						} while (y < numPlayers && profile.at(y) == 0 && !foundNonzero);
-					}
-					
-					bool incremented = false;
-					int y = 2;
-					while (!incremented && y < numPlayers)
-					{
-						if (y != x)
-						{
-							if (profile.at(y) != players.at(y)->getNumStrats() - 1)
-							{
-								profile.at(y)++;
-								incremented = true;
-							}
-						}
-						y++;
-					}
+					LinkedList<T>* &oldList = payoffMatrix.at(matrixIndex(oldProfile, oldNumStrats)).at(oldProfile.at(0)).at(oldProfile.at(1));
+					newMatrix.at(m).at(i).at(j) = oldList;
+					oldList = NULL;
 				}
 			}
-			if (x > 2 && x < numPlayers - 1 && product == 1)
-			{
-				for (int y = 2; y <= x - 1; y++)
-					product *= players.at(y)->getNumStrats();
-			}
-			m += product; // move to the next one, which is the first in the next section
 		}
 	}
-	players.at(x)->setNumStrats(players.at(x)->getNumStrats() - 1);
+	
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+		for (int i = 0; (unsigned)i < payoffMatrix.at(m).size(); i++)
+			for (int j = 0; (unsigned)j < payoffMatrix.at(m).at(i).size(); j++)
+				delete payoffMatrix.at(m).at(i).at(j);
+	
+	payoffMatrix.swap(newMatrix);
+	players.at(x)->setNumStrats(newNumStrats);
+	computeNumOutcomes();
+	clearPureEquilibria();
+	clearParetoPureEquilibria();
+	mixedEquilibria.clear();
 	
 	if (impartial)
 		impartial = false;
 }
 
+// remove strategy s from player P_x
+template <typename T>
+GameStatus simGame<T>::removeStrategy(int x, int s)
+{
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("there is no P_" + to_string(x + 1));
+	if (s < 0 || s >= players.at(x)->getNumStrats())
+		return GameStatus("P_" + to_string(x + 1) + " has no strategy s_" + to_string(s + 1));
+	if (players.at(x)->getNumStrats() == 1)
+		return GameStatus("P_" + to_string(x + 1) + " has only one strategy");
+	
+	vector<int> oldStrats;
+	for (int t = 0; t < players.at(x)->getNumStrats(); t++)
+	{
+		if (t != s)
+			oldStrats.push_back(t);
+	}
+	
+	remapStrategies(x, oldStrats.size(), oldStrats);
+	return GameStatus();
+}
+
 // prevents removal of a strategy
 template <typename T>
 void simGame<T>::removeStrategyPrompt(int x)
@@ -4664,35 +4382,58 @@ void simGame<T>::removeStrategyPrompt(int x)
 		int s;
 		cout << "Which of P_" << x + 1 << "'s strategies would you like to remove?  ";
 		cin >> s;
-		s--;
+		validate(s, 1, players.at(x)->getNumStrats());
 		
-		if (x == 0)
-		{
-			for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-				payoffMatrix.at(m).erase(payoffMatrix.at(m).begin() + s);
-		}
-		else if (x == 1)
-		{
-			for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-				for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-					payoffMatrix.at(m).at(i).erase(payoffMatrix.at(m).at(i).begin() + s);
-		}
-		else // x >= 2
+		removeStrategy(x, s - 1);
+		printPayoffMatrix();
+	}
+}
+
+/**********************************************************************
+matches payoffMatrix to the players' numbers of strategies: lists that 
+no longer fit are deleted, new lists are created, and each list is 
+given numPlayers payoffs; new payoffs are 0
+**********************************************************************/
+template <typename T>
+void simGame<T>::resizePayoffMatrix()
+{
+	LinkedList<T>* curList;
+	int size = 1;
+	invalidatePayoffLengths();
+	for (int x = 2; x < numPlayers; x++)
+		size *= players.at(x)->getNumStrats();
+	
+	for (int m = size; (unsigned)m < payoffMatrix.size(); m++)
+		for (int i = 0; (unsigned)i < payoffMatrix.at(m).size(); i++)
+			for (int j = 0; (unsigned)j < payoffMatrix.at(m).at(i).size(); j++)
+				delete payoffMatrix.at(m).at(i).at(j);
+	payoffMatrix.resize(size);
+	
+	for (int m = 0; m < size; m++)
+	{
+		for (int i = players.at(0)->getNumStrats(); (unsigned)i < payoffMatrix.at(m).size(); i++)
+			for (int j = 0; (unsigned)j < payoffMatrix.at(m).at(i).size(); j++)
+				delete payoffMatrix.at(m).at(i).at(j);
+		payoffMatrix.at(m).resize(players.at(0)->getNumStrats());
+		
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
 		{
-			vector<int> profile = vector<int>(numPlayers);
-			for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+			for (int j = players.at(1)->getNumStrats(); (unsigned)j < payoffMatrix.at(m).at(i).size(); j++)
+				delete payoffMatrix.at(m).at(i).at(j);
+			payoffMatrix.at(m).at(i).resize(players.at(1)->getNumStrats(), NULL);
+			
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
 			{
-				profile = unhash(m);
-				if (profile.at(x) == s)
-					payoffMatrix.erase(payoffMatrix.begin() + s);
+				if (!payoffMatrix.at(m).at(i).at(j))
+					payoffMatrix.at(m).at(i).at(j) = new LinkedList<T>;
+				
+				curList = payoffMatrix.at(m).at(i).at(j);
+				while (curList->getSize() > numPlayers)
+					curList->deleteNode(curList->getSize() - 1);
+				while (curList->getSize() < numPlayers)
+					curList->appendNode(0, false);
 			}
 		}
-		players.at(x)->setNumStrats(players.at(x)->getNumStrats() - 1);
-		
-		if (impartial)
-			impartial = false;
-		
-		printPayoffMatrix();
 	}
 }
 
@@ -4711,31 +4452,25 @@ int simGame<T>::rHash(vector<int> rationalityProfile)
 	return num;
 }
 
-// converts an index in a stack of payoff arrays into the sequence of strategies that produce that index
+// save every player's expected utilities, one polynomial per strategy
 template <typename T>
-vector<int> simGame<T>::rUnhash(int matrixIndex)
+bool simGame<T>::saveExpectedUtilities(string filename)
 {
-	int rationality = 0, previousValues = 0, product = 1;
-	vector<int> rationalityProfile = vector<int>(numPlayers);
-	rationalityProfile.at(0) = -1;
-	rationalityProfile.at(1) = -1;
+	vector<vector<Polynomial*> > EU = computeExpectedUtilities();
+	vector<Polynomial*> polys;
+	vector<string> labels;
 	
-	product = pow(4, numPlayers - 3);
-	
-	for (int x = numPlayers - 1; x > 1; x--)
-	{
-		rationality = 0;
-		while (product * rationality + previousValues < matrixIndex && rationality != 4)
-			rationality++;
-		
-		if (product * rationality + previousValues > matrixIndex)
-			rationality--;
-		
-		previousValues += product * rationality;
-		rationalityProfile.at(x) = rationality;
-		product = product / 4;
-	}	
-	return rationalityProfile;
+	for (int x = 0; x < numPlayers; x++)
+		for (int n = 0; (unsigned)n < EU.at(x).size(); n++)
+		{
+			polys.push_back(EU.at(x).at(n));
+			labels.push_back("EU_" + to_string(x + 1) + "(s_" + to_string(n + 1) + ")");
+		}
+	
+	bool saved = Polynomial::writePolynomials(filename, polys, labels);
+	for (int n = 0; (unsigned)n < polys.size(); n++)
+		delete polys.at(n);
+	return saved;
 }
 
 // save k-matrix to be displayed in LaTeX
@@ -4746,7 +4481,8 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 	LinkedList<T>* curList;
 	ofstream outfile;
 	string filename;
-	vector<int> curEntry, rationalityProfile; // for labelling each matrix
+	int numLevels = rationalityProbabilities.size();
+	vector<int> rationalityProfile = vector<int>(numPlayers, 0); // for labelling each matrix
 	
 	cout << "Enter the name of the file (Example: file.txt):  ";
 	cin >> filename;
@@ -4756,12 +4492,10 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 		cout << "There was an error opening the file.\n";
 	else
 	{
-		for (int m = 0; (unsigned)m < kMatrix.size(); m++)
+		do
 		{		
 			if (numPlayers > 2)
-			{			
-				rationalityProfile = rUnhash(m);
-				
+			{
 				outfile << "$";
 				if (numPlayers == 3)
 					outfile << "(l_3) = (";
@@ -4775,7 +4509,7 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 					outfile << "(l_3, \\dots, l_" << numPlayers << ") = (";
 				for (int x = 2; x < numPlayers; x++)
 				{
-					outfile << rationalityProfile.at(x) + 1;
+					outfile << rationalityProfile.at(x);
 					if (x < numPlayers - 1)
 						outfile << ", ";
 				}
@@ -4786,36 +4520,37 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 			outfile << "\\kbordermatrix\n";
 			outfile << "\t{\n";
 			outfile << "\t\t & ";
-			for (int r2 = 0; r2 < 4; r2++)
+			for (int r2 = 0; r2 < numLevels; r2++)
 			{
 				outfile << "L_" << r2;
-				if (r2 < 3)
+				if (r2 < numLevels - 1)
 					outfile << " & ";
 			}
 			outfile << " \\\\\n";
 			
-			for (int r1 = 0; r1 < 4; r1++) // L_r1 row
+			for (int r1 = 0; r1 < numLevels; r1++) // L_r1 row
 			{
+				rationalityProfile.at(0) = r1;
 				outfile << "\t\tL_" << r1 << " & ";
-				for (int r2 = 0; r2 < 4; r2++) // L_r2 column
+				for (int r2 = 0; r2 < numLevels; r2++) // L_r2 column
 				{
-					curEntry = kMatrix.at(m).at(r1).at(r2);
+					rationalityProfile.at(1) = r2;
 					outfile << "(";
 					for (int x = 0; x < numPlayers; x++) // gets the whole n-tuple entry
 					{
-						outfile << "s_" << curEntry.at(x) + 1; // getKStrategy(r1).at(x) + 1 || getKStrategy(r2).at(x) + 1???
+						outfile << "s_" << kLevels.strategy(rationalityProfile.at(x), x) + 1;
 						if (x < numPlayers - 1)
 							outfile << ", ";
 					}
 					outfile << ")";
-					if (r2 < 3)
+					if (r2 < numLevels - 1)
 						outfile << " & ";
 				}
 				outfile << " \\\\\n";
 			}
 			outfile << "\t}\n";
 			outfile << "\\]\n";
-		}
+		} while (nextLevelProfile(rationalityProfile, numLevels));
 		
 		outfile << "Current Outcome:  $(";
 		for (int x = 0; x < numPlayers; x++)
@@ -4858,7 +4593,7 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 		
 		// printing probabilities
 		outfile << "$";
-		for (int r = 0; r < 3; r++)
+		for (int r = 0; r < numLevels; r++)
 			outfile << "P(L_" << r << "): " << rationalityProbabilities.at(r) << " \\\\\n";
 		for (int n = 0; (unsigned)n < kOutcomes.size(); n++)
 		{
@@ -4887,169 +4622,46 @@ void simGame<T>::saveKMatrixAsLatex(vector<int> choices, vector<double> EU)
 template <typename T>
 void simGame<T>::savePayoffMatrixAsLatex()
 {
-	LinkedList<T>* curList;
-	ofstream outfile;
 	string filename;
-	vector<int> profile;
 	
 	cout << "Enter the name of the file (Example: file.txt):  ";
 	cin >> filename;
 	
-	outfile.open(filename.c_str());
-	if (!outfile)
+	GameStatus status = writeLatexFile(filename);
+	if (!status.ok)
 		cout << "There was an error opening the file.\n";
 	else
-	{
-		int val = -std::numeric_limits<T>::max();
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			if (numPlayers > 2)
-			{
-				if (m == 0)
-					outfile << "\\noindent\n";
-				profile = unhash(m);
-				outfile << "$";
-				if (numPlayers == 3)
-					outfile << "(c_3) = (";
-				else if (numPlayers == 4)
-					outfile << "(c_3, c_4) = (";
-				else if (numPlayers == 5)
-					outfile << "(c_3, c_4, c_5) = (";
-				else if (numPlayers == 6)
-					outfile << "(c_3, c_4, c_5, c_6) = (";
-				else
-					outfile << "(c_3, \\dots, c_" << numPlayers << ") = (";
-				for (int x = 2; x < numPlayers; x++)
-				{
-					outfile << profile.at(x) + 1;
-					if (x < numPlayers - 1)
-						outfile << ", ";
-				}
-				outfile << ")$\n";
-			}
-			
-			outfile << "\\[\n";
-			outfile << "\t\\kbordermatrix\n";
-			outfile << "\t{\n";
-			outfile << "\t\t";
-			// if (numPlayers > 2)
-			// {
-				// profile = unhash(m);
-				// outfile << "(";
-				// for (int x = 2; x < numPlayers; x++)
-				// {
-					// outfile << profile.at(x) + 1;
-					// if (x < numPlayers - 1)
-						// outfile << ", ";
-				// }
-				// outfile << ") ";
-			// }
-			outfile << "& ";
-			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-			{
-				outfile << "s_" << j + 1;
-				if (j < players.at(1)->getNumStrats() - 1)
-					outfile << " & ";
-			}
-			outfile << " \\\\\n";
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-			{
-				outfile << "\t\ts_" << i + 1 << " & ";
-				for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-				{
-					curList = payoffMatrix.at(m).at(i).at(j);
-					outfile << "(";
-					for (int x = 0; x < numPlayers; x++)
-					{
-						val = curList->getNodeValue(x);
-						if (curList->getNodeBestResponse(x))
-						{
-							outfile << "\\mathbf{";
-							outfile << val;
-							outfile << "}";
-						}
-						else
-							outfile << val;
-						if (x < numPlayers - 1)
-							outfile << ", ";
-					}
-					outfile << ") ";
-					if (j < players.at(1)->getNumStrats() - 1)
-						outfile << "& ";
-				}
-				if (i < players.at(0)->getNumStrats() - 1)
-					outfile << "\\\\";
-				outfile << endl;
-			}
-			outfile << "\t}\n";
-			outfile << "\\]";
-			if ((unsigned)m < payoffMatrix.size() - 1)
-				outfile << endl;
-		}
 		cout << "Saved to " << filename << ".\n";
-	}	
+}
+
+// save each player's preference on its own line
+template <typename T>
+bool simGame<T>::savePreferences(string filename)
+{
+	vector<Polynomial*> preferences;
+	vector<string> labels;
+	for (int x = 0; x < numPlayers; x++)
+	{
+		preferences.push_back(players.at(x)->getPreference());
+		labels.push_back("P_" + to_string(x + 1));
+	}
+	return Polynomial::writePolynomials(filename, preferences, labels);
 }
 
 // save game data to file
 template <typename T>
 void simGame<T>::saveToFile()
 {
-	LinkedList<T>* curList;
-	ofstream outfile;
 	string filename;
 	
 	cout << "Enter the name of the file (Example: file.txt):  ";
 	cin >> filename;
 	
-	outfile.open(filename.c_str());
-	if (!outfile)
+	GameStatus status = writeToFile(filename);
+	if (!status.ok)
 		cout << "There was an error opening the file.\n";
 	else
-	{
-		outfile << numPlayers << endl;
-		
-		for (int x = 0; x < numPlayers; x++)
-		{
-			outfile << players.at(x)->getNumStrats();
-			if (x < numPlayers - 1)
-				outfile << " ";
-		}
-		outfile << endl;
-		
-		for (int x = 0; x < numPlayers; x++)
-		{
-			outfile << players.at(x)->getRationality();
-			if (x < numPlayers - 1)
-				outfile << " ";
-		}
-		outfile << endl;
-		
-		int val = -std::numeric_limits<T>::max();
-		for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
-		{
-			for (int i = 0; i < players.at(0)->getNumStrats(); i++)
-			{
-				for (int j = 0; j < players.at(1)->getNumStrats(); j++)
-				{
-					curList = payoffMatrix.at(m).at(i).at(j);
-					for (int x = 0; x < numPlayers; x++)
-					{
-						val = curList->getNodeValue(x);
-						outfile << val;
-						if (x < numPlayers - 1)
-							outfile << " ";
-					}
-					if (j < players.at(1)->getNumStrats() - 1)
-						outfile << " ";
-				}
-				if (i < players.at(0)->getNumStrats() - 1)
-					outfile << endl;
-			}
-			if ((unsigned)m < payoffMatrix.size() - 1)
-				outfile << endl << endl;
-		}
 		cout << "Saved to " << filename << ".\n";
-	}
 }
 
 // set numStrats for all players
@@ -5057,6 +4669,7 @@ template <typename T>
 void simGame<T>::setAllNumStrats(char impartial)
 {
 	int nS = -1, size = 1;
+	invalidatePayoffLengths();
 	
 	cout << "Enter the size of each player's strategy set.  ";
 	if(impartial == 'y')
@@ -5112,11 +4725,80 @@ void simGame<T>::setAllRationalities()
 	{
 		cout << "P_" << x << ": ";
 		cin >> r;
-		validate(r, 0, 3);
-		players.at(x)->setRationality(r);
+		validate(r, 0, MAX_RATIONALITY);
+		setRationality(x, r);
 	}
 }
 
+
+// sets the number of players and their numbers of strategies, resizing the matrices to match; new players are L_0
+template <typename T>
+void simGame<T>::setDimensions(const vector<int> &numStrats)
+{
+	int nP = numStrats.size();
+	
+	for (int x = nP; (unsigned)x < players.size(); x++)
+		delete players.at(x);
+	if (players.size() > (unsigned)nP)
+		players.resize(nP);
+	for (int x = players.size(); x < nP; x++)
+		players.push_back(new Player(nP, x));
+	
+	numPlayers = nP;
+	for (int x = 0; x < numPlayers; x++)
+		players.at(x)->setNumStrats(numStrats.at(x));
+	
+	resizePayoffMatrix();
+	kLevels.clear();
+	computeNumOutcomes();
+	kOutcomes.clear();
+	outcomeProbabilities.clear();
+	mixedEquilibria.clear();
+	clearPureEquilibria();
+	clearParetoPureEquilibria();
+	
+	// a part of the old game means nothing in the new one
+	window.firstMatrix = 0;
+	window.firstRow = 0;
+	window.firstColumn = 0;
+}
+
+/// @brief sets P_x's payoff in the outcome profile
+/// @param profile one strategy per player, numbered from 0
+/// @param x 
+/// @param value 
+/// @return 
+template <typename T>
+GameStatus simGame<T>::setPayoff(vector<int> profile, int x, T value)
+{
+	if (profile.size() != (unsigned)numPlayers)
+		return GameStatus("the profile needs one strategy for each of the " + to_string(numPlayers) + " players");
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("there is no P_" + to_string(x + 1));
+	for (int y = 0; y < numPlayers; y++)
+	{
+		if (profile.at(y) < 0 || profile.at(y) >= players.at(y)->getNumStrats())
+			return GameStatus("P_" + to_string(y + 1) + " has no strategy s_" + to_string(profile.at(y) + 1));
+	}
+	
+	payoffMatrix.at(hash(profile)).at(profile.at(0)).at(profile.at(1))->setNodeValue(x, value);
+	invalidatePayoffLengths();
+	return GameStatus();
+}
+
+// sets P_x's rationality, from 0 to MAX_RATIONALITY
+template <typename T>
+GameStatus simGame<T>::setRationality(int x, int r)
+{
+	if (x < 0 || x >= numPlayers)
+		return GameStatus("there is no P_" + to_string(x + 1));
+	if (r < 0 || r > MAX_RATIONALITY)
+		return GameStatus("rationalities are from 0 to " + to_string(MAX_RATIONALITY));
+	
+	players.at(x)->setRationality(r);
+	return GameStatus();
+}
+
 // Stag Hunt relation between equilibria
 template <typename T>
 bool simGame<T>::shCondition(vector<int> eq1, vector<int> eq2)
@@ -5213,9 +4895,9 @@ bool simGame<T>::shCondition(vector<int> eq1, vector<int> eq2)
 		return false;
 }
 
-// solve polynomial equation for x
+// solve p1 = p2 for the polynomials' variable without modifying either polynomial
 template <typename T>
-double simGame<T>::solve(Polynomial* p1, Polynomial* p2)
+double simGame<T>::solve(const Polynomial* p1, const Polynomial* p2)
 {
 	if (p1->getNumVariables() > 1 || p2->getNumVariables() > 1 )
 	{
@@ -5223,97 +4905,641 @@ double simGame<T>::solve(Polynomial* p1, Polynomial* p2)
 		return -1.0;
 	}
 	
-	if (p1->isConstant() && p2->isConstant())
+	// p1 - p2 = a x + b
+	bool constant = true;
+	double a = 0.0, b = 0.0;
+	for (int t = 0; t < p1->getNumTerms() + p2->getNumTerms(); t++)
+	{
+		const Polynomial* p = t < p1->getNumTerms() ? p1 : p2;
+		int term = t < p1->getNumTerms() ? t : t - p1->getNumTerms();
+		double sign = t < p1->getNumTerms() ? 1.0 : -1.0;
+		int expo = p->getExponent(term, 0);
+		
+		if (expo == 0)
+			b += sign * p->getCoefficient(term);
+		else if (expo == 1)
+		{
+			a += sign * p->getCoefficient(term);
+			constant = false;
+		}
+		else
+		{
+			cout << "ERROR: polynomials must be linear\n";
+			return -1.0;
+		}
+	}
+	
+	if (constant)
 	{
 		cout << "ERROR: polynomials are constant\n";
 		return -2.0;
 	}
 	
-	if (p1->getCoefficient(0) == p2->getCoefficient(0))
+	double x = 0.0, rhs = -b;
+	LinearSolver<double> solver(1);
+	if (!solver.solve(1, &a, &rhs, &x))
 	{
 		cout << "ERROR: variables cancel out\n";
 		return -2.0;
 	}
+	return x;
+}
+
+/*********************************************************************************
+finds every equilibrium of a nondegenerate 2-player game by enumerating
+equal-sized supports I and J; for each pair one batched system makes P_1
+indifferent over I (solving for P_2's probabilities on J) and another makes P_2
+indifferent over J. The result says if the game was seen to be degenerate, in
+which case equilibria may be missing (see SupportEnumerationResult)
+*********************************************************************************/
+template <typename T>
+template <typename S>
+SupportEnumerationResult<S> simGame<T>::supportEnumeration()
+{
+	SupportEnumerationResult<S> result;
+	vector<vector<vector<S> > > &equilibria = result.equilibria;
+	if (numPlayers != 2)
+	{
+		result.status = GameStatus("support enumeration is only implemented for 2-player games");
+		return result;
+	}
+	
+	int n1 = players.at(0)->getNumStrats(), n2 = players.at(1)->getNumStrats();
+	int maxK = n1 < n2 ? n1 : n2;
 	
-	p1->simplify(); // p1 has 1 or 2 terms now
-	p2->simplify(); // p1 has 1 or 2 terms now
+	// payoffs copied once so the inner loops don't walk the linked lists
+	vector<S> A(n1 * n2), B(n1 * n2);
+	for (int i = 0; i < n1; i++)
+		for (int j = 0; j < n2; j++)
+		{
+			A.at(i * n2 + j) = S(payoffMatrix.at(0).at(i).at(j)->getNodeValue(0));
+			B.at(i * n2 + j) = S(payoffMatrix.at(0).at(i).at(j)->getNodeValue(1));
+		}
 	
-	if (!p1->isConstant() && p2->isConstant())
+	// degenerate if a pure strategy has more than one pure best response
+	for (int i = 0; i < n1 && !result.degenerate; i++) // P_2's responses to s_i
 	{
-		// move constant to p2
-		if (p1->getCoefficient(p1->getNumTerms() - 1) != 0)
+		S best = B.at(i * n2);
+		int numBest = 1;
+		for (int j = 1; j < n2; j++)
 		{
-			p2->setCoefficient(p2->getNumTerms() - 1, p2->getCoefficient(p2->getNumTerms() - 1) - p1->getCoefficient(p1->getNumTerms() - 1));
-			p1->setCoefficient(p1->getNumTerms() - 1, 0);
+			if (best < B.at(i * n2 + j))
+			{
+				best = B.at(i * n2 + j);
+				numBest = 1;
+			}
+			else if (PivotTraits<S>::isZero(B.at(i * n2 + j) - best))
+				numBest++;
 		}
-		
-		// solve for the variable of p1
-		// p2->setCoefficient(p2->getNumTerms() - 1, static_cast<double>(p2->getCoefficient(p2->getNumTerms() - 1)) / static_cast<double>(p1->getCoefficient(0)));
-		return static_cast<double>(p2->getCoefficient(p2->getNumTerms() - 1)) / static_cast<double>(p1->getCoefficient(0));
+		result.degenerate = numBest > 1;
 	}
-	else if (p1->isConstant() && !p2->isConstant())
+	for (int j = 0; j < n2 && !result.degenerate; j++) // P_1's responses to s_j
 	{
-		// move constant to p1
-		if (p2->getCoefficient(p2->getNumTerms() - 1) != 0)
+		S best = A.at(j);
+		int numBest = 1;
+		for (int i = 1; i < n1; i++)
 		{
-			p1->setCoefficient(p1->getNumTerms() - 1, p1->getCoefficient(p1->getNumTerms() - 1) - p2->getCoefficient(p2->getNumTerms() - 1));
-			p2->setCoefficient(p2->getNumTerms() - 1, 0);
+			if (best < A.at(i * n2 + j))
+			{
+				best = A.at(i * n2 + j);
+				numBest = 1;
+			}
+			else if (PivotTraits<S>::isZero(A.at(i * n2 + j) - best))
+				numBest++;
 		}
-		
-		// solve for the variable of p2
-		// p1->setCoefficient(p1->getNumTerms() - 1, static_cast<double>(p1->getCoefficient(p1->getNumTerms() - 1)) / static_cast<double>(p2->getCoefficient(0)));
-		return static_cast<double>(p1->getCoefficient(p1->getNumTerms() - 1)) / static_cast<double>(p2->getCoefficient(0));
+		result.degenerate = numBest > 1;
 	}
-	else
+	
+	BatchSolver<S> batch(64, maxK + 1);
+	vector<vector<int> > rowSupports, colSupports;
+	for (int k = 1; k <= maxK; k++)
 	{
-		// move constant to p2
-		if (p1->getCoefficient(p1->getNumTerms() - 1) != 0)
+		// all supports of size k for each player
+		rowSupports.clear();
+		colSupports.clear();
+		for (int p = 0; p < 2; p++)
 		{
-			p2->setCoefficient(p2->getNumTerms() - 1, p2->getCoefficient(p2->getNumTerms() - 1) - p1->getCoefficient(p1->getNumTerms() - 1));
-			p1->setCoefficient(p1->getNumTerms() - 1, 0);
+			int n = p == 0 ? n1 : n2;
+			vector<int> combo = vector<int>(k);
+			for (int c = 0; c < k; c++)
+				combo.at(c) = c;
+			while (true)
+			{
+				(p == 0 ? rowSupports : colSupports).push_back(combo);
+				int c = k - 1;
+				while (c >= 0 && combo.at(c) == n - k + c)
+					c--;
+				if (c < 0)
+					break;
+				combo.at(c)++;
+				for (int d = c + 1; d < k; d++)
+					combo.at(d) = combo.at(d - 1) + 1;
+			}
 		}
-
-		for (int i = 0; i < p1->getNumTerms() - 1; i++) // move nonconsant terms to p1, last is constant
+		
+		// two systems per pair of supports
+		batch.clear();
+		for (int r = 0; (unsigned)r < rowSupports.size(); r++)
+			for (int c = 0; (unsigned)c < colSupports.size(); c++)
+			{
+				vector<int> &I = rowSupports.at(r);
+				vector<int> &J = colSupports.at(c);
+				
+				// unknowns q_J, v: sum_j A[i][j] q_j - v = 0 for i in I, sum_j q_j = 1
+				int q, p;
+				result.status = batch.addSystem(k + 1, q);
+				if (!result.status.ok)
+					return result;
+				S* M = batch.getMatrix(q);
+				S* rhs = batch.getRHS(q);
+				for (int a = 0; a < k; a++)
+				{
+					for (int b = 0; b < k; b++)
+						M[a * (k + 1) + b] = A.at(I.at(a) * n2 + J.at(b));
+					M[a * (k + 1) + k] = S(-1);
+					rhs[a] = S(0);
+				}
+				for (int b = 0; b < k; b++)
+					M[k * (k + 1) + b] = S(1);
+				M[k * (k + 1) + k] = S(0);
+				rhs[k] = S(1);
+				
+				// unknowns p_I, u: sum_i B[i][j] p_i - u = 0 for j in J, sum_i p_i = 1
+				result.status = batch.addSystem(k + 1, p);
+				if (!result.status.ok)
+					return result;
+				M = batch.getMatrix(p);
+				rhs = batch.getRHS(p);
+				for (int b = 0; b < k; b++)
+				{
+					for (int a = 0; a < k; a++)
+						M[b * (k + 1) + a] = B.at(I.at(a) * n2 + J.at(b));
+					M[b * (k + 1) + k] = S(-1);
+					rhs[b] = S(0);
+				}
+				for (int a = 0; a < k; a++)
+					M[k * (k + 1) + a] = S(1);
+				M[k * (k + 1) + k] = S(0);
+				rhs[k] = S(1);
+			}
+		result.status = batch.solveAll();
+		if (!result.status.ok)
 		{
-			p1->setCoefficient(i, p1->getCoefficient(i) - p2->getCoefficient(i)); // move constant to p2
-			p2->setCoefficient(i, 0);
+			mixedEquilibria.clear();
+			equilibria.clear();
+			return result;
 		}
 		
-		// solve for the variable of p1
-		// p2->setCoefficient(p2->getNumTerms() - 1, static_cast<double>(p2->getCoefficient(p2->getNumTerms() - 1)) / static_cast<double>(p1->getCoefficient(0)));
-		return static_cast<double>(p2->getCoefficient(p2->getNumTerms() - 1)) / static_cast<double>(p1->getCoefficient(0));
+		// keep the pairs whose probabilities are positive and that no strategy outside the support beats
+		int system = 0;
+		for (int r = 0; (unsigned)r < rowSupports.size(); r++)
+			for (int c = 0; (unsigned)c < colSupports.size(); c++, system += 2)
+			{
+				if (!batch.isSolved(system) || !batch.isSolved(system + 1))
+					continue;
+				
+				vector<int> &I = rowSupports.at(r);
+				vector<int> &J = colSupports.at(c);
+				const S* q = batch.getSolution(system);
+				const S* p = batch.getSolution(system + 1);
+				bool valid = true;
+				
+				for (int a = 0; a < k && valid; a++)
+				{
+					if (PivotTraits<S>::isNegative(p[a]) || PivotTraits<S>::isZero(p[a])
+						|| PivotTraits<S>::isNegative(q[a]) || PivotTraits<S>::isZero(q[a]))
+						valid = false;
+				}
+				
+				vector<S> p1 = vector<S>(n1, S(0)), p2 = vector<S>(n2, S(0));
+				for (int a = 0; a < k; a++)
+				{
+					p1.at(I.at(a)) = p[a];
+					p2.at(J.at(a)) = q[a];
+				}
+				
+				// more than k pure best responses to a strategy with k in its support means the game is degenerate
+				int numBest1 = 0, numBest2 = 0;
+				bool overflowed = false;
+				for (int i = 0; i < n1 && valid; i++) // P_1's deviations
+				{
+					S eu = S(0);
+					for (int j = 0; j < n2; j++)
+						eu += A.at(i * n2 + j) * p2.at(j);
+					overflowed = overflowed || !PivotTraits<S>::isValid(q[k] - eu);
+					if (PivotTraits<S>::isNegative(q[k] - eu))
+						valid = false;
+					else if (PivotTraits<S>::isZero(q[k] - eu))
+						numBest1++;
+				}
+				for (int j = 0; j < n2 && valid; j++) // P_2's deviations
+				{
+					S eu = S(0);
+					for (int i = 0; i < n1; i++)
+						eu += B.at(i * n2 + j) * p1.at(i);
+					overflowed = overflowed || !PivotTraits<S>::isValid(p[k] - eu);
+					if (PivotTraits<S>::isNegative(p[k] - eu))
+						valid = false;
+					else if (PivotTraits<S>::isZero(p[k] - eu))
+						numBest2++;
+				}
+				if (overflowed)
+				{
+					mixedEquilibria.clear();
+					equilibria.clear();
+					result.status = GameStatus("the expected utilities grew too large for exact arithmetic");
+					return result;
+				}
+				if (valid && (numBest1 > k || numBest2 > k))
+					result.degenerate = true;
+				
+				if (valid)
+				{
+					vector<vector<S> > eq;
+					eq.push_back(p1);
+					eq.push_back(p2);
+					equilibria.push_back(eq);
+					
+					vector<vector<double> > probabilities = vector<vector<double> >(2);
+					for (int i = 0; i < n1; i++)
+						probabilities.at(0).push_back(PivotTraits<S>::toDouble(p1.at(i)));
+					for (int j = 0; j < n2; j++)
+						probabilities.at(1).push_back(PivotTraits<S>::toDouble(p2.at(j)));
+					mixedEquilibria.push_back(probabilities);
+				}
+			}
 	}
+	return result;
 }
 
-// converts an index in a stack of payoff arrays into the sequence of strategies that produce that index
+// every payoff in one flat array, in the order writeToFile() saves them
+template <typename T>
+PayoffTensor<T> simGame<T>::toPayoffTensor()
+{
+	vector<int> numStrats = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+		numStrats.at(x) = players.at(x)->getNumStrats();
+	
+	PayoffTensor<T> payoffs(numStrats);
+	T* p = payoffs.mutableData();
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++, p += numPlayers)
+				payoffMatrix.at(m).at(i).at(j)->getNodeValues(p);
+	return payoffs;
+}
+
+// the game's type as set by determineType()
+template <typename T>
+string simGame<T>::typeName() const
+{
+	if (zs)
+		return "ZS";
+	else if (ih)
+		return "IH";
+	else if (pd)
+		return "PD";
+	else if (pc)
+		return "PC";
+	else if (bos)
+		return "BOS";
+	else if (chicken)
+		return "Chicken";
+	else if (sh)
+		return "SH";
+	else if (null)
+		return "NULL";
+	else
+		return "Undetermined";
+}
+
+// converts an index in a stack of payoff arrays into the sequence of strategies that produce that index; inverse of hash()
 template <typename T>
 vector<int> simGame<T>::unhash(int m)
 {
-	int choice = 0;
-	int previousValues = 0; // values from players below P_x
-	int productNumStrats = 1;
-	vector<int> profile = vector<int>(numPlayers);
-	profile.at(0) = -1;
-	profile.at(1) = -1;
+	vector<int> numStrats = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+		numStrats.at(x) = players.at(x)->getNumStrats();
+	return matrixProfile(m, numStrats);
+}
+
+/// @brief saves the game in the binary format of BinaryGame.h, which loadFromFile() also reads
+/// @param filename 
+/// @return 
+template <typename T>
+GameStatus simGame<T>::writeBinaryFile(string filename)
+{
+	vector<int> rationalities = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+		rationalities.at(x) = players.at(x)->getRationality();
+	return writeBinaryGame(filename, toPayoffTensor(), rationalities);
+}
+
+/// @brief prints the part of the payoff matrices in the print window through one buffer, 
+/// lining the columns up with cachedPayoffLengths()
+/// @param layout what each entry shows
+/// @return true if some of the game wasn't printed
+template <typename T>
+bool simGame<T>::writeMatrices(MatrixLayout layout)
+{
+	int numMatrices = payoffMatrix.size(), numRows = players.at(0)->getNumStrats(), numColumns = players.at(1)->getNumStrats();
+	
+	// a window that's past the end, e.g., after strategies were removed, starts over
+	int firstMatrix = window.firstMatrix < numMatrices ? max(window.firstMatrix, 0) : 0;
+	int firstRow = window.firstRow < numRows ? max(window.firstRow, 0) : 0;
+	int firstColumn = window.firstColumn < numColumns ? max(window.firstColumn, 0) : 0;
 	
-	for (int x = 2; x < numPlayers - 1; x++)
-		productNumStrats *= players.at(x)->getNumStrats();
+	// one past the last ones printed
+	int endMatrix = window.numMatrices > 0 ? min(numMatrices, firstMatrix + window.numMatrices) : numMatrices;
+	int endRow = window.numRows > 0 ? min(numRows, firstRow + window.numRows) : numRows;
+	int endColumn = window.numColumns > 0 ? min(numColumns, firstColumn + window.numColumns) : numColumns;
 	
-	for (int x = numPlayers - 1; x > 1; x--)
+	const vector<vector<int> > &lengths = cachedPayoffLengths();
+	BufferedWriter out(cout);
+	for (int m = firstMatrix; m < endMatrix; m++)
 	{
-		choice = 0;
-		while (productNumStrats * choice + previousValues < m 
-				&& choice != players.at(x)->getNumStrats() - 1)
-			choice++;
+		out << '\n';
+		writeMatrixLabel(out, m);
 		
-		if (productNumStrats * choice + previousValues > m)
-			choice--;
+		// headings; each column's is right-aligned in width, as setw(width) << "s_" would be
+		if (layout == PAYOFFS_AND_BRS_SANS_INFO)
+			out << '\n';
+		if (layout == BRS_ONLY && m == firstMatrix)
+			out << "BR   s_";
+		else if (layout == PAYOFFS_AND_BRS || layout == BRS_ONLY)
+			out << "    s_";
+		else
+			out << "     s_";
+		out << firstColumn + 1;
+		for (int j = firstColumn + 1; j < endColumn; j++)
+		{
+			int width;
+			if (layout == PAYOFFS_AND_BRS) // length + (BR,comma,space,brackets,dash) * nP
+				width = lengths.at(m).at(j - 1) + 6 * numPlayers;
+			else if (layout == PAYOFFS_AND_BRS_SANS_INFO) // length + (BR,comma,space,brackets,dash) * nP + parentheses,space at end, 1
+				width = lengths.at(m).at(j) + 6 * numPlayers + 1;
+			else if (layout == PAYOFFS_ONLY) // length + comma + spaces + parentheses
+				width = lengths.at(m).at(j - 1) + 2 * numPlayers;
+			else if (layout == PAYOFFS_THEN_BRS)
+				width = lengths.at(m).at(j) + 2 * numPlayers;
+			else // nP + (comma + space) * (nP - 1) + 2 parentheses
+				width = numPlayers + 2 * (numPlayers - 1) + 2;
+			out.fill(' ', width - 2);
+			out << "s_" << j + 1;
+		}
+		if (layout == PAYOFFS_THEN_BRS)
+		{
+			out << "\tBR   s_" << firstColumn + 1;
+			for (int j = firstColumn + 1; j < endColumn; j++)
+			{
+				out.fill(' ', 2 + 2 * numPlayers - 2); // 2 + comma + spaces + parentheses, less "s_"
+				out << "s_" << j + 1;
+			}
+		}
+		out << '\n';
 		
-		previousValues += productNumStrats * choice;
-		profile.at(x) = choice;
-		productNumStrats = productNumStrats / players.at(x)->getNumStrats();
-	}	
-	return profile;
+		// printing entries
+		for (int i = firstRow; i < endRow; i++)
+		{
+			out << "s_" << i + 1 << ' ';
+			for (int j = firstColumn; j < endColumn && layout != BRS_ONLY; j++)
+			{
+				LinkedList<T>* curList = payoffMatrix.at(m).at(i).at(j);
+				int length;
+				if (layout == PAYOFFS_ONLY || layout == PAYOFFS_THEN_BRS)
+					length = curList->writePayoffs(out);
+				else
+					length = curList->writeList(out);
+				
+				// extra space to line up the next entry in the row
+				if (layout == PAYOFFS_ONLY)
+				{
+					if (j < endColumn - 1)
+						out << ' ';
+					out.fill(' ', lengths.at(m).at(j) - length);
+				}
+				else if (j < endColumn - 1)
+				{
+					out.fill(' ', lengths.at(m).at(j) - length);
+					out << ' ';
+				}
+			}
+			
+			if (layout == PAYOFFS_THEN_BRS)
+				out << "\ts_" << i + 1 << ' ';
+			for (int j = firstColumn; j < endColumn && (layout == BRS_ONLY || layout == PAYOFFS_THEN_BRS); j++)
+			{
+				payoffMatrix.at(m).at(i).at(j)->writeBRs(out);
+				if (j < endColumn - 1)
+					out << ' ';
+			}
+			out << '\n';
+		}
+		out << '\n';
+	}
+	
+	bool truncated = firstMatrix > 0 || endMatrix < numMatrices || firstRow > 0 || endRow < numRows || firstColumn > 0 || endColumn < numColumns;
+	if (truncated)
+	{
+		if (numMatrices > 1)
+			out << "Matrices " << firstMatrix + 1 << "-" << endMatrix << " of " << numMatrices << ", rows ";
+		else
+			out << "Rows ";
+		out << firstRow + 1 << "-" << endRow << " of " << numRows << ", columns " 
+			<< firstColumn + 1 << "-" << endColumn << " of " << numColumns << " printed\n";
+	}
+	out.flush();
+	return truncated;
+}
+
+// the strategies of P_3, ..., P_n that matrix m is for, e.g., (c_3, c_4) = (1, 2)
+template <typename T>
+void simGame<T>::writeMatrixLabel(BufferedWriter &out, int m)
+{
+	if (numPlayers < 3)
+		return;
+	
+	vector<int> profile = unhash(m);
+	if (numPlayers == 3)
+		out << "(c_3) = (";
+	else if (numPlayers == 4)
+		out << "(c_3, c_4) = (";
+	else if (numPlayers == 5)
+		out << "(c_3, c_4, c_5) = (";
+	else if (numPlayers == 6)
+		out << "(c_3, c_4, c_5, c_6) = (";
+	else
+		out << "(c_3, ..., c_" << numPlayers << ") = (";
+	for (int x = 2; x < numPlayers; x++)
+	{
+		out << profile.at(x) + 1;
+		if (x < numPlayers - 1)
+			out << ", ";
+	}
+	out << ")\n";
+}
+
+/// @brief saves the game in Gambit's .nfg format, without the rationalities
+/// @param filename 
+/// @return 
+template <typename T>
+GameStatus simGame<T>::writeNfgFile(string filename)
+{
+	return writeNfg(filename, toPayoffTensor());
+}
+
+/// @brief saves the payoff matrices as LaTeX kbordermatrix environments, best responses in bold
+/// @param filename 
+/// @return 
+template <typename T>
+GameStatus simGame<T>::writeLatexFile(string filename)
+{
+	ofstream outfile;
+	vector<int> profile;
+	vector<T> values = vector<T>(numPlayers);
+	vector<bool> bestResponses = vector<bool>(numPlayers);
+	
+	outfile.open(filename.c_str());
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+	
+	BufferedWriter out(outfile);
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+	{
+		if (numPlayers > 2)
+		{
+			if (m == 0)
+				out << "\\noindent\n";
+			profile = unhash(m);
+			out << "$";
+			if (numPlayers == 3)
+				out << "(c_3) = (";
+			else if (numPlayers == 4)
+				out << "(c_3, c_4) = (";
+			else if (numPlayers == 5)
+				out << "(c_3, c_4, c_5) = (";
+			else if (numPlayers == 6)
+				out << "(c_3, c_4, c_5, c_6) = (";
+			else
+				out << "(c_3, \\dots, c_" << numPlayers << ") = (";
+			for (int x = 2; x < numPlayers; x++)
+			{
+				out << profile.at(x) + 1;
+				if (x < numPlayers - 1)
+					out << ", ";
+			}
+			out << ")$\n";
+		}
+		
+		out << "\\[\n";
+		out << "\t\\kbordermatrix\n";
+		out << "\t{\n";
+		out << "\t\t& ";
+		for (int j = 0; j < players.at(1)->getNumStrats(); j++)
+		{
+			out << "s_" << j + 1;
+			if (j < players.at(1)->getNumStrats() - 1)
+				out << " & ";
+		}
+		out << " \\\\\n";
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+		{
+			out << "\t\ts_" << i + 1 << " & ";
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
+			{
+				// one pass over the list for the values and one for the flags
+				payoffMatrix.at(m).at(i).at(j)->getNodeValues(&values[0]);
+				payoffMatrix.at(m).at(i).at(j)->getNodeBestResponses(bestResponses);
+				out << '(';
+				for (int x = 0; x < numPlayers; x++)
+				{
+					if (bestResponses[x])
+						out << "\\mathbf{" << values.at(x) << '}';
+					else
+						out << values.at(x);
+					if (x < numPlayers - 1)
+						out << ", ";
+				}
+				out << ") ";
+				if (j < players.at(1)->getNumStrats() - 1)
+					out << "& ";
+			}
+			if (i < players.at(0)->getNumStrats() - 1)
+				out << "\\\\";
+			out << '\n';
+		}
+		out << "\t}\n";
+		out << "\\]";
+		if ((unsigned)m < payoffMatrix.size() - 1)
+			out << '\n';
+	}
+	bool ok = out.flush();
+	outfile.close();
+	if (!ok || outfile.fail())
+		return GameStatus("could not write " + filename);
+	return GameStatus();
+}
+
+/// @brief saves the game in the format loadFromFile() reads
+/// @param filename 
+/// @return 
+template <typename T>
+GameStatus simGame<T>::writeToFile(string filename)
+{
+	ofstream outfile;
+	vector<T> values = vector<T>(numPlayers);
+	
+	outfile.open(filename.c_str());
+	if (!outfile)
+		return GameStatus("could not open " + filename);
+	
+	BufferedWriter out(outfile);
+	out << numPlayers << '\n';
+	
+	for (int x = 0; x < numPlayers; x++)
+	{
+		out << players.at(x)->getNumStrats();
+		if (x < numPlayers - 1)
+			out << ' ';
+	}
+	out << '\n';
+	
+	for (int x = 0; x < numPlayers; x++)
+	{
+		out << players.at(x)->getRationality();
+		if (x < numPlayers - 1)
+			out << ' ';
+	}
+	out << '\n';
+	
+	for (int m = 0; (unsigned)m < payoffMatrix.size(); m++)
+	{
+		for (int i = 0; i < players.at(0)->getNumStrats(); i++)
+		{
+			for (int j = 0; j < players.at(1)->getNumStrats(); j++)
+			{
+				payoffMatrix.at(m).at(i).at(j)->getNodeValues(&values[0]);
+				for (int x = 0; x < numPlayers; x++)
+				{
+					out << values.at(x);
+					if (x < numPlayers - 1)
+						out << ' ';
+				}
+				if (j < players.at(1)->getNumStrats() - 1)
+					out << ' ';
+			}
+			if (i < players.at(0)->getNumStrats() - 1)
+				out << '\n';
+		}
+		if ((unsigned)m < payoffMatrix.size() - 1)
+			out << "\n\n";
+	}
+	
+	bool ok = out.flush();
+	outfile.close();
+	if (!ok || outfile.fail())
+		return GameStatus("could not write " + filename);
+	return GameStatus();
 }
 
 #endif
\ No newline at end of file
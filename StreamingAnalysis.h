@@ -0,0 +1,501 @@
+/*******************************
+Title: StreamingAnalysis.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: best responses, pure equilibria, and dominance for games too large to load
+********************************/
+
+#ifndef STREAMINGANALYSIS_H
+#define STREAMINGANALYSIS_H
+#include "PayoffSource.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+Each analysis reads the payoffs tile by tile in ascending order, so working
+memory is bounded by tileOutcomes however many outcomes the game has.
+
+P_x's best responses are a maximum along one axis of the tensor. Outcome u
+has P_x's strategy a = (u / stride(x)) % n_x, so u splits into a block
+o = u / (n_x * stride(x)), a, and an offset t = u % stride(x) within the
+block; the outcomes sharing o and t are one line along P_x's axis. A tile is
+numBlocks whole blocks when they fit, and otherwise, for one block, the
+offsets first to first + width - 1 of every one of P_x's strategies.
+
+Strategies removed by removeDominatedStrategies() are left out of every
+later analysis, as if the game had been reduced.
+******************************************************************************/
+template <typename T>
+class StreamingAnalysis
+{
+	private:
+		// P_x's payoffs in one tile: values[(b * numStrats + a) * width + t]
+		struct AxisTile
+		{
+			int x;
+			uint64_t firstBlock;
+			size_t numBlocks;
+			uint64_t first;
+			size_t width;
+			int numStrats;
+			vector<T> values;
+		};
+
+		PayoffSource<T>* source;
+		size_t tileOutcomes;
+		int numPlayers;
+		vector<uint64_t> strides; // in outcomes
+		vector<vector<char> > alive; // alive.at(x).at(s): P_x's strategy s hasn't been removed
+		vector<int> numAlive;
+		bool allAlive;
+
+		bool isLineAlive(uint64_t, int) const;
+		bool loadTile(int, uint64_t, size_t, uint64_t, size_t, AxisTile &);
+		template <typename F> bool scanAxis(int, F);
+		void tileFor(int, uint64_t, uint64_t &, uint64_t &) const;
+		void tileShape(int, size_t &, size_t &) const;
+	public:
+		StreamingAnalysis(PayoffSource<T> &, size_t = 1 << 20);
+
+		int getNumAlive(int x) const 					{ return numAlive.at(x); }
+		uint64_t getStride(int x) const 				{ return strides.at(x); }
+		bool isStrategyAlive(int x, int s) const 		{ return alive.at(x).at(s) != 0; }
+
+		GameStatus bestResponses(int, function<void(uint64_t)>);
+		GameStatus countBestResponses(vector<uint64_t> &);
+		uint64_t outcomeIndex(const vector<int> &) const;
+		vector<int> profile(uint64_t) const;
+		GameStatus pureEquilibria(vector<uint64_t> &);
+		GameStatus removeDominatedStrategies(int &);
+};
+
+/// @brief sets up the strides; nothing is read yet
+/// @param s the payoffs, which must outlive the analysis
+/// @param maxTileOutcomes roughly the most outcomes held in memory at once
+template <typename T>
+StreamingAnalysis<T>::StreamingAnalysis(PayoffSource<T> &s, size_t maxTileOutcomes)
+{
+	source = &s;
+	tileOutcomes = maxTileOutcomes > 0 ? maxTileOutcomes : 1;
+	numPlayers = s.getNumPlayers();
+	allAlive = true;
+
+	// P_2 varies fastest, then P_1, then P_3, ..., as in the game file
+	strides = vector<uint64_t>(numPlayers);
+	strides.at(1) = 1;
+	strides.at(0) = s.getNumStrats(1);
+	uint64_t stride = (uint64_t)s.getNumStrats(0) * s.getNumStrats(1);
+	for (int x = 2; x < numPlayers; x++)
+	{
+		strides.at(x) = stride;
+		stride *= s.getNumStrats(x);
+	}
+
+	for (int x = 0; x < numPlayers; x++)
+	{
+		alive.push_back(vector<char>(s.getNumStrats(x), 1));
+		numAlive.push_back(s.getNumStrats(x));
+	}
+}
+
+/// @brief calls visit(u) for every outcome u where P_x is best responding, in the order the tiles are read
+/// @param x
+/// @param visit
+/// @return an error if the payoffs can't be read
+template <typename T>
+GameStatus StreamingAnalysis<T>::bestResponses(int x, function<void(uint64_t)> visit)
+{
+	const vector<char> &strats = alive.at(x);
+	bool ok = scanAxis(x, [&](const AxisTile &tile) -> bool
+	{
+		int n = tile.numStrats;
+		uint64_t blockSize = (uint64_t)n * strides.at(x);
+		for (size_t b = 0; b < tile.numBlocks; b++)
+			for (size_t t = 0; t < tile.width; t++)
+			{
+				uint64_t u0 = (tile.firstBlock + b) * blockSize + tile.first + t;
+				if (!allAlive && !isLineAlive(u0, x))
+					continue;
+
+				const T* line = &tile.values[b * n * tile.width + t];
+				bool found = false;
+				T best = T();
+				for (int a = 0; a < n; a++)
+				{
+					if (strats[a] && (!found || best < line[a * tile.width]))
+					{
+						best = line[a * tile.width];
+						found = true;
+					}
+				}
+				for (int a = 0; a < n; a++)
+				{
+					if (strats[a] && line[a * tile.width] == best)
+						visit(u0 + a * strides.at(x));
+				}
+			}
+		return true;
+	});
+	if (!ok)
+		return GameStatus("could not read the payoffs");
+	return GameStatus();
+}
+
+// counts.at(x): the number of outcomes where P_x is best responding
+template <typename T>
+GameStatus StreamingAnalysis<T>::countBestResponses(vector<uint64_t> &counts)
+{
+	counts = vector<uint64_t>(numPlayers, 0);
+	for (int x = 0; x < numPlayers; x++)
+	{
+		uint64_t* count = &counts.at(x);
+		GameStatus status = bestResponses(x, [count](uint64_t) { (*count)++; });
+		if (!status.ok)
+			return status;
+	}
+	return GameStatus();
+}
+
+// true if no strategy in u, other than P_x's, has been removed
+template <typename T>
+bool StreamingAnalysis<T>::isLineAlive(uint64_t u, int x) const
+{
+	for (int y = 0; y < numPlayers; y++)
+	{
+		if (y != x && !alive.at(y).at((u / strides.at(y)) % source->getNumStrats(y)))
+			return false;
+	}
+	return true;
+}
+
+/// @brief reads one tile of P_x's payoffs
+/// @param x
+/// @param firstBlock
+/// @param numBlocks more than 1 only if the blocks are read whole
+/// @param first offset of the tile within the block
+/// @param width number of offsets
+/// @param tile receives P_x's payoffs
+/// @return false if the payoffs can't be read
+template <typename T>
+bool StreamingAnalysis<T>::loadTile(int x, uint64_t firstBlock, size_t numBlocks, uint64_t first, size_t width, AxisTile &tile)
+{
+	int n = source->getNumStrats(x);
+	uint64_t stride = strides.at(x), blockSize = n * stride;
+	tile.x = x;
+	tile.firstBlock = firstBlock;
+	tile.numBlocks = numBlocks;
+	tile.first = first;
+	tile.width = width;
+	tile.numStrats = n;
+	tile.values.resize(numBlocks * n * width);
+
+	// whole blocks are one read; otherwise one read of width outcomes per strategy
+	if (width == stride)
+	{
+		const T* payoffs = source->read(firstBlock * blockSize, numBlocks * blockSize);
+		if (!payoffs)
+			return false;
+		for (size_t v = 0; v < tile.values.size(); v++)
+			tile.values[v] = payoffs[v * numPlayers + x];
+		return true;
+	}
+
+	for (int a = 0; a < n; a++)
+	{
+		const T* payoffs = source->read(firstBlock * blockSize + a * stride + first, width);
+		if (!payoffs)
+			return false;
+		for (size_t t = 0; t < width; t++)
+			tile.values[a * width + t] = payoffs[t * numPlayers + x];
+	}
+	return true;
+}
+
+// outcome index of profile
+template <typename T>
+uint64_t StreamingAnalysis<T>::outcomeIndex(const vector<int> &profile) const
+{
+	uint64_t u = 0;
+	for (int x = 0; x < numPlayers; x++)
+		u += profile.at(x) * strides.at(x);
+	return u;
+}
+
+// strategy profile of outcome u
+template <typename T>
+vector<int> StreamingAnalysis<T>::profile(uint64_t u) const
+{
+	vector<int> p = vector<int>(numPlayers);
+	for (int x = 0; x < numPlayers; x++)
+		p.at(x) = (u / strides.at(x)) % source->getNumStrats(x);
+	return p;
+}
+
+/******************************************************************************
+equilibria receives every pure equilibrium's outcome index, ascending.
+First the innermost players whose joint box of outcomes fits in a tile are
+checked box by box, and the outcomes where they all best respond become the
+candidates. Each remaining player then filters the candidates, reading only
+the tiles that hold one, so memory is a tile plus the candidates.
+******************************************************************************/
+template <typename T>
+GameStatus StreamingAnalysis<T>::pureEquilibria(vector<uint64_t> &equilibria)
+{
+	vector<uint64_t> candidates;
+
+	// the players whose lines all lie within one box: P_2, P_1, P_3, ... while they fit
+	vector<int> order;
+	order.push_back(1);
+	order.push_back(0);
+	for (int x = 2; x < numPlayers; x++)
+		order.push_back(x);
+	int numInner = 0;
+	uint64_t boxSize = 1;
+	while (numInner < numPlayers && boxSize * source->getNumStrats(order.at(numInner)) <= tileOutcomes)
+		boxSize *= source->getNumStrats(order.at(numInner++));
+
+	if (numInner == 0)
+	{
+		// not even one of P_2's rows fits, so P_2's best responses are the candidates
+		GameStatus status = bestResponses(1, [&candidates](uint64_t u) { candidates.push_back(u); });
+		if (!status.ok)
+			return status;
+		sort(candidates.begin(), candidates.end());
+		numInner = 1;
+	}
+	else
+	{
+		uint64_t numBoxes = source->getNumOutcomes() / boxSize;
+		uint64_t boxesPerRead = max((uint64_t)1, tileOutcomes / boxSize);
+		vector<char> isCandidate, seen;
+		vector<T> lineMax;
+		for (uint64_t box = 0; box < numBoxes; box += boxesPerRead)
+		{
+			uint64_t count = min(boxesPerRead, numBoxes - box) * boxSize;
+			const T* payoffs = source->read(box * boxSize, count);
+			if (!payoffs)
+				return GameStatus("could not read the payoffs");
+
+			isCandidate.assign(count, 1);
+			if (!allAlive)
+				for (uint64_t v = 0; v < count; v++)
+					isCandidate[v] = isLineAlive(box * boxSize + v, -1);
+
+			for (int k = 0; k < numInner; k++)
+			{
+				int x = order.at(k), n = source->getNumStrats(x);
+				uint64_t stride = strides.at(x), blockSize = n * stride;
+
+				// lineMax[o * stride + t] is P_x's best payoff on line (o, t) among live strategies
+				lineMax.assign(count / n, T());
+				seen.assign(count / n, 0);
+				for (uint64_t v = 0; v < count; v++)
+				{
+					uint64_t o = v / blockSize, a = (v / stride) % n, t = v % stride;
+					T payoff = payoffs[v * numPlayers + x];
+					if (alive.at(x).at(a) && (!seen[o * stride + t] || lineMax[o * stride + t] < payoff))
+					{
+						lineMax[o * stride + t] = payoff;
+						seen[o * stride + t] = 1;
+					}
+				}
+				for (uint64_t v = 0; v < count; v++)
+				{
+					uint64_t o = v / blockSize, a = (v / stride) % n, t = v % stride;
+					if (isCandidate[v] && (!alive.at(x).at(a) || payoffs[v * numPlayers + x] != lineMax[o * stride + t]))
+						isCandidate[v] = 0;
+				}
+			}
+			for (uint64_t v = 0; v < count; v++)
+			{
+				if (isCandidate[v])
+					candidates.push_back(box * boxSize + v);
+			}
+		}
+	}
+
+	// the other players filter the candidates a tile at a time
+	AxisTile tile;
+	for (int k = numInner; k < numPlayers && !candidates.empty(); k++)
+	{
+		int x = order.at(k);
+		uint64_t stride = strides.at(x);
+
+		// candidates grouped by tile, keeping each group in ascending order
+		vector<pair<pair<uint64_t, uint64_t>, uint64_t> > byTile;
+		for (size_t c = 0; c < candidates.size(); c++)
+		{
+			uint64_t firstBlock, first;
+			tileFor(x, candidates.at(c), firstBlock, first);
+			byTile.push_back(make_pair(make_pair(firstBlock, first), candidates.at(c)));
+		}
+		sort(byTile.begin(), byTile.end());
+
+		vector<uint64_t> kept;
+		int n = source->getNumStrats(x);
+		uint64_t blockSize = n * stride, numBlocks = source->getNumOutcomes() / blockSize;
+		size_t width, blocksPerTile;
+		tileShape(x, width, blocksPerTile);
+		for (size_t c = 0; c < byTile.size(); )
+		{
+			uint64_t firstBlock = byTile.at(c).first.first, first = byTile.at(c).first.second;
+			if (!loadTile(x, firstBlock, min((uint64_t)blocksPerTile, numBlocks - firstBlock), first, min((uint64_t)width, stride - first), tile))
+				return GameStatus("could not read the payoffs");
+
+			for (; c < byTile.size() && byTile.at(c).first == make_pair(firstBlock, first); c++)
+			{
+				uint64_t u = byTile.at(c).second;
+				uint64_t b = u / blockSize - firstBlock, a = (u / stride) % n, t = u % stride - first;
+				const T* line = &tile.values[b * n * tile.width + t];
+				bool best = true;
+				for (int s = 0; s < n && best; s++)
+				{
+					if (alive.at(x).at(s) && line[a * tile.width] < line[s * tile.width])
+						best = false;
+				}
+				if (best)
+					kept.push_back(u);
+			}
+		}
+		sort(kept.begin(), kept.end());
+		candidates.swap(kept);
+	}
+
+	equilibria.swap(candidates);
+	return GameStatus();
+}
+
+/******************************************************************************
+numRemoved receives the number of strictly dominated strategies removed.
+Like simGame::removeDominatedStrategies(), players are taken from last to
+first, each in one pass, and a player is never left with fewer than 2
+strategies. For each of P_x's strategies a, dominators.at(a) lists the live
+strategies that have beaten a on every line so far; the scan stops early
+once no list is left.
+******************************************************************************/
+template <typename T>
+GameStatus StreamingAnalysis<T>::removeDominatedStrategies(int &numRemoved)
+{
+	numRemoved = 0;
+	for (int x = numPlayers - 1; x >= 0; x--)
+	{
+		int n = source->getNumStrats(x);
+		if (numAlive.at(x) <= 2)
+			continue;
+
+		vector<vector<int> > dominators = vector<vector<int> >(n);
+		int numOpen = 0; // strategies that could still be dominated
+		for (int a = 0; a < n; a++)
+		{
+			if (!alive.at(x).at(a))
+				continue;
+			for (int b = 0; b < n; b++)
+			{
+				if (b != a && alive.at(x).at(b))
+					dominators.at(a).push_back(b);
+			}
+			numOpen++;
+		}
+
+		bool ok = scanAxis(x, [&](const AxisTile &tile) -> bool
+		{
+			uint64_t blockSize = (uint64_t)n * strides.at(x);
+			for (size_t blk = 0; blk < tile.numBlocks; blk++)
+				for (size_t t = 0; t < tile.width; t++)
+				{
+					if (!allAlive && !isLineAlive((tile.firstBlock + blk) * blockSize + tile.first + t, x))
+						continue;
+
+					const T* line = &tile.values[blk * n * tile.width + t];
+					for (int a = 0; a < n; a++)
+					{
+						vector<int> &d = dominators.at(a);
+						if (d.empty())
+							continue;
+						for (size_t k = 0; k < d.size(); )
+						{
+							if (line[a * tile.width] < line[d[k] * tile.width])
+								k++;
+							else
+							{
+								d[k] = d.back();
+								d.pop_back();
+							}
+						}
+						if (d.empty())
+							numOpen--;
+					}
+					if (numOpen == 0)
+						return false;
+				}
+			return true;
+		});
+		if (!ok && numOpen > 0)
+			return GameStatus("could not read the payoffs");
+
+		for (int a = 0; a < n && numAlive.at(x) > 2; a++)
+		{
+			if (alive.at(x).at(a) && !dominators.at(a).empty())
+			{
+				alive.at(x).at(a) = 0;
+				numAlive.at(x)--;
+				numRemoved++;
+				allAlive = false;
+			}
+		}
+	}
+	return GameStatus();
+}
+
+/// @brief reads every tile along P_x's axis in ascending order, calling visit(tile) on each
+/// @param x
+/// @param visit returns false to stop early
+/// @return false if the payoffs can't be read or visit stopped the scan
+template <typename T>
+template <typename F>
+bool StreamingAnalysis<T>::scanAxis(int x, F visit)
+{
+	int n = source->getNumStrats(x);
+	uint64_t stride = strides.at(x), blockSize = n * stride, numBlocks = source->getNumOutcomes() / blockSize;
+	size_t width, blocksPerTile;
+	tileShape(x, width, blocksPerTile);
+
+	AxisTile tile;
+	for (uint64_t o = 0; o < numBlocks; o += blocksPerTile)
+		for (uint64_t first = 0; first < stride; first += width)
+		{
+			if (!loadTile(x, o, min((uint64_t)blocksPerTile, numBlocks - o), first, min((uint64_t)width, stride - first), tile))
+				return false;
+			if (!visit(tile))
+				return false;
+		}
+	return true;
+}
+
+// the tile scanAxis(x, ...) reads outcome u in
+template <typename T>
+void StreamingAnalysis<T>::tileFor(int x, uint64_t u, uint64_t &firstBlock, uint64_t &first) const
+{
+	uint64_t stride = strides.at(x), blockSize = source->getNumStrats(x) * stride;
+	size_t width, blocksPerTile;
+	tileShape(x, width, blocksPerTile);
+
+	firstBlock = u / blockSize / blocksPerTile * blocksPerTile;
+	first = u % stride / width * width;
+}
+
+// a tile along P_x's axis is blocksPerTile whole blocks, or width offsets of one block
+template <typename T>
+void StreamingAnalysis<T>::tileShape(int x, size_t &width, size_t &blocksPerTile) const
+{
+	int n = source->getNumStrats(x);
+	uint64_t stride = strides.at(x), blockSize = n * stride;
+	width = min((uint64_t)max((size_t)1, tileOutcomes / n), stride);
+	blocksPerTile = width == stride ? max((uint64_t)1, tileOutcomes / blockSize) : 1;
+}
+
+#endif
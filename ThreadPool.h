@@ -0,0 +1,117 @@
+/*******************************
+Title: ThreadPool.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: fixed set of worker threads for batch analysis
+********************************/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// runs queued tasks on numThreads workers; the destructor finishes the queue before joining
+class ThreadPool
+{
+	private:
+		vector<thread> workers;
+		queue<function<void()> > tasks;
+		mutex queueMutex;
+		condition_variable taskAvailable;
+		condition_variable allDone;
+		int numPending; // queued or running
+		bool stopping;
+
+		void work();
+	public:
+		ThreadPool(int);
+		~ThreadPool();
+
+		int getNumThreads() const { return workers.size(); }
+
+		void push(function<void()>);
+		void wait();
+};
+
+/// @brief starts the workers
+/// @param numThreads 0 uses one thread per hardware thread
+ThreadPool::ThreadPool(int numThreads)
+{
+	numPending = 0;
+	stopping = false;
+
+	if (numThreads < 1)
+		numThreads = thread::hardware_concurrency();
+	if (numThreads < 1)
+		numThreads = 1;
+
+	for (int t = 0; t < numThreads; t++)
+		workers.push_back(thread(&ThreadPool::work, this));
+}
+
+// destructor
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for (int t = 0; (unsigned)t < workers.size(); t++)
+		workers.at(t).join();
+}
+
+// queue a task
+void ThreadPool::push(function<void()> task)
+{
+	{
+		lock_guard<mutex> lock(queueMutex);
+		tasks.push(task);
+		numPending++;
+	}
+	taskAvailable.notify_one();
+}
+
+// block until every queued task has finished
+void ThreadPool::wait()
+{
+	unique_lock<mutex> lock(queueMutex);
+	while (numPending > 0)
+		allDone.wait(lock);
+}
+
+// worker loop: take the next task until the pool stops and the queue is empty
+void ThreadPool::work()
+{
+	function<void()> task;
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(queueMutex);
+			while (!stopping && tasks.empty())
+				taskAvailable.wait(lock);
+			if (tasks.empty())
+				return;
+
+			task = tasks.front();
+			tasks.pop();
+		}
+
+		task();
+
+		{
+			lock_guard<mutex> lock(queueMutex);
+			numPending--;
+			if (numPending == 0)
+				allDone.notify_all();
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*******************************
+Title: WorkStealingPool.h
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: worker threads with a task queue each, taking work from each other when theirs run out
+********************************/
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/******************************************************************************
+For tasks that push more tasks, e.g., one per subtree of a tree. A task
+pushed by a worker goes on the back of that worker's own queue, and the
+worker takes from the back, so it works depth first on what it just split
+off while that's still in cache. A worker whose queue is empty steals from
+the front of another's, taking the oldest task there, which in a recursive
+split is the biggest, so a steal is rare and worth its cost. Tasks pushed
+from outside the pool are dealt to the queues in turn. Unlike ThreadPool,
+no lock is shared by every push and pop, only each queue's own.
+wait() must not be called from a task.
+******************************************************************************/
+class WorkStealingPool
+{
+	private:
+		vector<thread> workers;
+		vector<deque<function<void()> > > queues;
+		vector<mutex> queueMutexes;
+		mutex idleMutex; // guards sleeping while nothing is queued
+		condition_variable taskAvailable;
+		mutex doneMutex;
+		condition_variable allDone;
+		atomic<int> numQueued;
+		atomic<int> numPending; // queued or running
+		atomic<unsigned> nextQueue; // for tasks pushed from outside
+		bool stopping;
+
+		static const WorkStealingPool*& currentPool();
+		static int& currentWorker();
+		bool take(int, function<void()> &);
+		void work(int);
+	public:
+		WorkStealingPool(int);
+		~WorkStealingPool();
+
+		int getNumThreads() const { return workers.size(); }
+
+		void push(function<void()>);
+		void wait();
+};
+
+/// @brief starts the workers
+/// @param numThreads 0 uses one thread per hardware thread
+inline WorkStealingPool::WorkStealingPool(int numThreads) : queueMutexes(numThreads < 1 ? max(1u, thread::hardware_concurrency()) : numThreads)
+{
+	numThreads = queueMutexes.size();
+	queues.resize(numThreads);
+	numQueued = 0;
+	numPending = 0;
+	nextQueue = 0;
+	stopping = false;
+	for (int t = 0; t < numThreads; t++)
+		workers.push_back(thread(&WorkStealingPool::work, this, t));
+}
+
+// destructor
+inline WorkStealingPool::~WorkStealingPool()
+{
+	{
+		lock_guard<mutex> lock(idleMutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for (int t = 0; (unsigned)t < workers.size(); t++)
+		workers.at(t).join();
+}
+
+// the pool the calling thread works for, if any
+inline const WorkStealingPool*& WorkStealingPool::currentPool()
+{
+	static thread_local const WorkStealingPool* pool = NULL;
+	return pool;
+}
+
+// the calling thread's queue in currentPool()
+inline int& WorkStealingPool::currentWorker()
+{
+	static thread_local int worker = -1;
+	return worker;
+}
+
+// queue a task, on the calling worker's own queue if it's one of this pool's
+inline void WorkStealingPool::push(function<void()> task)
+{
+	int q = currentPool() == this ? currentWorker() : (int)(nextQueue++ % queues.size());
+	numPending++;
+	{
+		lock_guard<mutex> lock(queueMutexes[q]);
+		queues[q].push_back(task);
+	}
+	numQueued++;
+
+	// a worker checks numQueued holding idleMutex before it sleeps, so it can't miss this
+	{
+		lock_guard<mutex> lock(idleMutex);
+	}
+	taskAvailable.notify_one();
+}
+
+// the newest task on worker w's queue, or else the oldest on another's; false if every queue is empty
+inline bool WorkStealingPool::take(int w, function<void()> &task)
+{
+	int n = queues.size();
+	for (int i = 0; i < n; i++)
+	{
+		int q = (w + i) % n;
+		lock_guard<mutex> lock(queueMutexes[q]);
+		if (queues[q].empty())
+			continue;
+		if (i == 0)
+		{
+			task = queues[q].back();
+			queues[q].pop_back();
+		}
+		else
+		{
+			task = queues[q].front();
+			queues[q].pop_front();
+		}
+		numQueued--;
+		return true;
+	}
+	return false;
+}
+
+// block until every queued task, and every task they push, has finished
+inline void WorkStealingPool::wait()
+{
+	unique_lock<mutex> lock(doneMutex);
+	while (numPending > 0)
+		allDone.wait(lock);
+}
+
+// worker loop: run tasks until the pool stops and every queue is empty
+inline void WorkStealingPool::work(int w)
+{
+	currentPool() = this;
+	currentWorker() = w;
+	function<void()> task;
+	while (true)
+	{
+		if (take(w, task))
+		{
+			task();
+			task = function<void()>();
+			if (--numPending == 0)
+			{
+				lock_guard<mutex> lock(doneMutex);
+				allDone.notify_all();
+			}
+			continue;
+		}
+
+		unique_lock<mutex> lock(idleMutex);
+		while (!stopping && numQueued == 0)
+			taskAvailable.wait(lock);
+		if (stopping && numQueued == 0)
+			return;
+	}
+}
+
+#endif
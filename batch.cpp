@@ -0,0 +1,944 @@
+/*******************************
+Title: batch.cpp
+Author: Andrew Lounsbury
+Date: 10/19/2026
+Purpose: analyses many game files without the menu
+********************************/
+#include "SimGame.h"
+#include "Estimation.h"
+#include "GameClasses.h"
+#include "ResultWriter.h"
+#include "StreamingAnalysis.h"
+#include "ThreadPool.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+/*****************************************************************************
+usage: batch [options] <file or directory>...
+       batch --generate TYPE --write-corpus FILE [options]
+       batch --estimate MODEL --observations FILE [options]
+Each result is a line file<TAB>analysis<TAB>key<TAB>value, or with --format
+a CSV row or a JSON Lines record (see ResultWriter.h), and the games'
+results appear in the order the games were given, each as soon as it and
+every game before it are done. Directories contribute their .txt, .bin
+(see BinaryGame.h), .nfg (see GambitFormat.h), and .gtc (see GameCorpus.h)
+files. A corpus's games are analysed in pieces of GAMES_PER_TASK and named
+file#k, k counting from 0.
+Binary games with more payoffs than simGame can hold are analysed in place
+by StreamingAnalysis: br gives counts instead of profiles, and only br,
+pure, and reduce are available.
+--generate draws games of one type (see GameClasses.h) straight into a
+corpus instead of reading any.
+--estimate fits level shares (levels) or the logit QRE precision (qre) to
+the choices in an observations file (see Estimation.h), whose lines are
+	<game file or corpus.gtc#k> <counts>
+the counts being how many chose each strategy, a list per player separated
+by semicolons, e.g., 12,30;15,27. Lines starting with # are skipped.
+*****************************************************************************/
+
+const size_t GAMES_PER_TASK = 256;
+
+// analyses in the order they run; reduce changes the game for the ones after it
+struct BatchOptions
+{
+	vector<string> analyses;
+	vector<string> files;
+	vector<double> levelProbabilities;
+	vector<double> chProbabilities; // for ch; Poisson(meanLevel) if none are given
+	double meanLevel;
+	int numThreads;
+	int shard; // only this shard of each corpus is analysed
+	int numShards;
+	string output;
+	ResultFormat format;
+	string corpusOutput; // if set, the games are packed into this corpus instead
+	string generate; // if set, games of this type are drawn into corpusOutput instead of read
+	uint64_t numGenerated;
+	RandGameOptions randomOptions; // for generate
+	string estimate; // if set, this model is fitted to the choices in observations instead
+	string observations;
+	int maxLevel; // for estimate levels
+	SimulationOptions simulation; // for simulate; its levels are levelProbabilities and its seed randomOptions.seed
+
+	BatchOptions()
+	{
+		numThreads = 0;
+		format = TSV_RESULTS;
+		shard = 0;
+		numShards = 1;
+		levelProbabilities = vector<double>(3, 0.25);
+		meanLevel = 1.5;
+		numGenerated = 1000;
+		maxLevel = 3;
+		randomOptions.numStrats = vector<int>(2, 2);
+		simulation.numPopulations = 10000;
+		simulation.numThreads = 1; // the games are already analysed in parallel
+	}
+};
+
+// a game file, or some of a corpus's games
+struct BatchTask
+{
+	string file;
+	const GameCorpus* corpus; // NULL for a game file
+	size_t first; // games first to last - 1 of corpus
+	size_t last;
+	string error; // why the file couldn't be opened
+
+	BatchTask(const string &f) : file(f), corpus(NULL), first(0), last(0) {}
+};
+
+// results waiting to be written in input order
+struct OrderedOutput
+{
+	ostream* out;
+	mutex outputMutex;
+	vector<string> results;
+	vector<bool> ready;
+	int next; // first game not yet written
+
+	OrderedOutput(ostream* o, int numGames) : out(o), results(numGames), ready(numGames, false), next(0) {}
+
+	void finish(int game, const string &result)
+	{
+		lock_guard<mutex> lock(outputMutex);
+		results.at(game) = result;
+		ready.at(game) = true;
+		while ((unsigned)next < ready.size() && ready.at(next))
+		{
+			*out << results.at(next);
+			results.at(next).clear();
+			next++;
+		}
+		out->flush();
+	}
+};
+
+// prints usage
+void printUsage()
+{
+	cerr << "usage: batch [options] <file or directory>...\n";
+	cerr << "       batch --generate TYPE --write-corpus FILE [options]\n";
+	cerr << "       batch --estimate MODEL --observations FILE [options]\n";
+	cerr << "  -a, --analyses LIST         comma-separated from br, pure, mixed, type, reduce, kmatrix, ch, qre, simulate, reveal (default: pure,type)\n";
+	cerr << "  -c, --ch-probabilities LIST P(L_0),...,P(L_K) for ch, the cognitive hierarchy (default: Poisson levels)\n";
+	cerr << "  -d, --max-level K           highest level fitted by --estimate levels (default: 3)\n";
+	cerr << "  -e, --estimate MODEL        fit levels, the level shares and an error rate, or qre, the logit precision\n";
+	cerr << "  -f, --format FORMAT         tsv, csv, or json for JSON Lines, one record per analysis (default: tsv)\n";
+	cerr << "  -g, --generate TYPE         draw random ZS, IH, PD, PC, BOS, Chicken, SH, or NULL games into the -w corpus\n";
+	cerr << "  -i, --observations FILE     the games and choice counts --estimate fits to\n";
+	cerr << "  -j, --threads N             number of worker threads (default: one per hardware thread)\n";
+	cerr << "  -k, --k-probabilities LIST  P(L_0),...,P(L_K) for kmatrix and simulate, the rest going to L_K+1 (default: 0.25,0.25,0.25)\n";
+	cerr << "  -l, --list FILE             also analyse the games named in FILE, one per line\n";
+	cerr << "  -m, --mean-level TAU        mean of the Poisson levels for ch (default: 1.5)\n";
+	cerr << "  -n, --count N               number of games to generate (default: 1000)\n";
+	cerr << "  -o, --output FILE           write results to FILE instead of stdout\n";
+	cerr << "  -p, --payoffs MIN,MAX       range of generated payoffs (default: 0,99)\n";
+	cerr << "  -r, --seed N                seed for generated games and simulate; 0 seeds from the clock (default: 0)\n";
+	cerr << "  -s, --shard I/N             analyse only shard I (from 0) of N of each corpus\n";
+	cerr << "  -t, --strategies LIST       strategies per player of generated games (default: 2,2)\n";
+	cerr << "  -u, --populations N         number of populations simulate draws (default: 10000)\n";
+	cerr << "  -v, --max-rationality K     generated games' players are L_0 to L_K at random (default: 3)\n";
+	cerr << "  -w, --write-corpus FILE     pack the games into the corpus FILE instead of analysing them\n";
+	cerr << "  -y, --error-rate E          chance a simulated player chooses at random (default: 0)\n";
+	cerr << "  -z, --population-size N     players per role in each simulated population (default: 100)\n";
+}
+
+// splits a comma-separated list
+vector<string> splitList(const string &s)
+{
+	vector<string> items;
+	string item;
+	istringstream stream(s);
+	while (getline(stream, item, ','))
+	{
+		if (!item.empty())
+			items.push_back(item);
+	}
+	return items;
+}
+
+// adds path, or the game files in it if it's a directory, in name order
+bool addGames(const string &path, vector<string> &files)
+{
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+	{
+		cerr << "ERROR: could not find " << path << endl;
+		return false;
+	}
+	if (!S_ISDIR(info.st_mode))
+	{
+		files.push_back(path);
+		return true;
+	}
+
+	DIR* dir = opendir(path.c_str());
+	if (!dir)
+	{
+		cerr << "ERROR: could not open directory " << path << endl;
+		return false;
+	}
+
+	vector<string> names;
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL)
+	{
+		string name = entry->d_name;
+		string extension = name.size() > 4 ? name.substr(name.size() - 4) : "";
+		if (extension == ".txt" || extension == ".bin" || extension == ".nfg" || extension == ".gtc")
+			names.push_back(name);
+	}
+	closedir(dir);
+
+	sort(names.begin(), names.end());
+	string prefix = path;
+	if (prefix.back() != '/')
+		prefix += '/';
+	for (int n = 0; (unsigned)n < names.size(); n++)
+		files.push_back(prefix + names.at(n));
+	return true;
+}
+
+// reads the command line; false if it's invalid
+bool parseArguments(int argc, char* argv[], BatchOptions &options)
+{
+	for (int a = 1; a < argc; a++)
+	{
+		string arg = argv[a];
+		bool hasValue = a + 1 < argc;
+
+		if (arg == "-h" || arg == "--help")
+			return false;
+		else if (arg == "-a" || arg == "--analyses")
+		{
+			if (!hasValue)
+				return false;
+			options.analyses = splitList(argv[++a]);
+		}
+		else if (arg == "-c" || arg == "--ch-probabilities")
+		{
+			if (!hasValue)
+				return false;
+			vector<string> items = splitList(argv[++a]);
+			options.chProbabilities.clear();
+			for (int n = 0; (unsigned)n < items.size(); n++)
+				options.chProbabilities.push_back(atof(items.at(n).c_str()));
+		}
+		else if (arg == "-d" || arg == "--max-level")
+		{
+			if (!hasValue)
+				return false;
+			options.maxLevel = atoi(argv[++a]);
+		}
+		else if (arg == "-e" || arg == "--estimate")
+		{
+			if (!hasValue || (string(argv[++a]) != "levels" && string(argv[a]) != "qre"))
+			{
+				cerr << "ERROR: --estimate needs levels or qre" << endl;
+				return false;
+			}
+			options.estimate = argv[a];
+		}
+		else if (arg == "-f" || arg == "--format")
+		{
+			if (!hasValue || !parseResultFormat(argv[++a], options.format))
+			{
+				cerr << "ERROR: --format needs tsv, csv, or json" << endl;
+				return false;
+			}
+		}
+		else if (arg == "-g" || arg == "--generate")
+		{
+			GameClass c;
+			if (!hasValue || !parseGameClass(argv[++a], c))
+			{
+				cerr << "ERROR: --generate needs ZS, IH, PD, PC, BOS, Chicken, SH, or NULL" << endl;
+				return false;
+			}
+			options.generate = GAME_CLASS_NAMES[c];
+		}
+		else if (arg == "-i" || arg == "--observations")
+		{
+			if (!hasValue)
+				return false;
+			options.observations = argv[++a];
+		}
+		else if (arg == "-j" || arg == "--threads")
+		{
+			if (!hasValue)
+				return false;
+			options.numThreads = atoi(argv[++a]);
+		}
+		else if (arg == "-k" || arg == "--k-probabilities")
+		{
+			if (!hasValue)
+				return false;
+			vector<string> items = splitList(argv[++a]);
+			options.levelProbabilities.clear();
+			for (int n = 0; (unsigned)n < items.size(); n++)
+				options.levelProbabilities.push_back(atof(items.at(n).c_str()));
+		}
+		else if (arg == "-l" || arg == "--list")
+		{
+			if (!hasValue)
+				return false;
+			ifstream list(argv[++a]);
+			if (!list)
+			{
+				cerr << "ERROR: could not open " << argv[a] << endl;
+				return false;
+			}
+			string line;
+			while (getline(list, line))
+			{
+				if (!line.empty() && line.back() == '\r')
+					line.erase(line.size() - 1);
+				if (!line.empty() && !addGames(line, options.files))
+					return false;
+			}
+		}
+		else if (arg == "-m" || arg == "--mean-level")
+		{
+			if (!hasValue || !(atof(argv[++a]) > 0))
+			{
+				cerr << "ERROR: --mean-level needs a positive number" << endl;
+				return false;
+			}
+			options.meanLevel = atof(argv[a]);
+		}
+		else if (arg == "-n" || arg == "--count")
+		{
+			if (!hasValue)
+				return false;
+			options.numGenerated = strtoull(argv[++a], NULL, 10);
+		}
+		else if (arg == "-o" || arg == "--output")
+		{
+			if (!hasValue)
+				return false;
+			options.output = argv[++a];
+		}
+		else if (arg == "-p" || arg == "--payoffs")
+		{
+			if (!hasValue || sscanf(argv[++a], "%d,%d", &options.randomOptions.minPayoff, &options.randomOptions.maxPayoff) != 2)
+			{
+				cerr << "ERROR: --payoffs needs MIN,MAX" << endl;
+				return false;
+			}
+		}
+		else if (arg == "-r" || arg == "--seed")
+		{
+			if (!hasValue)
+				return false;
+			options.randomOptions.seed = strtoull(argv[++a], NULL, 10);
+		}
+		else if (arg == "-s" || arg == "--shard")
+		{
+			if (!hasValue || sscanf(argv[++a], "%d/%d", &options.shard, &options.numShards) != 2
+				|| options.numShards < 1 || options.shard < 0 || options.shard >= options.numShards)
+			{
+				cerr << "ERROR: --shard needs I/N with 0 <= I < N" << endl;
+				return false;
+			}
+		}
+		else if (arg == "-t" || arg == "--strategies")
+		{
+			if (!hasValue)
+				return false;
+			vector<string> items = splitList(argv[++a]);
+			options.randomOptions.numStrats.clear();
+			for (int n = 0; (unsigned)n < items.size(); n++)
+				options.randomOptions.numStrats.push_back(atoi(items.at(n).c_str()));
+		}
+		else if (arg == "-u" || arg == "--populations")
+		{
+			if (!hasValue)
+				return false;
+			options.simulation.numPopulations = strtoull(argv[++a], NULL, 10);
+		}
+		else if (arg == "-v" || arg == "--max-rationality")
+		{
+			if (!hasValue)
+				return false;
+			options.randomOptions.maxRationality = atoi(argv[++a]);
+		}
+		else if (arg == "-w" || arg == "--write-corpus")
+		{
+			if (!hasValue)
+				return false;
+			options.corpusOutput = argv[++a];
+		}
+		else if (arg == "-y" || arg == "--error-rate")
+		{
+			if (!hasValue)
+				return false;
+			options.simulation.errorRate = atof(argv[++a]);
+		}
+		else if (arg == "-z" || arg == "--population-size")
+		{
+			if (!hasValue)
+				return false;
+			options.simulation.populationSize = atoi(argv[++a]);
+		}
+		else if (!arg.empty() && arg[0] == '-')
+		{
+			cerr << "ERROR: unknown option " << arg << endl;
+			return false;
+		}
+		else if (!addGames(arg, options.files))
+			return false;
+	}
+
+	if (!options.generate.empty())
+	{
+		if (options.corpusOutput.empty() || !options.files.empty())
+		{
+			cerr << "ERROR: --generate needs --write-corpus and no input files" << endl;
+			return false;
+		}
+		return true;
+	}
+	if (!options.estimate.empty())
+	{
+		if (options.observations.empty() || !options.files.empty())
+		{
+			cerr << "ERROR: --estimate needs --observations and no input files" << endl;
+			return false;
+		}
+		return true;
+	}
+
+	if (options.analyses.empty())
+		options.analyses = splitList("pure,type");
+	for (int n = 0; (unsigned)n < options.analyses.size(); n++)
+	{
+		const string &analysis = options.analyses.at(n);
+		if (analysis != "br" && analysis != "pure" && analysis != "mixed" && analysis != "type"
+			&& analysis != "reduce" && analysis != "kmatrix" && analysis != "ch" && analysis != "qre"
+			&& analysis != "simulate" && analysis != "reveal")
+		{
+			cerr << "ERROR: unknown analysis " << analysis << endl;
+			return false;
+		}
+	}
+	if (options.chProbabilities.empty())
+		options.chProbabilities = poissonLevels(options.meanLevel, poissonMaxLevel(options.meanLevel));
+	return !options.files.empty();
+}
+
+// next profile in lexicographic order; false after the last one
+bool nextProfile(simGame<int> &game, vector<int> &profile)
+{
+	for (int x = game.getNumPlayers() - 1; x >= 0; x--)
+	{
+		if (++profile.at(x) < game.getPlayer(x)->getNumStrats())
+			return true;
+		profile.at(x) = 0;
+	}
+	return false;
+}
+
+// runs every analysis on game, naming its results file
+void analyseGame(ResultWriter &out, const string &file, simGame<int> &game, const BatchOptions &options)
+{
+	for (int n = 0; (unsigned)n < options.analyses.size(); n++)
+	{
+		const string &analysis = options.analyses.at(n);
+		if (analysis == "br")
+		{
+			game.computeBestResponses();
+			out.beginRecord(file, "best_responses");
+			for (int x = 0; x < game.getNumPlayers(); x++)
+			{
+				vector<vector<int> > responses;
+				vector<int> profile = vector<int>(game.getNumPlayers(), 0);
+				do
+				{
+					if (game.getBestResponse(profile, x))
+						responses.push_back(profile);
+				} while (nextProfile(game, profile));
+				out.addProfiles("P_" + to_string(x + 1), responses);
+			}
+		}
+		else if (analysis == "pure")
+		{
+			game.computePureEquilibria();
+			out.beginRecord(file, "pure_equilibria");
+			out.addProfiles("all", game.getPureEquilibria());
+			out.addProfiles("pareto", game.getParetoPureEquilibria());
+		}
+		else if (analysis == "mixed")
+		{
+			out.beginRecord(file, "mixed_equilibria");
+			SupportEnumerationResult<double> result = game.findMixedEquilibria();
+			if (!result.status.ok)
+				out.addText("error", result.status.error);
+			else
+			{
+				out.addMixedProfiles("equilibria", result.equilibria);
+				out.addInteger("degenerate", result.degenerate);
+			}
+		}
+		else if (analysis == "type")
+		{
+			out.beginRecord(file, "type");
+			out.addText("-", game.computeType());
+		}
+		else if (analysis == "reduce")
+		{
+			out.beginRecord(file, "reduce");
+			out.addInteger("removed", game.removeDominatedStrategies());
+			string dimensions;
+			for (int x = 0; x < game.getNumPlayers(); x++)
+				dimensions += (x > 0 ? "x" : "") + to_string(game.getPlayer(x)->getNumStrats());
+			out.addText("strategies", dimensions);
+		}
+		else if (analysis == "kmatrix")
+		{
+			KMatrixResult<int> result = game.computeKMatrix(options.levelProbabilities);
+			out.beginRecord(file, "kmatrix");
+			if (!result.status.ok)
+			{
+				out.addText("error", result.status.error);
+				continue;
+			}
+			if (result.undecided.empty())
+				out.addProfile("outcome", result.outcome.profile);
+			else
+				out.addText("outcome", "undecided for " + result.undecided);
+			for (int o = 0; (unsigned)o < result.outcomes.size(); o++)
+			{
+				string profile = "(";
+				for (int x = 0; (unsigned)x < result.outcomes.at(o).size(); x++)
+					profile += (x > 0 ? "," : "") + to_string(result.outcomes.at(o).at(x) + 1);
+				out.addNumber("P" + profile + ")", result.outcomeProbabilities.at(o));
+			}
+			for (int x = 0; x < game.getNumPlayers(); x++)
+				out.addNumber("EU_" + to_string(x + 1), result.expectedUtilities.at(x));
+		}
+		else if (analysis == "ch")
+		{
+			CognitiveHierarchyResult result = game.computeCognitiveHierarchy(options.chProbabilities);
+			out.beginRecord(file, "cognitive_hierarchy");
+			if (!result.status.ok)
+			{
+				out.addText("error", result.status.error);
+				continue;
+			}
+			for (int k = 0; (unsigned)k < result.levelStrategies.size(); k++)
+				out.addMixedProfile("L_" + to_string(k), result.levelStrategies.at(k));
+			out.addMixedProfile("prediction", result.prediction);
+			for (int x = 0; x < game.getNumPlayers(); x++)
+				out.addNumber("EU_" + to_string(x + 1), result.expectedUtilities.at(x));
+		}
+		else if (analysis == "qre")
+		{
+			QREPathResult result = game.computeLogitEquilibrium(1e6);
+			out.beginRecord(file, "logit_equilibrium");
+			if (!result.status.ok)
+			{
+				out.addText("error", result.status.error);
+				continue;
+			}
+			out.addMixedProfile("equilibrium", result.equilibrium);
+			out.addNumber("regret", result.regret);
+			out.addNumber("lambda", result.lambdas.back());
+			out.addInteger("steps", result.lambdas.size() - 1);
+			out.addInteger("turning_points", result.numTurningPoints);
+		}
+		else if (analysis == "reveal")
+		{
+			RevelationResult<int> result = game.computeRevelations();
+			out.beginRecord(file, "revelations");
+			if (!result.status.ok)
+			{
+				out.addText("error", result.status.error);
+				continue;
+			}
+			out.addProfile("original", result.original.profile);
+			out.addInteger("original_pareto", result.original.paretoOptimal);
+			for (int n = 1; (unsigned)n < result.revealing.size(); n++)
+			{
+				string set;
+				for (int y = 0; (unsigned)y < result.revealing.at(n).size(); y++)
+					set += (y > 0 ? "+P_" : "P_") + to_string(result.revealing.at(n).at(y) + 1);
+				out.addProfile(set, result.responses.at(n).profile);
+				out.addInteger(set + "_pareto", result.responses.at(n).paretoOptimal);
+				out.addProfile(set + "_anticipated", result.anticipated.at(n).profile);
+				out.addInteger(set + "_anticipated_pareto", result.anticipated.at(n).paretoOptimal);
+			}
+		}
+		else if (analysis == "simulate")
+		{
+			SimulationOptions simulation = options.simulation;
+			simulation.levelProbabilities = options.levelProbabilities;
+			simulation.seed = options.randomOptions.seed;
+			SimulationResult result = game.computeSimulation(simulation);
+			out.beginRecord(file, "simulation");
+			if (!result.status.ok)
+			{
+				out.addText("error", result.status.error);
+				continue;
+			}
+			out.addInteger("seed", result.seed);
+			for (int o = 0; (unsigned)o < result.outcomes.size(); o++)
+			{
+				string profile = "(";
+				for (int x = 0; (unsigned)x < result.outcomes.at(o).size(); x++)
+					profile += (x > 0 ? "," : "") + to_string(result.outcomes.at(o).at(x) + 1);
+				out.addNumber("P" + profile + ")", result.outcomeFrequencies.at(o));
+			}
+			for (int x = 0; x < game.getNumPlayers(); x++)
+			{
+				string player = to_string(x + 1);
+				out.addNumber("mean_" + player, result.meanPayoffs.at(x));
+				out.addNumber("variance_" + player, result.payoffVariances.at(x));
+				out.addNumber("min_" + player, result.minPayoffs.at(x));
+				for (int q = 0; q < NUM_SIMULATION_QUANTILES; q++)
+				{
+					char name[16];
+					snprintf(name, sizeof(name), "q%02d_", (int)(SIMULATION_QUANTILES[q] * 100 + 0.5));
+					out.addNumber(name + player, result.payoffQuantiles.at(x).at(q));
+				}
+				out.addNumber("max_" + player, result.maxPayoffs.at(x));
+			}
+		}
+	}
+	out.endRecord();
+}
+
+// true if file is a binary game with more payoffs than simGame can hold
+bool isTooLargeToLoad(const string &file)
+{
+	BinaryGame binary;
+	return isBinaryGame(file) && binary.open(file).ok && binary.getNumPayoffs() > INT_MAX;
+}
+
+// runs every analysis that can be streamed on a binary game that's too large to load
+void analyseStreaming(ResultWriter &out, const string &file, const BatchOptions &options)
+{
+	MappedPayoffSource<int> source;
+	GameStatus status = source.open(file);
+	if (!status.ok)
+	{
+		out.beginRecord(file, "load");
+		out.addText("error", status.error);
+		out.endRecord();
+		return;
+	}
+
+	StreamingAnalysis<int> game(source);
+	for (int n = 0; (unsigned)n < options.analyses.size(); n++)
+	{
+		const string &analysis = options.analyses.at(n);
+		if (analysis == "br")
+		{
+			vector<uint64_t> counts;
+			status = game.countBestResponses(counts);
+			out.beginRecord(file, "best_responses");
+			for (int x = 0; status.ok && x < source.getNumPlayers(); x++)
+				out.addInteger("P_" + to_string(x + 1), counts.at(x));
+		}
+		else if (analysis == "pure")
+		{
+			vector<uint64_t> equilibria;
+			status = game.pureEquilibria(equilibria);
+			out.beginRecord(file, "pure_equilibria");
+			vector<vector<int> > profiles;
+			for (int e = 0; status.ok && (unsigned)e < equilibria.size(); e++)
+				profiles.push_back(game.profile(equilibria.at(e)));
+			if (status.ok)
+				out.addProfiles("all", profiles);
+		}
+		else if (analysis == "reduce")
+		{
+			int numRemoved = 0;
+			status = game.removeDominatedStrategies(numRemoved);
+			out.beginRecord(file, "reduce");
+			string dimensions;
+			for (int x = 0; x < source.getNumPlayers(); x++)
+				dimensions += (x > 0 ? "x" : "") + to_string(game.getNumAlive(x));
+			if (status.ok)
+			{
+				out.addInteger("removed", numRemoved);
+				out.addText("strategies", dimensions);
+			}
+		}
+		else
+		{
+			out.beginRecord(file, analysis);
+			out.addText("error", "not available for games too large to load");
+		}
+
+		if (!status.ok)
+			out.addText("error", status.error);
+	}
+	out.endRecord();
+}
+
+// a record with only an error
+void addError(ResultWriter &out, const string &file, const string &analysis, const string &error)
+{
+	out.beginRecord(file, analysis);
+	out.addText("error", error);
+	out.endRecord();
+}
+
+// loads and analyses the task's games
+string analyseTask(const BatchTask &task, const BatchOptions &options)
+{
+	ostringstream results;
+	ResultWriter out(results, options.format);
+	simGame<int> game(2);
+	game.setVerbose(false);
+	if (!task.error.empty())
+		addError(out, task.file, "load", task.error);
+	else if (!task.corpus && isTooLargeToLoad(task.file))
+		analyseStreaming(out, task.file, options);
+	else if (!task.corpus)
+	{
+		GameStatus status = game.loadFromFile(task.file);
+		if (status.ok)
+			analyseGame(out, task.file, game, options);
+		else
+			addError(out, task.file, "load", status.error);
+	}
+	else
+	{
+		for (size_t k = task.first; k < task.last; k++)
+		{
+			string name = task.file + "#" + to_string(k);
+			GameStatus status = game.loadFromCorpus(*task.corpus, k);
+			if (status.ok)
+				analyseGame(out, name, game, options);
+			else
+				addError(out, name, "load", status.error);
+		}
+	}
+	out.flush();
+	return results.str();
+}
+
+// packs every game into options.corpusOutput
+int writeCorpus(const BatchOptions &options)
+{
+	CorpusWriter writer;
+	GameStatus status = writer.open(options.corpusOutput);
+	for (int n = 0; status.ok && (unsigned)n < options.files.size(); n++)
+		status = writer.addFile(options.files.at(n));
+	if (status.ok)
+		status = writer.close();
+	if (!status.ok)
+	{
+		cerr << "ERROR: " << status.error << endl;
+		return 1;
+	}
+	cerr << "wrote " << writer.getNumGames() << " games to " << options.corpusOutput << endl;
+	return 0;
+}
+
+// draws options.numGenerated games of type options.generate into options.corpusOutput
+int generateCorpus(const BatchOptions &options)
+{
+	GameClass c;
+	parseGameClass(options.generate, c);
+	RandGameOptions randomOptions = options.randomOptions;
+	randomOptions.numThreads = options.numThreads;
+	GameStatus status = writeClassCorpus<int>(options.corpusOutput, c, options.numGenerated, randomOptions);
+	if (!status.ok)
+	{
+		cerr << "ERROR: " << status.error << endl;
+		return 1;
+	}
+	cerr << "wrote " << options.numGenerated << " " << options.generate << " games to " << options.corpusOutput << endl;
+	return 0;
+}
+
+// reads options.observations, loading each game once per line
+bool loadObservations(const BatchOptions &options, vector<Observation<int> > &observations)
+{
+	ifstream file(options.observations.c_str());
+	if (!file)
+	{
+		cerr << "ERROR: could not open " << options.observations << endl;
+		return false;
+	}
+
+	map<string, GameCorpus*> corpora;
+	simGame<int> game(2);
+	game.setVerbose(false);
+	string line;
+	bool ok = true;
+	for (int lineNum = 1; getline(file, line); lineNum++)
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.erase(line.size() - 1);
+		istringstream fields(line);
+		string name, counts;
+		if (!(fields >> name) || name[0] == '#')
+			continue;
+
+		Observation<int> observation;
+		observation.name = name;
+		if (!(fields >> counts) || !parseChoiceCounts(counts, observation.counts))
+		{
+			cerr << "ERROR: line " << lineNum << " of " << options.observations << " needs a game and its counts" << endl;
+			ok = false;
+			break;
+		}
+
+		GameStatus status;
+		size_t hash = name.rfind('#');
+		if (hash != string::npos && isGameCorpus(name.substr(0, hash)))
+		{
+			string corpusFile = name.substr(0, hash);
+			if (!corpora.count(corpusFile))
+			{
+				corpora[corpusFile] = new GameCorpus;
+				status = corpora[corpusFile]->open(corpusFile);
+			}
+			if (status.ok)
+				status = game.loadFromCorpus(*corpora[corpusFile], strtoull(name.substr(hash + 1).c_str(), NULL, 10));
+		}
+		else
+			status = game.loadFromFile(name);
+		if (!status.ok)
+		{
+			cerr << "ERROR: " << name << ": " << status.error << endl;
+			ok = false;
+			break;
+		}
+		observation.payoffs = game.toPayoffTensor();
+		observations.push_back(observation);
+	}
+
+	for (map<string, GameCorpus*>::iterator it = corpora.begin(); it != corpora.end(); it++)
+		delete it->second;
+	return ok;
+}
+
+// fits options.estimate to options.observations and writes the result
+int estimate(const BatchOptions &options, ostream &out)
+{
+	vector<Observation<int> > observations;
+	if (!loadObservations(options, observations))
+		return 1;
+
+	ResultWriter writer(out, options.format, 64);
+	writer.writeHeader();
+	GameStatus status;
+	if (options.estimate == "levels")
+	{
+		LevelFitResult result = fitLevels(observations, options.maxLevel, options.numThreads);
+		status = result.status;
+		writer.beginRecord(options.observations, "level_fit");
+		for (int k = 0; status.ok && (unsigned)k < result.levelProbabilities.size(); k++)
+			writer.addNumber("P(L_" + to_string(k) + ")", result.levelProbabilities.at(k));
+		if (status.ok)
+		{
+			writer.addNumber("error_rate", result.errorRate);
+			writer.addNumber("log_likelihood", result.logLikelihood);
+			writer.addInteger("iterations", result.iterations);
+		}
+	}
+	else
+	{
+		QREFitResult result = fitQRE(observations, options.numThreads);
+		status = result.status;
+		writer.beginRecord(options.observations, "qre_fit");
+		if (status.ok)
+		{
+			writer.addNumber("precision", result.precision);
+			writer.addNumber("log_likelihood", result.logLikelihood);
+			writer.addInteger("iterations", result.iterations);
+		}
+	}
+	if (!status.ok)
+		writer.addText("error", status.error);
+	writer.endRecord();
+	return status.ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	BatchOptions options;
+	if (!parseArguments(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	if (!options.generate.empty())
+		return generateCorpus(options);
+	if (!options.corpusOutput.empty())
+		return writeCorpus(options);
+
+	ofstream outfile;
+	ostream* out = &cout;
+	if (!options.output.empty())
+	{
+		outfile.open(options.output.c_str());
+		if (!outfile)
+		{
+			cerr << "ERROR: could not open " << options.output << endl;
+			return 1;
+		}
+		out = &outfile;
+	}
+	if (!options.estimate.empty())
+		return estimate(options, *out);
+
+	// corpora are opened once and shared by their tasks
+	vector<BatchTask> tasks;
+	vector<GameCorpus*> corpora;
+	for (int n = 0; (unsigned)n < options.files.size(); n++)
+	{
+		const string &file = options.files.at(n);
+		if (!isGameCorpus(file))
+		{
+			tasks.push_back(BatchTask(file));
+			continue;
+		}
+
+		GameCorpus* corpus = new GameCorpus;
+		corpora.push_back(corpus);
+		GameStatus status = corpus->open(file);
+		if (!status.ok)
+		{
+			tasks.push_back(BatchTask(file));
+			tasks.back().error = status.error;
+			continue;
+		}
+
+		size_t first, last;
+		corpus->getShard(options.shard, options.numShards, first, last);
+		for (size_t k = first; k < last; k += GAMES_PER_TASK)
+		{
+			tasks.push_back(BatchTask(file));
+			tasks.back().corpus = corpus;
+			tasks.back().first = k;
+			tasks.back().last = min(last, k + GAMES_PER_TASK);
+		}
+	}
+
+	{
+		ResultWriter header(*out, options.format, 64);
+		header.writeHeader();
+	}
+	OrderedOutput ordered(out, tasks.size());
+	{
+		ThreadPool pool(options.numThreads);
+		for (int n = 0; (unsigned)n < tasks.size(); n++)
+			pool.push([n, &tasks, &options, &ordered]() { ordered.finish(n, analyseTask(tasks.at(n), options)); });
+		pool.wait();
+	}
+
+	for (int c = 0; (unsigned)c < corpora.size(); c++)
+		delete corpora.at(c);
+	return 0;
+}
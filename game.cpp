@@ -4,8 +4,8 @@ Author: Andrew Lounsbury
 Date: 5/9/2020
 Purpose: Game theory program
 ********************************/
-#include "simGame.h"
-#include "seqGame.h"
+#include "SimGame.h"
+#include "SeqGame.h"
 
 int main()
 {
@@ -160,22 +160,20 @@ int main()
 			0	1
 		*/
 		
-		vector<int> rootPath{-1};
-		vector<int> path1{-1, 0};
-		vector<int> path2{-1, 1};
-		vector<int> path3{-1, 0, 0};
-		vector<int> path4{-1, 0, 1};
+		vector<int> rootPath;
+		vector<int> path1{0};
+		vector<int> path2{1};
+		vector<int> path3{0, 0};
+		vector<int> path4{0, 1};
 		
-		game->insert(game->getRoot(), rootPath);
-		game->insert(game->getRoot(), path1);
-		game->insert(game->getRoot(), path2);
-		// game->insert(game->getRoot(), path3);
-		// game->insert(game->getRoot(), path4);
-		
-		game->display(game->getRoot(), 0);
-		
-		// game->displayPreOrder(game->getRoot());
+		game->insert(rootPath, 0, 2);
+		game->insert(path1, 1, 2);
+		game->getTree().setPayoffs(game->search(path2), vector<int>{1, 1});
+		game->getTree().setPayoffs(game->search(path3), vector<int>{2, 0});
+		game->getTree().setPayoffs(game->search(path4), vector<int>{0, 2});
 		
+		game->display();
+		delete game;
 	}
 	return 0;
 }
\ No newline at end of file